@@ -0,0 +1,95 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <chrono>
+
+/**
+ * @brief A price feed with a slow consumer, about 2 us per call.
+ * Called on every emit, against coalesced connections whose emit only stores the latest price.
+ */
+struct Slow
+{
+    double last = 0;
+    long calls = 0;
+
+    void onPrice(double price)
+    {
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::microseconds(2);
+        while(std::chrono::steady_clock::now() < end)
+        {
+        }
+        this->last = price;
+        ++this->calls;
+    }
+};
+
+static void BM_DirectSlowConsumer(benchmark::State & state)
+{
+    Signal<double> price;
+    Slow slow;
+    Connection c = price.connect(&slow, &Slow::onPrice);
+    double p = 0;
+    for(auto _ : state)
+    {
+        price.emit(p += 0.01);
+    }
+}
+
+template<typename Mode>
+static void BM_Coalesced(benchmark::State & state)
+{
+    Signal<double> price;
+    Coalescer coalescer;
+    Slow slow;
+    Connection c = price.connect(coalescer, Mode{std::chrono::milliseconds(16)}, &slow, &Slow::onPrice);
+    double p = 0;
+    for(auto _ : state)
+    {
+        price.emit(p += 0.01);
+    }
+    coalescer.drain();
+}
+
+static void BM_CoalescedLatest(benchmark::State & state)
+{
+    Signal<double> price;
+    Coalescer coalescer;
+    Slow slow;
+    Connection c = price.connect(coalescer, SignalThrottle::Latest{}, &slow, &Slow::onPrice);
+    double p = 0;
+    long emits = 0;
+    for(auto _ : state)
+    {
+        price.emit(p += 0.01);
+        //A 60 Hz drain of a 1 MHz feed.
+        if(++emits % 16000 == 0)
+        {
+            coalescer.drain();
+        }
+    }
+}
+
+static void BM_ExecutorLatest(benchmark::State & state)
+{
+    Signal<double> price;
+    Executor executor;
+    Slow slow;
+    Connection c = price.connect(executor, SignalThrottle::Latest{}, &slow, &Slow::onPrice);
+    double p = 0;
+    long emits = 0;
+    for(auto _ : state)
+    {
+        price.emit(p += 0.01);
+        if(++emits % 16000 == 0)
+        {
+            executor.poll();
+        }
+    }
+}
+
+BENCHMARK(BM_DirectSlowConsumer);
+BENCHMARK(BM_CoalescedLatest);
+BENCHMARK(BM_Coalesced<SignalThrottle::Every>);
+BENCHMARK(BM_Coalesced<SignalThrottle::Debounce>);
+BENCHMARK(BM_ExecutorLatest);
+
+BENCHMARK_MAIN();
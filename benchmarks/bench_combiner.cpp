@@ -0,0 +1,60 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+/**
+ * @brief A chain of 25 validators rejecting at the third one.
+ * Calling all of them and checking after, against AllTrue stopping at the rejection.
+ */
+struct Chain
+{
+    Signal<bool(int)> validators;
+    std::vector<Connection<int>> connections;
+    long checks = 0;
+
+    Chain()
+    {
+        for(int i = 0; i < 25; ++i)
+        {
+            connections.push_back(validators.connect([this, i](int v){
+                benchmark::DoNotOptimize(++this->checks);
+                return i != 2 && v >= 0;
+            }));
+        }
+    }
+};
+
+static void BM_AllValidators(benchmark::State & state)
+{
+    Chain chain;
+    Signal<int> plain;
+    bool valid = true;
+    std::vector<Connection<int>> connections;
+    for(int i = 0; i < 25; ++i)
+    {
+        connections.push_back(plain.connect([&chain, &valid, i](int v){
+            benchmark::DoNotOptimize(++chain.checks);
+            valid &= i != 2 && v >= 0;
+        }));
+    }
+    for(auto _ : state)
+    {
+        valid = true;
+        plain.emit(1);
+        benchmark::DoNotOptimize(valid);
+    }
+}
+
+static void BM_AllTrue(benchmark::State & state)
+{
+    Chain chain;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(chain.validators.emit(SignalCombiner::AllTrue{}, 1));
+    }
+}
+
+BENCHMARK(BM_AllValidators);
+BENCHMARK(BM_AllTrue);
+
+BENCHMARK_MAIN();
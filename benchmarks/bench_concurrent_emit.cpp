@@ -0,0 +1,86 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#ifdef SIGNALS_BENCH_BOOST
+#include <boost/signals2.hpp>
+#endif
+
+/**
+ * @brief Per thread sink of the methods: a shared counter would measure its cache line, not the signal.
+ */
+static thread_local long calls = 0;
+
+/**
+ * @brief Several threads emitting the same signal, 8 connected methods.
+ * Compare the default policy to SignalPolicy::LockFree, to ShardedSignal per NUMA node and per core,
+ * and to Boost.Signals2 when found, from 1 to 64 threads.
+ */
+template<typename S>
+struct Shared
+{
+    S signal;
+    std::vector<Connection<int>> connections;
+
+    Shared()
+    {
+        for(int i = 0; i < 8; ++i)
+        {
+            connections.push_back(signal.connect([](int v){ calls += v; }));
+        }
+    }
+
+    static Shared & instance()
+    {
+        static Shared shared;
+        return shared;
+    }
+};
+
+template<typename S>
+static void BM_ConcurrentEmit(benchmark::State & state)
+{
+    auto & shared = Shared<S>::instance();
+    for(auto _ : state)
+    {
+        shared.signal.emit(1);
+        benchmark::DoNotOptimize(calls);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ConcurrentEmit<Signal<int>>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ConcurrentEmit<ConcurrentSignal<int>>)->ThreadRange(1, 64)->UseRealTime();
+
+struct PerCoreSignal : ShardedSignal<int>
+{
+    PerCoreSignal() : ShardedSignal<int>(ShardBy::Core) {}
+};
+
+BENCHMARK(BM_ConcurrentEmit<ShardedSignal<int>>)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_ConcurrentEmit<PerCoreSignal>)->ThreadRange(1, 64)->UseRealTime();
+
+#ifdef SIGNALS_BENCH_BOOST
+static void BM_BoostConcurrentEmit(benchmark::State & state)
+{
+    static boost::signals2::signal<void(int)> signal;
+    static const std::vector<boost::signals2::scoped_connection> connections = [](){
+        std::vector<boost::signals2::scoped_connection> c;
+        for(int i = 0; i < 8; ++i)
+        {
+            c.emplace_back(signal.connect([](int v){ calls += v; }));
+        }
+        return c;
+    }();
+    for(auto _ : state)
+    {
+        signal(1);
+        benchmark::DoNotOptimize(calls);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_BoostConcurrentEmit)->ThreadRange(1, 64)->UseRealTime();
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <array>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#ifdef SIGNALS_BENCH_BOOST
+#include <boost/signals2.hpp>
+#endif
+
+/**
+ * @brief Short lived subscriptions on a signal with 32 permanent methods, global allocator against SlotPool.
+ */
+static void BM_Churn(benchmark::State & state)
+{
+    SlotPool pool;
+    Signal<int> s(state.range(0) ? static_cast<std::pmr::memory_resource *>(&pool) : std::pmr::get_default_resource());
+    long sum = 0;
+    std::vector<Connection<int>> permanent;
+    for(int i = 0; i < 32; ++i)
+    {
+        permanent.push_back(s.connect([&sum](int v){ sum += v; }));
+    }
+    std::array<long, 8> captured{};
+    for(auto _ : state)
+    {
+        Connection c = s.connect([&sum, captured](int v){ sum += v + captured[0]; });
+        c.disconnect();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Churn)->Arg(0)->Arg(1);
+
+/**
+ * @brief Connect then disconnect 1000 methods, one at a time against one batch each way.
+ */
+static void BM_ChurnMany(benchmark::State & state)
+{
+    Signal<int> s;
+    long sum = 0;
+    std::vector<std::function<void(int)>> methods(1000, [&sum](int v){ sum += v; });
+    for(auto _ : state)
+    {
+        std::vector<Connection<int>> connections;
+        if(state.range(0))
+        {
+            connections = s.connectMany(methods);
+            s.disconnectMany(connections);
+        }
+        else
+        {
+            for(const std::function<void(int)> & m: methods)
+            {
+                connections.push_back(s.connect(m));
+            }
+            for(Connection<int> & c: connections)
+            {
+                c.disconnect();
+            }
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+BENCHMARK(BM_ChurnMany)->Arg(0)->Arg(1);
+
+/**
+ * @brief Same as BM_ChurnMany through a transaction.
+ */
+static void BM_ChurnTransaction(benchmark::State & state)
+{
+    Signal<int> s;
+    long sum = 0;
+    for(auto _ : state)
+    {
+        std::vector<Connection<int>> connections;
+        connections.reserve(1000);
+        {
+            auto batch = s.transaction(1000);
+            for(int i = 0; i < 1000; ++i)
+            {
+                connections.push_back(batch.connect([&sum](int v){ sum += v; }));
+            }
+        }
+        s.disconnectMany(connections);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+BENCHMARK(BM_ChurnTransaction);
+
+/**
+ * @brief Methods disconnecting themselves when called, all at once by the same emit.
+ * Connected through a transaction so that the disconnects dominate.
+ */
+template<typename Policy>
+static void BM_OneShots(benchmark::State & state)
+{
+    Signal<Policy, int> s;
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::vector<std::optional<Connection<int>>> shots(count);
+    long sum = 0;
+    for(auto _ : state)
+    {
+        {
+            auto batch = s.transaction(count);
+            for(std::optional<Connection<int>> & shot: shots)
+            {
+                shot.emplace(batch.connect([&sum, &shot](int v){
+                    sum += v;
+                    shot->disconnect();
+                }));
+            }
+        }
+        s.emit(1);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_OneShots<SignalPolicy::Mutex>)->Arg(16)->Arg(256);
+BENCHMARK(BM_OneShots<SignalPolicy::LockFree>)->Arg(16)->Arg(256);
+
+#ifdef SIGNALS_BENCH_BOOST
+static void BM_BoostChurn(benchmark::State & state)
+{
+    boost::signals2::signal<void(int)> s;
+    long sum = 0;
+    std::vector<boost::signals2::scoped_connection> permanent;
+    for(int i = 0; i < 32; ++i)
+    {
+        permanent.emplace_back(s.connect([&sum](int v){ sum += v; }));
+    }
+    std::array<long, 8> captured{};
+    for(auto _ : state)
+    {
+        boost::signals2::connection c = s.connect([&sum, captured](int v){ sum += v + captured[0]; });
+        c.disconnect();
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_BoostChurn);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,146 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifdef SIGNALS_BENCH_BOOST
+#include <boost/signals2.hpp>
+#endif
+
+/**
+ * @brief Emit latency by number of connected methods and by kind of callable,
+ * against a std::vector<std::function> loop and Boost.Signals2.
+ */
+static long total = 0;
+
+static void add(int v) { total += v; }
+
+struct Listener
+{
+    long sum = 0;
+    void on(int v) { this->sum += v; }
+    void onScaled(int k, int v) { this->sum += k * v; }
+};
+
+enum class Kind
+{
+    Free,
+    Lambda,
+    Member,
+    Delegate,
+    Tracked,
+    Bound
+};
+
+template<Kind K>
+static Connection<int> connectKind(Signal<int> & s, Listener * listener, std::shared_ptr<Listener> & shared)
+{
+    if constexpr (K == Kind::Free)
+    {
+        return s.connect(&add);
+    }
+    else if constexpr (K == Kind::Lambda)
+    {
+        return s.connect([listener](int v){ listener->sum += v; });
+    }
+    else if constexpr (K == Kind::Member)
+    {
+        return s.connect(listener, &Listener::on);
+    }
+    else if constexpr (K == Kind::Delegate)
+    {
+        return s.connect<&Listener::on>(listener);
+    }
+    else if constexpr (K == Kind::Tracked)
+    {
+        return s.connect(shared, &Listener::on);
+    }
+    else
+    {
+        return s.connect(listener, &Listener::onScaled, 2);
+    }
+}
+
+static void SlotCounts(benchmark::internal::Benchmark * b)
+{
+    for(const int count: {0, 1, 8, 64, 1024})
+    {
+        b->Arg(count);
+    }
+}
+
+template<Kind K>
+static void BM_Emit(benchmark::State & state)
+{
+    Signal<int> s;
+    Listener listener;
+    std::shared_ptr<Listener> shared = std::make_shared<Listener>();
+    std::vector<Connection<int>> connections;
+    for(int i = 0; i < state.range(0); ++i)
+    {
+        connections.push_back(connectKind<K>(s, &listener, shared));
+    }
+    int v = 0;
+    for(auto _ : state)
+    {
+        s.emit(++v);
+    }
+    benchmark::DoNotOptimize(total);
+    benchmark::DoNotOptimize(listener.sum);
+    benchmark::DoNotOptimize(shared->sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_VectorFunction(benchmark::State & state)
+{
+    Listener listener;
+    std::vector<std::function<void(int)>> methods;
+    for(int i = 0; i < state.range(0); ++i)
+    {
+        methods.emplace_back([&listener](int v){ listener.sum += v; });
+    }
+    int v = 0;
+    for(auto _ : state)
+    {
+        ++v;
+        for(const std::function<void(int)> & method: methods)
+        {
+            method(v);
+        }
+    }
+    benchmark::DoNotOptimize(listener.sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Emit, Kind::Free)->Apply(SlotCounts);
+BENCHMARK_TEMPLATE(BM_Emit, Kind::Lambda)->Apply(SlotCounts);
+BENCHMARK_TEMPLATE(BM_Emit, Kind::Member)->Apply(SlotCounts);
+BENCHMARK_TEMPLATE(BM_Emit, Kind::Delegate)->Apply(SlotCounts);
+BENCHMARK_TEMPLATE(BM_Emit, Kind::Tracked)->Apply(SlotCounts);
+BENCHMARK_TEMPLATE(BM_Emit, Kind::Bound)->Apply(SlotCounts);
+BENCHMARK(BM_VectorFunction)->Apply(SlotCounts);
+
+#ifdef SIGNALS_BENCH_BOOST
+static void BM_BoostSignals2(benchmark::State & state)
+{
+    Listener listener;
+    boost::signals2::signal<void(int)> s;
+    std::vector<boost::signals2::scoped_connection> connections;
+    for(int i = 0; i < state.range(0); ++i)
+    {
+        connections.emplace_back(s.connect([&listener](int v){ listener.sum += v; }));
+    }
+    int v = 0;
+    for(auto _ : state)
+    {
+        s(++v);
+    }
+    benchmark::DoNotOptimize(listener.sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_BoostSignals2)->Apply(SlotCounts);
+#endif
+
+BENCHMARK_MAIN();
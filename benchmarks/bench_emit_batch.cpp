@@ -0,0 +1,67 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief Replaying a buffer of events: a loop of emit() against one emitBatch(), 8 connected methods.
+ */
+struct Trade
+{
+    double price;
+    int quantity;
+};
+
+static std::vector<std::tuple<Trade>> makeTrades(const std::size_t count)
+{
+    std::vector<std::tuple<Trade>> trades;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        trades.emplace_back(Trade{100.0 + i, static_cast<int>(i % 7)});
+    }
+    return trades;
+}
+
+static void BM_EmitLoop(benchmark::State & state)
+{
+    Signal<Trade> s;
+    double volume = 0;
+    std::vector<Connection<Trade>> connections;
+    for(int i = 0; i < 8; ++i)
+    {
+        connections.push_back(s.connect([&volume](const Trade & t){ volume += t.price * t.quantity; }));
+    }
+    const auto trades = makeTrades(state.range(0));
+    for(auto _ : state)
+    {
+        for(const auto & [trade]: trades)
+        {
+            s.emit(trade);
+        }
+        benchmark::DoNotOptimize(volume);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_EmitBatch(benchmark::State & state)
+{
+    Signal<Trade> s;
+    double volume = 0;
+    std::vector<Connection<Trade>> connections;
+    for(int i = 0; i < 8; ++i)
+    {
+        connections.push_back(s.connect([&volume](const Trade & t){ volume += t.price * t.quantity; }));
+    }
+    const auto trades = makeTrades(state.range(0));
+    for(auto _ : state)
+    {
+        s.emitBatch(trades);
+        benchmark::DoNotOptimize(volume);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_EmitLoop)->Range(16, 4096);
+BENCHMARK(BM_EmitBatch)->Range(16, 4096);
+
+BENCHMARK_MAIN();
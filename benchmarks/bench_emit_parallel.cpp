@@ -0,0 +1,56 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief 32 CPU heavy methods: emit() against emitParallel() on a pool, chunk size as argument.
+ */
+static void connectHeavy(Signal<double> & s, std::vector<Connection<double>> & connections, std::vector<double> & results)
+{
+    results.assign(32 * 8, 0.0);
+    for(std::size_t i = 0; i < 32; ++i)
+    {
+        //Results are 64 bytes apart so methods running at once don't share a cache line.
+        connections.push_back(s.connect([&results, i](double x){
+            double acc = 0;
+            for(int k = 1; k < 20000; ++k)
+            {
+                acc += std::sqrt(x * k);
+            }
+            results[i * 8] = acc;
+        }));
+    }
+}
+
+static void BM_Emit(benchmark::State & state)
+{
+    Signal<double> s;
+    std::vector<Connection<double>> connections;
+    std::vector<double> results;
+    connectHeavy(s, connections, results);
+    for(auto _ : state)
+    {
+        s.emit(1.5);
+        benchmark::DoNotOptimize(results.data());
+    }
+}
+
+static void BM_EmitParallel(benchmark::State & state)
+{
+    static ThreadPool pool;
+    Signal<double> s;
+    std::vector<Connection<double>> connections;
+    std::vector<double> results;
+    connectHeavy(s, connections, results);
+    for(auto _ : state)
+    {
+        s.emitParallel(pool, state.range(0), 1.5);
+        benchmark::DoNotOptimize(results.data());
+    }
+}
+
+BENCHMARK(BM_Emit)->UseRealTime();
+BENCHMARK(BM_EmitParallel)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,114 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+struct OrderFilled
+{
+    long id;
+    double price;
+};
+
+struct OrderCancelled
+{
+    long id;
+};
+
+struct Heartbeat
+{
+    long sequence;
+};
+
+/**
+ * @brief A registry finding the signal of an event in a hash map on every publish.
+ */
+class HashRegistry
+{
+public:
+    template<typename Event>
+    Signal<const Event &> & signal()
+    {
+        std::unique_ptr<SignalBase> & s = this->signals[std::type_index(typeid(Event))];
+        if(!s)
+        {
+            s = std::make_unique<Typed<Event>>();
+        }
+        return static_cast<Typed<Event> &>(*s).signal;
+    }
+
+    template<typename Event>
+    void publish(const Event & event)
+    {
+        std::unordered_map<std::type_index, std::unique_ptr<SignalBase>>::iterator found = this->signals.find(std::type_index(typeid(Event)));
+        if(found != this->signals.end())
+        {
+            static_cast<Typed<Event> &>(*found->second).signal.emit(event);
+        }
+    }
+
+private:
+    struct SignalBase
+    {
+        virtual ~SignalBase() = default;
+    };
+
+    template<typename Event>
+    struct Typed : SignalBase
+    {
+        Signal<const Event &> signal;
+    };
+
+    std::unordered_map<std::type_index, std::unique_ptr<SignalBase>> signals;
+};
+
+static void BM_BusEmit(benchmark::State & state)
+{
+    EventBus<OrderFilled, OrderCancelled, Heartbeat> bus;
+    double sum = 0;
+    Connection c = bus.connect<OrderFilled>([&sum](const OrderFilled & f){ sum += f.price; });
+    Connection other = bus.connect<Heartbeat>([&sum](const Heartbeat & h){ sum += h.sequence; });
+    long i = 0;
+    for(auto _ : state)
+    {
+        bus.emit(OrderFilled{++i, 1.0});
+    }
+    benchmark::DoNotOptimize(sum);
+}
+
+static void BM_BusEmitWithWildcard(benchmark::State & state)
+{
+    EventBus<OrderFilled, OrderCancelled, Heartbeat> bus;
+    double sum = 0;
+    long all = 0;
+    Connection c = bus.connect<OrderFilled>([&sum](const OrderFilled & f){ sum += f.price; });
+    Connection wildcard = bus.connectAll([&all](const EventRef<OrderFilled, OrderCancelled, Heartbeat> & e){ all += static_cast<long>(e.index()); });
+    long i = 0;
+    for(auto _ : state)
+    {
+        bus.emit(OrderFilled{++i, 1.0});
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::DoNotOptimize(all);
+}
+
+static void BM_HashRegistryEmit(benchmark::State & state)
+{
+    HashRegistry registry;
+    double sum = 0;
+    Connection c = registry.signal<OrderFilled>().connect([&sum](const OrderFilled & f){ sum += f.price; });
+    Connection other = registry.signal<Heartbeat>().connect([&sum](const Heartbeat & h){ sum += h.sequence; });
+    long i = 0;
+    for(auto _ : state)
+    {
+        registry.publish(OrderFilled{++i, 1.0});
+    }
+    benchmark::DoNotOptimize(sum);
+}
+
+BENCHMARK(BM_BusEmit);
+BENCHMARK(BM_BusEmitWithWildcard);
+BENCHMARK(BM_HashRegistryEmit);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,48 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <string>
+
+/**
+ * @brief A log signal nobody listens to, with a formatted message.
+ * Building it for emit, against emitLazy skipping it, and the check alone.
+ */
+static std::string format(long i)
+{
+    return "order " + std::to_string(i) + " filled at " + std::to_string(i * 0.25) + " for account " + std::to_string(i % 97);
+}
+
+static void BM_EmitBuilt(benchmark::State & state)
+{
+    Signal<std::string> log;
+    long i = 0;
+    for(auto _ : state)
+    {
+        log.emit(format(++i));
+    }
+}
+
+static void BM_EmitLazy(benchmark::State & state)
+{
+    Signal<std::string> log;
+    long i = 0;
+    for(auto _ : state)
+    {
+        log.emitLazy([&i](){ return format(++i); });
+    }
+    benchmark::DoNotOptimize(i);
+}
+
+static void BM_HasActiveListeners(benchmark::State & state)
+{
+    Signal<std::string> log;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(log.hasActiveListeners());
+    }
+}
+
+BENCHMARK(BM_EmitBuilt);
+BENCHMARK(BM_EmitLazy);
+BENCHMARK(BM_HasActiveListeners);
+
+BENCHMARK_MAIN();
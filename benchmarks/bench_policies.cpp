@@ -0,0 +1,54 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+/**
+ * @brief Single thread emit and connect costs of every synchronization policy.
+ */
+static long total = 0;
+
+static void add(int v) { total += v; }
+
+template<typename Policy>
+static void BM_Emit(benchmark::State & state)
+{
+    Signal<Policy, int> s;
+    std::vector<Connection<int>> connections;
+    for(int i = 0; i < 4; ++i)
+    {
+        connections.push_back(s.connect(&add));
+    }
+    int v = 0;
+    for(auto _ : state)
+    {
+        s.emit(++v);
+    }
+    benchmark::DoNotOptimize(total);
+}
+
+template<typename Policy>
+static void BM_ConnectDisconnect(benchmark::State & state)
+{
+    Signal<Policy, int> s;
+    std::vector<Connection<int>> connections;
+    for(int i = 0; i < 16; ++i)
+    {
+        connections.push_back(s.connect(&add));
+    }
+    for(auto _ : state)
+    {
+        Connection c = s.connect(&add);
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Emit, SignalPolicy::SingleThreaded);
+BENCHMARK_TEMPLATE(BM_Emit, SignalPolicy::Mutex);
+BENCHMARK_TEMPLATE(BM_Emit, SignalPolicy::SharedMutex);
+BENCHMARK_TEMPLATE(BM_Emit, SignalPolicy::LockFree);
+BENCHMARK_TEMPLATE(BM_ConnectDisconnect, SignalPolicy::SingleThreaded);
+BENCHMARK_TEMPLATE(BM_ConnectDisconnect, SignalPolicy::Mutex);
+BENCHMARK_TEMPLATE(BM_ConnectDisconnect, SignalPolicy::SharedMutex);
+BENCHMARK_TEMPLATE(BM_ConnectDisconnect, SignalPolicy::LockFree);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+#include <signals.h>
+#include <recorder.h>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+struct Quote
+{
+    long id;
+    double bid;
+    double ask;
+};
+
+/**
+ * @brief One cheap method: the cost of the policy, off and recording, against a plain signal.
+ */
+template<typename Policy>
+static void BM_Emit(benchmark::State & state)
+{
+    Signal<Policy, Quote> quotes;
+    double sum = 0;
+    Connection c = quotes.connect([&sum](const Quote & q){ sum += q.bid; });
+    long i = 0;
+    for(auto _ : state)
+    {
+        quotes.emit(Quote{++i, 1.0, 2.0});
+    }
+    benchmark::DoNotOptimize(sum);
+}
+
+static void BM_EmitRecording(benchmark::State & state)
+{
+    const std::string path = "/tmp/signals_bench_" + std::to_string(getpid()) + ".log";
+    Signal<SignalPolicy::Recorded<SignalPolicy::Mutex>, Quote> quotes;
+    double sum = 0;
+    Connection c = quotes.connect([&sum](const Quote & q){ sum += q.bid; });
+    {
+        //Once full, whole buffers are dropped: the emit side costs the same.
+        SignalRecorder recorder(path, std::size_t(256) << 20);
+        recorder.record(quotes, "quotes");
+        long i = 0;
+        for(auto _ : state)
+        {
+            quotes.emit(Quote{++i, 1.0, 2.0});
+        }
+        state.counters["dropped"] = static_cast<double>(recorder.dropped());
+        recorder.stop(quotes);
+    }
+    std::remove(path.c_str());
+    benchmark::DoNotOptimize(sum);
+}
+
+static void BM_ReplayFullSpeed(benchmark::State & state)
+{
+    const std::string path = "/tmp/signals_bench_" + std::to_string(getpid()) + ".log";
+    {
+        Signal<SignalPolicy::Recorded<SignalPolicy::Mutex>, Quote> quotes;
+        SignalRecorder recorder(path);
+        recorder.record(quotes, "quotes");
+        for(long i = 0; i < 100000; ++i)
+        {
+            quotes.emit(Quote{i, 1.0, 2.0});
+        }
+        recorder.stop(quotes);
+    }
+    SignalReplayer replayer(path);
+    LocalSignal<Quote> replayed;
+    double sum = 0;
+    Connection c = replayed.connect([&sum](const Quote & q){ sum += q.bid; });
+    replayer.bind("quotes", replayed);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(replayer.replay());
+    }
+    state.SetItemsProcessed(state.iterations() * 100000);
+    std::remove(path.c_str());
+    benchmark::DoNotOptimize(sum);
+}
+
+BENCHMARK(BM_Emit<SignalPolicy::Mutex>);
+BENCHMARK(BM_Emit<SignalPolicy::Recorded<SignalPolicy::Mutex>>);
+BENCHMARK(BM_EmitRecording);
+BENCHMARK(BM_ReplayFullSpeed);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+#include <signals.h>
+#include <remote_signal.h>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+struct Fill
+{
+    long order;
+    int quantity;
+    double price;
+    std::string venue;
+};
+
+/**
+ * @brief 1000 events over a Unix socket, one frame per event against frames batched up to range(0) bytes.
+ */
+static void BM_RemoteFrames(benchmark::State & state)
+{
+    int fds[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    SocketTransport ta(fds[0]);
+    SocketTransport tb(fds[1]);
+    Signal<Fill> fills;
+    long received = 0;
+    {
+        RemoteLink a(ta, RemoteOptions{.maxFrame = static_cast<std::size_t>(state.range(0)), .flushWindow = std::chrono::hours(1)});
+        RemoteLink b(tb);
+        a.publish("fills", fills);
+        Connection c = b.subscribe<Fill>("fills", [&received](const Fill & f){ received += f.quantity; });
+        for(int i = 0; i < 4; ++i)
+        {
+            a.poll();
+            b.poll();
+        }
+        const Fill fill{123456, 1, 1.0825, "XPAR"};
+        for(auto _ : state)
+        {
+            for(int i = 0; i < 1000; ++i)
+            {
+                fills.emit(fill);
+                if(i % 64 == 63)
+                {
+                    b.poll();
+                }
+            }
+            a.flush();
+            while(received % 1000 != 0 || received == 0)
+            {
+                b.poll();
+            }
+        }
+        state.counters["frames"] = benchmark::Counter(static_cast<double>(a.frames()) / static_cast<double>(state.iterations()));
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+BENCHMARK(BM_RemoteFrames)->Arg(1)->Arg(16 * 1024);
+
+/**
+ * @brief Encoded size of an event against its in-memory size.
+ */
+static void BM_RemoteEncode(benchmark::State & state)
+{
+    const Fill fill{123456, 1, 1.0825, "XPAR"};
+    std::vector<std::byte> bytes;
+    for(auto _ : state)
+    {
+        bytes.clear();
+        SignalWire::Writer w(bytes);
+        SignalWire::Codec<Fill>::write(w, fill);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.counters["bytes"] = static_cast<double>(bytes.size());
+    state.counters["sizeof"] = static_cast<double>(sizeof(Fill));
+}
+
+BENCHMARK(BM_RemoteEncode);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+#include <signals.h>
+#include <shm_signal.h>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct Quote
+{
+    long id;
+    double bid;
+    double ask;
+};
+
+/**
+ * @brief Ring cost alone: emit then poll on the same thread.
+ */
+static void BM_ShmEmitPoll(benchmark::State & state)
+{
+    const std::string name = "/signals_bench_" + std::to_string(getpid());
+    ShmSignal<Quote> producer(name, 1024);
+    LocalSignal<Quote> local;
+    double sum = 0;
+    Connection c = local.connect([&sum](const Quote & q){ sum += q.bid; });
+    ShmReceiver<Quote> receiver(name, local);
+    long i = 0;
+    for(auto _ : state)
+    {
+        producer.emit(Quote{++i, 1.0, 2.0});
+        receiver.poll();
+    }
+    benchmark::DoNotOptimize(sum);
+}
+
+/**
+ * @brief Round trip to another process and back, each side sleeping on the futex between events.
+ */
+static void BM_ShmPingPong(benchmark::State & state)
+{
+    const std::string ping = "/signals_ping_" + std::to_string(getpid());
+    const std::string pong = "/signals_pong_" + std::to_string(getpid());
+    ShmSignal<Quote> out(ping, 64);
+    ShmSignal<Quote> back(pong, 64);
+    const pid_t child = fork();
+    if(child == 0)
+    {
+        {
+            bool done = false;
+            LocalSignal<Quote> local;
+            Connection c = local.connect([&back, &done](const Quote & q){
+                done = q.id < 0;
+                back.emit(q);
+            });
+            ShmReceiver<Quote> receiver(ping, local);
+            while(!done)
+            {
+                receiver.wait();
+                receiver.poll();
+            }
+        }
+        _exit(0);
+    }
+    long last = 0;
+    LocalSignal<Quote> local;
+    Connection c = local.connect([&last](const Quote & q){ last = q.id; });
+    ShmReceiver<Quote> receiver(pong, local);
+    while(out.receivers() == 0)
+    {
+        usleep(100);
+    }
+    long i = 0;
+    for(auto _ : state)
+    {
+        out.emit(Quote{++i, 1.0, 2.0});
+        while(last != i)
+        {
+            receiver.wait();
+            receiver.poll();
+        }
+    }
+    out.emit(Quote{-1, 0.0, 0.0});
+    waitpid(child, nullptr, 0);
+}
+
+BENCHMARK(BM_ShmEmitPoll);
+BENCHMARK(BM_ShmPingPong)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,45 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+/**
+ * @brief The same 4 methods behind a Signal and a StaticSignal.
+ */
+static long total = 0;
+
+static void first(int v) { total += v; }
+static void second(int v) { total ^= v; }
+static void third(int v) { total += 2 * v; }
+static void fourth(int v) { total -= v / 3; }
+
+static void BM_DynamicSignal(benchmark::State & state)
+{
+    Signal<int> s;
+    std::vector<Connection<int>> connections;
+    connections.push_back(s.connect(&first));
+    connections.push_back(s.connect(&second));
+    connections.push_back(s.connect(&third));
+    connections.push_back(s.connect(&fourth));
+    int v = 0;
+    for(auto _ : state)
+    {
+        s.emit(++v);
+    }
+    benchmark::DoNotOptimize(total);
+}
+
+static void BM_StaticSignal(benchmark::State & state)
+{
+    using Sig = StaticSignal<void(int), &first, &second, &third, &fourth>;
+    int v = 0;
+    for(auto _ : state)
+    {
+        Sig::emit(++v);
+    }
+    benchmark::DoNotOptimize(total);
+}
+
+BENCHMARK(BM_DynamicSignal);
+BENCHMARK(BM_StaticSignal);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,42 @@
+#include <signals.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 10k methods connected through a std::shared_ptr to 100 models, per call against per emit tracking.
+ */
+struct Model
+{
+    long value = 0;
+
+    void update(int v)
+    {
+        this->value += v;
+    }
+};
+
+static void BM_Tracking(benchmark::State & state)
+{
+    Signal<int> s;
+    s.setTracking(static_cast<SignalTracking>(state.range(0)));
+    std::vector<std::shared_ptr<Model>> models;
+    std::vector<Connection<int>> connections;
+    for(int m = 0; m < 100; ++m)
+    {
+        models.push_back(std::make_shared<Model>());
+        for(int i = 0; i < 100; ++i)
+        {
+            connections.push_back(s.connect(models.back(), &Model::update));
+        }
+    }
+    for(auto _ : state)
+    {
+        s.emit(1);
+    }
+    state.SetItemsProcessed(state.iterations() * connections.size());
+}
+
+BENCHMARK(BM_Tracking)->Arg(static_cast<int>(SignalTracking::PerCall))->Arg(static_cast<int>(SignalTracking::PerEmit));
+
+BENCHMARK_MAIN();
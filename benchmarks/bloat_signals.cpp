@@ -0,0 +1,54 @@
+#include <signals.h>
+#include <utility>
+
+//Not a benchmark: many distinct signals, for the size of the object file, see the bloat target.
+#ifndef SIGNALS_BLOAT_COUNT
+#define SIGNALS_BLOAT_COUNT 64
+#endif
+
+template<int I>
+struct Event
+{
+    int value;
+};
+
+struct Listener
+{
+    int total = 0;
+
+    template<int I>
+    void on(const Event<I> & e)
+    {
+        this->total += e.value;
+    }
+};
+
+/**
+ * @brief What a typical user of a signal instantiates: a lambda and a class method, emit and disconnect.
+ */
+template<int I>
+int use(Listener & listener)
+{
+    Signal<Event<I>> s;
+    int calls = 0;
+    Connection c1 = s.connect([&calls](const Event<I> &) { ++calls; });
+    Connection c2 = s.connect(&listener, &Listener::on<I>);
+    s.emit(Event<I>{I});
+    s.blockAll();
+    s.unblockAll();
+    c1.disconnect();
+    s.disconnectAll();
+    return calls;
+}
+
+template<int... I>
+int useAll(Listener & listener, std::integer_sequence<int, I...>)
+{
+    return (use<I>(listener) + ... + 0);
+}
+
+int main()
+{
+    Listener listener;
+    return useAll(listener, std::make_integer_sequence<int, SIGNALS_BLOAT_COUNT>{}) == SIGNALS_BLOAT_COUNT ? 0 : 1;
+}
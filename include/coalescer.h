@@ -0,0 +1,388 @@
+#ifndef SIGNAL_COALESCER_H
+#define SIGNAL_COALESCER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "executor.h"
+
+/**
+ * @brief How a coalesced connection delivers, see @ref Coalescer.
+ * Every mode keeps only the latest arguments of each connection: one event per connection at most.
+ */
+namespace SignalThrottle {
+
+    /**
+     * @brief Deliver the latest arguments once per drain, if an emit happened since the last one.
+     */
+    struct Latest {};
+
+    /**
+     * @brief Deliver the latest arguments at most once per period. The last emit is always delivered, late if needed.
+     */
+    struct Every
+    {
+        std::chrono::nanoseconds period;
+    };
+
+    /**
+     * @brief Deliver the latest arguments once emits stopped for a quiet period.
+     * Emits read the clock, the other modes don't.
+     */
+    struct Debounce
+    {
+        std::chrono::nanoseconds quiet;
+    };
+}
+
+namespace SignalConcepts {
+
+    /**
+     * @brief Verify that a type is one of @ref SignalThrottle.
+     * @tparam T Type to verify.
+     */
+    template<typename T>
+    concept ThrottleMode = std::is_same_v<T, SignalThrottle::Latest>
+                        || std::is_same_v<T, SignalThrottle::Every>
+                        || std::is_same_v<T, SignalThrottle::Debounce>;
+}
+
+namespace SignalDetail {
+
+    /**
+     * @brief Latest arguments of a coalesced method. Emits overwrite them, the consumer takes them.
+     * A spin lock guards the value: held for a copy on emit, for a move on take, never during a call.
+     * @tparam Event Tuple of the arguments.
+     */
+    template<typename Event>
+    class LatestValue
+    {
+    public:
+        template<typename... A>
+        void store(A&&... args)
+        {
+            this->lock();
+            this->value.emplace(std::forward<A>(args)...);
+            this->unlock();
+        }
+
+        /**
+         * @brief Take the value if there is one and due() agrees, checked with the lock held.
+         */
+        template<typename Due>
+        std::optional<Event> takeIf(Due&& due)
+        {
+            std::optional<Event> out;
+            this->lock();
+            if(this->value && due())
+            {
+                out = std::move(this->value);
+                this->value.reset();
+            }
+            this->unlock();
+            return out;
+        }
+
+    private:
+        std::atomic<bool> busy{false};
+        std::optional<Event> value;
+
+        void lock()
+        {
+            //seq_cst: orders the take with the flag of SignalDetail::LatestMethod.
+            while(this->busy.exchange(true, std::memory_order_seq_cst))
+            {
+                while(this->busy.load(std::memory_order_relaxed))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void unlock()
+        {
+            this->busy.store(false, std::memory_order_release);
+        }
+    };
+
+    /**
+     * @brief Connection drained by a @ref Coalescer, whatever its method and mode.
+     */
+    class CoalescedSlot
+    {
+    public:
+        virtual ~CoalescedSlot() = default;
+
+        /**
+         * @brief Call the method if it has arguments to deliver now.
+         * @param now Time of the drain.
+         * @return Whether the method was called.
+         */
+        virtual bool deliver(std::chrono::steady_clock::time_point now) = 0;
+    };
+}
+
+/**
+ * @brief Drains coalesced connections, see @ref BasicSignal::connect(Coalescer&, Mode, ConnectArgs&&...).
+ *
+ * Emits only store the latest arguments of each connection, so a consumer 1000 times slower than
+ * the signal costs one copy per emit and no memory growth. Drain from a timer of your own, a UI
+ * frame for example, with @ref Coalescer::drain(), or on a thread with @ref Coalescer::run().
+ * A single thread at a time drains; methods run on it.
+ *
+ * @code{.cpp}
+ * Coalescer ui;
+ * Signal<double> price;
+ * Connection c = price.connect(ui, SignalThrottle::Every{std::chrono::milliseconds(16)}, &chart, &Chart::setPrice);
+ * std::thread t([&ui](){ ui.run(std::chrono::milliseconds(4)); });
+ * @endcode
+ */
+class Coalescer
+{
+public:
+    Coalescer() = default;
+
+    /**
+     * @brief Deleted. Connections point to the coalescer.
+     */
+    Coalescer(const Coalescer &) = delete;
+
+    /**
+     * @brief Deleted. Connections point to the coalescer.
+     */
+    Coalescer & operator=(const Coalescer &) = delete;
+
+    /**
+     * @brief Call every method with something due. Only one thread may drain at a time.
+     * @return Number of calls made.
+     */
+    std::size_t drain()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            std::erase_if(this->slots, [](const std::weak_ptr<SignalDetail::CoalescedSlot> & s) { return s.expired(); });
+            for(const std::weak_ptr<SignalDetail::CoalescedSlot> & weak: this->slots)
+            {
+                if(std::shared_ptr<SignalDetail::CoalescedSlot> slot = weak.lock())
+                {
+                    this->draining.push_back(std::move(slot));
+                }
+            }
+        }
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::size_t count = 0;
+        for(const std::shared_ptr<SignalDetail::CoalescedSlot> & slot: this->draining)
+        {
+            count += slot->deliver(now);
+        }
+        this->draining.clear();
+        return count;
+    }
+
+    /**
+     * @brief Drain every tick until @ref Coalescer::stop().
+     * @param tick Time between two drains, bounds how late a delivery can be.
+     */
+    void run(const std::chrono::nanoseconds tick)
+    {
+        std::unique_lock<std::mutex> lock(this->stopMtx);
+        while(!this->stopped)
+        {
+            lock.unlock();
+            this->drain();
+            lock.lock();
+            this->wake.wait_for(lock, tick, [this]() { return this->stopped; });
+        }
+    }
+
+    /**
+     * @brief Make @ref Coalescer::run() return. Coalesced arguments stay until the next drain.
+     */
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->stopMtx);
+            this->stopped = true;
+        }
+        this->wake.notify_all();
+    }
+
+    /**
+     * @brief Drain a connection from now on, as long as it lives.
+     * @param slot State of a coalesced connection.
+     */
+    void add(const std::shared_ptr<SignalDetail::CoalescedSlot> & slot)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->slots.push_back(slot);
+    }
+
+private:
+    /**
+     * @brief mtx Protects slots, never taken by emit.
+     */
+    std::mutex mtx;
+    std::vector<std::weak_ptr<SignalDetail::CoalescedSlot>> slots;
+    /**
+     * @brief Slots pinned during a drain, kept to reuse its storage.
+     */
+    std::vector<std::shared_ptr<SignalDetail::CoalescedSlot>> draining;
+    std::mutex stopMtx;
+    std::condition_variable wake;
+    bool stopped = false;
+};
+
+namespace SignalDetail {
+
+    /**
+     * @brief Call a method with a stored event: as lvalue for reference parameters, moved otherwise.
+     */
+    template<typename... Args, typename Method, typename Event, std::size_t... I>
+    void deliverEvent(Method & method, Event & event, std::index_sequence<I...>)
+    {
+        std::invoke(method, static_cast<Args&&>(std::get<I>(event))...);
+    }
+
+    /**
+     * @brief Stored in place of a method connected through a @ref Coalescer.
+     * Calls overwrite the latest arguments, the coalescer delivers them according to Mode.
+     * @tparam Method Connected callable.
+     * @tparam Mode One of @ref SignalThrottle.
+     * @tparam Args Signal parameters.
+     */
+    template<typename Method, typename Mode, typename... Args>
+    class CoalescedMethod
+    {
+        using Event = std::tuple<std::decay_t<Args>...>;
+        using Clock = std::chrono::steady_clock;
+
+        struct State : CoalescedSlot
+        {
+            State(Method && method, const Mode mode) : method(std::move(method)), mode(mode) {}
+
+            Method method;
+            Mode mode;
+            LatestValue<Event> value;
+            /**
+             * @brief Last emit, only kept by @ref SignalThrottle::Debounce.
+             */
+            std::atomic<Clock::rep> lastEmit{0};
+            /**
+             * @brief Last delivery, only touched by the draining thread.
+             */
+            std::optional<Clock::time_point> lastDelivery;
+
+            bool deliver(const Clock::time_point now) override
+            {
+                std::optional<Event> event = this->value.takeIf([this, now]() {
+                    if constexpr (std::is_same_v<Mode, SignalThrottle::Every>)
+                    {
+                        return !this->lastDelivery || now - *this->lastDelivery >= this->mode.period;
+                    }
+                    else if constexpr (std::is_same_v<Mode, SignalThrottle::Debounce>)
+                    {
+                        const Clock::time_point last{Clock::duration(this->lastEmit.load(std::memory_order_relaxed))};
+                        return now - last >= this->mode.quiet;
+                    }
+                    else
+                    {
+                        return true;
+                    }
+                });
+                if(!event)
+                {
+                    return false;
+                }
+                this->lastDelivery = now;
+                deliverEvent<Args...>(this->method, *event, std::index_sequence_for<Args...>{});
+                return true;
+            }
+        };
+
+    public:
+        template<typename M>
+        CoalescedMethod(Coalescer & coalescer, const Mode mode, M&& method)
+            : state(std::make_shared<State>(Method(std::forward<M>(method)), mode))
+        {
+            coalescer.add(this->state);
+        }
+
+        template<typename... A>
+        void operator()(A&&... args) const
+        {
+            if constexpr (std::is_same_v<Mode, SignalThrottle::Debounce>)
+            {
+                //Before the value: a drain seeing the value sees this time or a later one.
+                this->state->lastEmit.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+            }
+            this->state->value.store(std::forward<A>(args)...);
+        }
+
+    private:
+        std::shared_ptr<State> state;
+    };
+
+    /**
+     * @brief Stored in place of a method connected through an @ref Executor with @ref SignalThrottle::Latest.
+     * Calls overwrite the latest arguments and post an event only if none is waiting,
+     * so the executor queue holds one event per connection at most.
+     * @tparam Method Connected callable.
+     * @tparam Args Signal parameters.
+     */
+    template<typename Method, typename... Args>
+    class LatestMethod
+    {
+        using Event = std::tuple<std::decay_t<Args>...>;
+
+        struct State
+        {
+            explicit State(Method && method) : method(std::move(method)) {}
+
+            Method method;
+            LatestValue<Event> value;
+            std::atomic<bool> posted{false};
+        };
+
+    public:
+        template<typename M>
+        LatestMethod(Executor & executor, M&& method)
+            : executor(&executor), state(std::make_shared<State>(Method(std::forward<M>(method)))) {}
+
+        template<typename... A>
+        void operator()(A&&... args) const
+        {
+            this->state->value.store(std::forward<A>(args)...);
+            if(!this->state->posted.exchange(true, std::memory_order_seq_cst))
+            {
+                this->executor->post([weak = std::weak_ptr<State>(this->state)]() {
+                    if(std::shared_ptr<State> s = weak.lock())
+                    {
+                        //Cleared before taking: an emit racing with the take posts again.
+                        s->posted.store(false, std::memory_order_seq_cst);
+                        if(std::optional<Event> event = s->value.takeIf([]() { return true; }))
+                        {
+                            deliverEvent<Args...>(s->method, *event, std::index_sequence_for<Args...>{});
+                        }
+                    }
+                });
+            }
+        }
+
+    private:
+        Executor * executor;
+        std::shared_ptr<State> state;
+    };
+}
+
+#endif //SIGNAL_COALESCER_H
@@ -0,0 +1,225 @@
+#ifndef SIGNAL_COMBINER_H
+#define SIGNAL_COMBINER_H
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+
+/**
+ * @brief Combiners of @ref BasicSignal::emit(Combiner&&, const Args&...), turning the results of the methods into one.
+ *
+ * A combiner provides:
+ * - add(R result): take the result of a method, return false once the answer is known to stop the emit.
+ * - result(): what the emit returns.
+ *
+ * @code{.cpp}
+ * Signal<bool(const Order &)> validators;
+ * bool valid = validators.emit(SignalCombiner::AllTrue{}, order);
+ * @endcode
+ */
+namespace SignalCombiner {
+
+    /**
+     * @brief Whether every method returned true. Stops at the first false, true without method.
+     */
+    class AllTrue
+    {
+    public:
+        bool add(const bool value)
+        {
+            this->value = value;
+            return value;
+        }
+
+        bool result() const
+        {
+            return this->value;
+        }
+
+    private:
+        bool value = true;
+    };
+
+    /**
+     * @brief Whether a method returned true. Stops at the first true, false without method.
+     */
+    class AnyTrue
+    {
+    public:
+        bool add(const bool value)
+        {
+            this->value = value;
+            return !value;
+        }
+
+        bool result() const
+        {
+            return this->value;
+        }
+
+    private:
+        bool value = false;
+    };
+
+    /**
+     * @brief First result testing true, for example a non empty std::optional or a non null pointer.
+     * Stops there, gives a value initialized T if no method answered.
+     * @tparam T Result type of the signal.
+     */
+    template<typename T>
+    class FirstNonEmpty
+    {
+    public:
+        bool add(T value)
+        {
+            if(!value)
+            {
+                return true;
+            }
+            this->value = std::move(value);
+            return false;
+        }
+
+        T result()
+        {
+            return std::move(this->value);
+        }
+
+    private:
+        T value{};
+    };
+
+    /**
+     * @brief Sum of the results, starting from a value initialized T.
+     * @tparam T Result type of the signal.
+     */
+    template<typename T>
+    class Sum
+    {
+    public:
+        bool add(const T & value)
+        {
+            this->total += value;
+            return true;
+        }
+
+        T result()
+        {
+            return std::move(this->total);
+        }
+
+    private:
+        T total{};
+    };
+
+    /**
+     * @brief Smallest result, empty without method.
+     * @tparam T Result type of the signal.
+     */
+    template<typename T>
+    class Min
+    {
+    public:
+        bool add(T value)
+        {
+            if(!this->value || value < *this->value)
+            {
+                this->value = std::move(value);
+            }
+            return true;
+        }
+
+        std::optional<T> result()
+        {
+            return std::move(this->value);
+        }
+
+    private:
+        std::optional<T> value;
+    };
+
+    /**
+     * @brief Biggest result, empty without method.
+     * @tparam T Result type of the signal.
+     */
+    template<typename T>
+    class Max
+    {
+    public:
+        bool add(T value)
+        {
+            if(!this->value || *this->value < value)
+            {
+                this->value = std::move(value);
+            }
+            return true;
+        }
+
+        std::optional<T> result()
+        {
+            return std::move(this->value);
+        }
+
+    private:
+        std::optional<T> value;
+    };
+
+    /**
+     * @brief Store the results in a buffer of the caller, in call order. Stops once the buffer is full.
+     * @tparam T Result type of the signal.
+     *
+     * @code{.cpp}
+     * std::array<double, 16> quotes;
+     * std::span<double> got = s.emit(SignalCombiner::Collect(std::span(quotes)), symbol);
+     * @endcode
+     */
+    template<typename T>
+    class Collect
+    {
+    public:
+        /**
+         * @param buffer Where results are stored.
+         */
+        explicit Collect(const std::span<T> buffer) : buffer(buffer) {}
+
+        bool add(T value)
+        {
+            if(this->count == this->buffer.size())
+            {
+                return false;
+            }
+            this->buffer[this->count++] = std::move(value);
+            return this->count != this->buffer.size();
+        }
+
+        /**
+         * @return The part of the buffer holding results.
+         */
+        std::span<T> result() const
+        {
+            return this->buffer.first(this->count);
+        }
+
+    private:
+        std::span<T> buffer;
+        std::size_t count = 0;
+    };
+}
+
+namespace SignalConcepts {
+
+    /**
+     * @brief Verify that a type combines results of type R, see @ref SignalCombiner.
+     * @tparam C Type to verify.
+     * @tparam R Result type of the signal.
+     */
+    template<typename C, typename R>
+    concept Combiner = requires(C & combiner, R value) {
+        { combiner.add(std::move(value)) } -> std::convertible_to<bool>;
+        combiner.result();
+    };
+}
+
+#endif //SIGNAL_COMBINER_H
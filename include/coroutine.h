@@ -0,0 +1,223 @@
+#ifndef SIGNAL_COROUTINE_H
+#define SIGNAL_COROUTINE_H
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * @brief Fire and forget coroutine, for slots that suspend. See @ref BasicSignal::next().
+ *
+ * Starts as soon as it is called, so emit runs a coroutine slot until its first suspension and moves on.
+ * The frame is destroyed when the coroutine finishes. An exception escaping it calls std::terminate.
+ * Take signal parameters by value: references to emit arguments dangle once the coroutine suspends.
+ *
+ * @code{.cpp}
+ * signal.connect([](Order order) -> SignalTask {
+ *     auto [fill] = co_await fills.next();
+ *     ...
+ * });
+ * @endcode
+ */
+class SignalTask
+{
+public:
+    struct promise_type
+    {
+        SignalTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+namespace SignalDetail {
+
+    /**
+     * @brief Coroutines suspended on @ref BasicSignal::next(), resumed by the next emit.
+     *
+     * Awaiters live in the frame of their coroutine and are linked in place, so waiting allocates nothing.
+     * Emit only pays an atomic load while no coroutine waits.
+     * @tparam Args Signal parameters.
+     */
+    template<typename... Args>
+    class AwaiterList
+    {
+    public:
+        /**
+         * @brief What a resumed coroutine gets: a copy of the emit arguments.
+         */
+        using Event = std::tuple<std::decay_t<Args>...>;
+
+        /**
+         * @brief Result of @ref BasicSignal::next(), to co_await.
+         * Destroying a waiting coroutine unlinks it, as long as no emit of the signal runs meanwhile.
+         */
+        class Awaiter
+        {
+        public:
+            explicit Awaiter(AwaiterList & list) : list(&list) {}
+
+            /**
+             * @brief Deleted. Linked by address.
+             */
+            Awaiter(const Awaiter &) = delete;
+
+            /**
+             * @brief Deleted. Linked by address.
+             */
+            Awaiter & operator=(const Awaiter &) = delete;
+
+            ~Awaiter()
+            {
+                if(this->list != nullptr && this->handle)
+                {
+                    this->list->unlink(this);
+                }
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(const std::coroutine_handle<> h)
+            {
+                this->handle = h;
+                //May be resumed by another thread right after, don't touch this afterward.
+                this->list->link(this);
+            }
+
+            Event await_resume()
+            {
+                return std::move(*this->event);
+            }
+
+        private:
+            friend class AwaiterList;
+
+            /**
+             * @brief List the awaiter is linked in, nullptr once taken by an emit.
+             */
+            AwaiterList * list;
+            Awaiter * prev = nullptr;
+            Awaiter * next = nullptr;
+            std::coroutine_handle<> handle;
+            std::optional<Event> event;
+        };
+
+        AwaiterList() = default;
+        AwaiterList(const AwaiterList &) = delete;
+        AwaiterList & operator=(const AwaiterList &) = delete;
+
+        /**
+         * @brief Forget the waiting coroutines, they stay suspended.
+         */
+        ~AwaiterList()
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            for(Awaiter * node = this->head.load(std::memory_order_relaxed); node != nullptr; node = node->next)
+            {
+                node->list = nullptr;
+            }
+        }
+
+        /**
+         * @brief Whether a coroutine waits. Lock-free.
+         * @return true if an emit would resume one.
+         */
+        bool waiting() const
+        {
+            return this->head.load(std::memory_order_acquire) != nullptr;
+        }
+
+        /**
+         * @brief Resume every coroutine waiting when called, in the order they started waiting.
+         * Coroutines waiting again from there wait for the next call.
+         * @param args Arguments copied into each awaiter.
+         */
+        void resume(const Args&... args)
+        {
+            if(this->head.load(std::memory_order_acquire) == nullptr)
+            {
+                return;
+            }
+            Awaiter * node;
+            {
+                std::lock_guard<std::mutex> lock(this->mtx);
+                node = this->head.load(std::memory_order_relaxed);
+                this->head.store(nullptr, std::memory_order_relaxed);
+                this->tail = nullptr;
+                for(Awaiter * n = node; n != nullptr; n = n->next)
+                {
+                    n->list = nullptr;
+                }
+            }
+            while(node != nullptr)
+            {
+                //The coroutine destroys its awaiter once resumed.
+                Awaiter * next = node->next;
+                node->event.emplace(args...);
+                node->handle.resume();
+                node = next;
+            }
+        }
+
+    private:
+        /**
+         * @brief mtx Protects the links, never taken by emit while no coroutine waits.
+         */
+        std::mutex mtx;
+        std::atomic<Awaiter *> head{nullptr};
+        Awaiter * tail = nullptr;
+
+        void link(Awaiter * node)
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            node->prev = this->tail;
+            node->next = nullptr;
+            if(this->tail != nullptr)
+            {
+                this->tail->next = node;
+            }
+            else
+            {
+                this->head.store(node, std::memory_order_release);
+            }
+            this->tail = node;
+        }
+
+        void unlink(Awaiter * node)
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            if(node->list == nullptr)
+            {
+                return;
+            }
+            node->list = nullptr;
+            if(node->prev != nullptr)
+            {
+                node->prev->next = node->next;
+            }
+            else
+            {
+                this->head.store(node->next, std::memory_order_release);
+            }
+            if(node->next != nullptr)
+            {
+                node->next->prev = node->prev;
+            }
+            else
+            {
+                this->tail = node->prev;
+            }
+        }
+    };
+}
+
+#endif //SIGNAL_COROUTINE_H
@@ -0,0 +1,255 @@
+#ifndef SIGNAL_DISPATCH_H
+#define SIGNAL_DISPATCH_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace SignalDetail {
+
+    /**
+     * @brief How a stored method receives the arguments of an emit.
+     */
+    enum class Pass
+    {
+        /**
+         * @brief argv holds one pointer per argument, given to the method as const references.
+         */
+        Copy,
+        /**
+         * @brief Same as Copy, but given as rvalues: the method may move from them.
+         */
+        Move,
+        /**
+         * @brief argv[0] points to a std::span<const std::tuple<Args...>>, one call per element.
+         */
+        Batch,
+        /**
+         * @brief Same as Copy, argv[N] points to a std::optional receiving the result, see @ref ResultDispatcher.
+         */
+        Collect
+    };
+
+    /**
+     * @brief Pointers to emit arguments, as stored methods receive them.
+     * Never empty so it's a valid array even without argument.
+     * @tparam N Number of arguments.
+     */
+    template<std::size_t N>
+    struct ArgPointers
+    {
+        void * argv[N == 0 ? 1 : N];
+
+        template<typename... A>
+        explicit ArgPointers(A&... args) : argv{const_cast<void *>(static_cast<const void *>(std::addressof(args)))...} {}
+
+        operator void * const *() const
+        {
+            return this->argv;
+        }
+    };
+
+    template<typename... A>
+    ArgPointers(A&...) -> ArgPointers<sizeof...(A)>;
+
+    /**
+     * @brief Get back an argument from its pointer.
+     * @tparam Arg Signal parameter type.
+     */
+    template<typename Arg>
+    std::remove_reference_t<Arg> & argAt(void * const * argv, const std::size_t i)
+    {
+        return *static_cast<std::remove_reference_t<Arg> *>(argv[i]);
+    }
+
+    /**
+     * @brief Adapter stored for every connected method.
+     * Unpacks the argument pointers given by the signal. The method only sees
+     * const references, or rvalues for @ref Pass::Move. Batches are looped here, so besides
+     * the single indirect call per method, calls to the method itself are inlined.
+     * @tparam Method Connected callable.
+     * @tparam Args Signal parameters.
+     */
+    template<typename Method, typename... Args>
+    struct Dispatcher
+    {
+        Method method;
+
+        void operator()(const Pass pass, void * const * argv)
+        {
+            this->dispatch(pass, argv, std::index_sequence_for<Args...>{});
+        }
+
+    private:
+        template<std::size_t... I>
+        void dispatch(const Pass pass, void * const * argv, std::index_sequence<I...>)
+        {
+            if(pass == Pass::Batch)
+            {
+                for(const std::tuple<Args...> & event: *static_cast<const std::span<const std::tuple<Args...>> *>(argv[0]))
+                {
+                    std::invoke(this->method, static_cast<const Args&>(std::get<I>(event))...);
+                }
+                return;
+            }
+            if constexpr (std::is_invocable_v<Method&, Args&&...>)
+            {
+                if(pass == Pass::Move)
+                {
+                    std::invoke(this->method, static_cast<Args&&>(argAt<Args>(argv, I))...);
+                    return;
+                }
+            }
+            std::invoke(this->method, static_cast<const Args&>(argAt<Args>(argv, I))...);
+        }
+    };
+
+    /**
+     * @brief Adapter stored for the methods of a signal returning R, see @ref BasicSignal::emit(Combiner&&, const Args&...).
+     * Gives the result back for @ref Pass::Collect, discards it for the other passes.
+     * @tparam R Result type of the signal.
+     */
+    template<typename R>
+    struct ResultDispatcher
+    {
+        /**
+         * @tparam Method Connected callable, returning something convertible to R.
+         * @tparam Args Signal parameters.
+         */
+        template<typename Method, typename... Args>
+        struct type : Dispatcher<Method, Args...>
+        {
+            static_assert(std::is_convertible_v<std::invoke_result_t<Method&, const Args&...>, R>,
+                          "Methods of a signal must return something convertible to its result type");
+
+            void operator()(const Pass pass, void * const * argv)
+            {
+                if(pass == Pass::Collect)
+                {
+                    this->collect(argv, std::index_sequence_for<Args...>{});
+                    return;
+                }
+                Dispatcher<Method, Args...>::operator()(pass, argv);
+            }
+
+        private:
+            template<std::size_t... I>
+            void collect(void * const * argv, std::index_sequence<I...>)
+            {
+                static_cast<std::optional<R> *>(argv[sizeof...(Args)])->emplace(
+                    std::invoke(this->method, static_cast<const Args&>(argAt<Args>(argv, I))...));
+            }
+        };
+    };
+
+    /**
+     * @brief Methods of plain signals need no result.
+     */
+    template<>
+    struct ResultDispatcher<void>
+    {
+        template<typename Method, typename... Args>
+        using type = Dispatcher<Method, Args...>;
+    };
+
+    /**
+     * @brief Policy of a signal whose methods return R: the synchronization of Policy, with the result type.
+     * @tparam Policy One of @ref SignalPolicy.
+     * @tparam R Result of the methods, void for a plain signal.
+     */
+    template<typename Policy, typename R>
+    struct Returning
+    {
+        template<typename List>
+        using Storage = typename Policy::template Storage<List>;
+    };
+
+    /**
+     * @brief Result type of the methods of a signal using Policy, void unless it is a @ref Returning.
+     */
+    template<typename Policy>
+    struct ResultOf
+    {
+        using type = void;
+    };
+
+    template<typename Policy, typename R>
+    struct ResultOf<Returning<Policy, R>>
+    {
+        using type = R;
+    };
+
+    /**
+     * @brief Adapter for methods receiving a whole batch at once, see BasicSignal::connectBatch().
+     * A single emit is given to them as a batch of one copied event.
+     * @tparam Method Callable taking a std::span<const std::tuple<Args...>>.
+     * @tparam Args Signal parameters.
+     */
+    template<typename Method, typename... Args>
+    struct BatchDispatcher
+    {
+        Method method;
+
+        void operator()(const Pass pass, void * const * argv)
+        {
+            using Batch = std::span<const std::tuple<Args...>>;
+            if(pass == Pass::Batch)
+            {
+                std::invoke(this->method, *static_cast<const Batch *>(argv[0]));
+                return;
+            }
+            const std::tuple<Args...> event = this->single(argv, std::index_sequence_for<Args...>{});
+            std::invoke(this->method, Batch(&event, 1));
+        }
+
+    private:
+        template<std::size_t... I>
+        static std::tuple<Args...> single(void * const * argv, std::index_sequence<I...>)
+        {
+            return std::tuple<Args...>(static_cast<const Args&>(argAt<Args>(argv, I))...);
+        }
+    };
+
+    /**
+     * @brief Method that must only run while an object lives, see @ref SignalTracking.
+     * The signal checks the object instead of the method, so the method itself holds a plain pointer.
+     * @tparam Method Callable.
+     */
+    template<typename Method>
+    struct Tracked
+    {
+        Method method;
+        std::weak_ptr<void> object;
+    };
+
+    template<typename T>
+    constexpr bool isTracked = false;
+
+    template<typename Method>
+    constexpr bool isTracked<Tracked<Method>> = true;
+
+    /**
+     * @brief Object pointer bound to a member function known at compile time.
+     * Trivially copyable, so stored methods holding it are copied with memcpy.
+     * @tparam Method Class method.
+     * @tparam T Class of the object.
+     */
+    template<auto Method, typename T>
+    struct MemberDelegate
+    {
+        T * instance;
+
+        template<typename... A>
+        decltype(auto) operator()(A&&... args) const
+        {
+            return (this->instance->*Method)(std::forward<A>(args)...);
+        }
+    };
+}
+
+#endif //SIGNAL_DISPATCH_H
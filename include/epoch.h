@@ -0,0 +1,349 @@
+#ifndef SIGNAL_EPOCH_H
+#define SIGNAL_EPOCH_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @def SIGNAL_NO_MEMBARRIER
+ * @brief Define it to keep a fence on the read side of @ref SignalDetail::EpochDomain even where membarrier() exists.
+ */
+#if defined(__linux__) && !defined(SIGNAL_NO_MEMBARRIER)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define SIGNAL_EPOCH_MEMBARRIER
+#endif
+
+namespace SignalDetail {
+
+/**
+ * @brief Epoch based memory reclamation shared by every lock-free signal of the program.
+ *
+ * Readers wrap their accesses in a @ref EpochDomain::Guard. It only writes to a record owned by the current thread,
+ * so concurrent readers never share a written cache line.
+ * Writers unpublish an object and @ref EpochDomain::retire() it: it is destroyed once every thread
+ * that could still see it has left its read section. Writers never wait for readers.
+ *
+ * On Linux, entering a read section doesn't even fence: writers make every running thread fence
+ * for them with membarrier(), a syscall per collection. Elsewhere readers use a seq_cst store.
+ */
+class EpochDomain
+{
+    /**
+     * @brief Per thread state. Never freed, reused when its thread exits.
+     */
+    struct alignas(64) Record
+    {
+        /**
+         * @brief Epoch observed when the thread entered its read section, 0 when outside.
+         */
+        std::atomic<std::uint64_t> epoch{0};
+        /**
+         * @brief Whether a thread currently owns this record.
+         */
+        std::atomic<bool> used{true};
+        /**
+         * @brief Nesting level of read sections. Only touched by the owning thread.
+         */
+        unsigned int depth = 0;
+        /**
+         * @brief Next record of the domain.
+         */
+        Record * next = nullptr;
+    };
+
+    /**
+     * @brief An unpublished object waiting for readers to leave.
+     */
+    struct Retired
+    {
+        void * object;
+        void (*deleter)(void *);
+        std::uint64_t epoch;
+        const void * owner;
+    };
+
+    /**
+     * @brief Give back the record of the current thread when it exits.
+     */
+    struct ThreadRecord
+    {
+        Record * record;
+
+        ThreadRecord() : record(EpochDomain::instance().acquireRecord()) {}
+        ~ThreadRecord()
+        {
+            this->record->epoch.store(0, std::memory_order_release);
+            this->record->used.store(false, std::memory_order_release);
+        }
+    };
+
+public:
+    /**
+     * @brief RAII read section. While alive, nothing retired after its creation is destroyed.
+     * Nestable, also across different signals.
+     */
+    class Guard
+    {
+    public:
+        Guard() : record(EpochDomain::threadRecord())
+        {
+            if(this->record->depth++ == 0)
+            {
+                const EpochDomain & domain = EpochDomain::instance();
+                const std::uint64_t epoch = domain.globalEpoch.load(std::memory_order_acquire);
+                //Pairs with the fence in collect(): either the writer sees us, or we see its new pointer.
+                if(domain.asymmetric)
+                {
+                    this->record->epoch.store(epoch, std::memory_order_relaxed);
+                    std::atomic_signal_fence(std::memory_order_seq_cst);
+                }
+                else
+                {
+                    this->record->epoch.store(epoch, std::memory_order_seq_cst);
+                }
+            }
+        }
+
+        Guard(const Guard &) = delete;
+        Guard & operator=(const Guard &) = delete;
+
+        ~Guard()
+        {
+            if(--this->record->depth == 0)
+            {
+                this->record->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+    private:
+        Record * record;
+    };
+
+    /**
+     * @brief The domain instance, shared by the whole program.
+     * @return The domain.
+     */
+    static EpochDomain & instance()
+    {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain & operator=(const EpochDomain &) = delete;
+
+    /**
+     * @brief Destroy everything still retired. Readers are gone by then.
+     */
+    ~EpochDomain()
+    {
+        for(Retired & r: this->retired)
+        {
+            r.deleter(r.object);
+        }
+        Record * record = this->records.load(std::memory_order_acquire);
+        while(record != nullptr)
+        {
+            Record * next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    /**
+     * @brief Destroy an object once no reader can access it anymore.
+     * The object must already be unreachable for new readers.
+     * @param object Object to destroy.
+     * @param deleter Called with the object to destroy it, plain delete by default.
+     * @param owner Tag for @ref EpochDomain::reclaim().
+     */
+    template<typename T>
+    void retire(T * object, void (*deleter)(void *) = [](void * p) { delete static_cast<T *>(p); }, const void * owner = nullptr)
+    {
+        if(object == nullptr)
+        {
+            return;
+        }
+        //Any reader entering after this increment will see the replacement of object.
+        const std::uint64_t epoch = this->globalEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            this->retired.push_back(Retired{object, deleter, epoch, owner});
+        }
+        this->collect();
+    }
+
+    /**
+     * @brief Destroy retired objects no reader can access anymore. Never waits.
+     */
+    void collect()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            if(this->retired.empty())
+            {
+                return;
+            }
+        }
+        this->heavyFence();
+        std::vector<Retired> ready;
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            const std::uint64_t oldest = this->oldestActiveEpoch();
+            std::erase_if(this->retired, [&ready, oldest](const Retired & r) {
+                if(r.epoch <= oldest)
+                {
+                    ready.push_back(r);
+                    return true;
+                }
+                return false;
+            });
+        }
+        //Run destructors unlocked, they may retire other objects.
+        for(Retired & r: ready)
+        {
+            r.deleter(r.object);
+        }
+    }
+
+    /**
+     * @brief Destroy now the objects retired by an owner, for example when their memory resource goes away.
+     * The caller guarantees no reader can access them anymore.
+     * @param owner Tag given to @ref EpochDomain::retire().
+     */
+    void reclaim(const void * owner)
+    {
+        std::vector<Retired> ready;
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            std::erase_if(this->retired, [&ready, owner](const Retired & r) {
+                if(r.owner == owner)
+                {
+                    ready.push_back(r);
+                    return true;
+                }
+                return false;
+            });
+        }
+        for(Retired & r: ready)
+        {
+            r.deleter(r.object);
+        }
+    }
+
+private:
+    EpochDomain() = default;
+
+    /**
+     * @brief Current epoch, starts at 1 since 0 means inactive.
+     */
+    std::atomic<std::uint64_t> globalEpoch{1};
+    /**
+     * @brief Whether readers skip their fence, see @ref EpochDomain::heavyFence().
+     */
+    const bool asymmetric = registerMembarrier();
+    /**
+     * @brief Singly linked list of thread records, only grows.
+     */
+    std::atomic<Record *> records{nullptr};
+    /**
+     * @brief mtx Protects the retired list. Never taken by readers.
+     */
+    std::mutex mtx;
+    /**
+     * @brief Objects waiting to be destroyed.
+     */
+    std::vector<Retired> retired;
+
+    /**
+     * @brief Ask the kernel for expedited membarrier() in this process.
+     * @return true if readers can skip their fence.
+     */
+    static bool registerMembarrier()
+    {
+#ifdef SIGNAL_EPOCH_MEMBARRIER
+        const long commands = syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0);
+        return commands > 0
+            && (commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED) != 0
+            && syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Fence standing for the one readers skipped: every running thread of the process
+     * executes a full barrier before it returns. Nothing to do when readers fence themselves.
+     */
+    void heavyFence() const
+    {
+#ifdef SIGNAL_EPOCH_MEMBARRIER
+        if(this->asymmetric)
+        {
+            //Can't fail once registered.
+            syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Record of the calling thread.
+     * @return The record, valid until the thread exits.
+     */
+    static Record * threadRecord()
+    {
+        thread_local ThreadRecord local;
+        return local.record;
+    }
+
+    /**
+     * @brief Reuse the record of an exited thread or create a new one.
+     * @return A record owned by the calling thread.
+     */
+    Record * acquireRecord()
+    {
+        for(Record * r = this->records.load(std::memory_order_acquire); r != nullptr; r = r->next)
+        {
+            bool expected = false;
+            if(!r->used.load(std::memory_order_relaxed)
+             && r->used.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                r->depth = 0;
+                return r;
+            }
+        }
+        Record * r = new Record();
+        r->next = this->records.load(std::memory_order_relaxed);
+        while(!this->records.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        return r;
+    }
+
+    /**
+     * @brief Smallest epoch seen by a thread still inside a read section.
+     * @return That epoch, or the maximum value if no thread is reading.
+     */
+    std::uint64_t oldestActiveEpoch() const
+    {
+        std::uint64_t oldest = UINT64_MAX;
+        for(Record * r = this->records.load(std::memory_order_acquire); r != nullptr; r = r->next)
+        {
+            const std::uint64_t e = r->epoch.load(std::memory_order_seq_cst);
+            if(e != 0 && e < oldest)
+            {
+                oldest = e;
+            }
+        }
+        return oldest;
+    }
+};
+
+}
+
+#endif //SIGNAL_EPOCH_H
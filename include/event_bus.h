@@ -0,0 +1,276 @@
+#ifndef SIGNAL_EVENT_BUS_H
+#define SIGNAL_EVENT_BUS_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace SignalDetail {
+
+    /**
+     * @brief Position of a type in a list, sizeof...(Events) if absent.
+     */
+    template<typename Event, typename... Events>
+    inline constexpr std::size_t eventIndex = []() {
+        std::size_t index = 0;
+        ((std::is_same_v<Event, Events> ? false : (++index, true)) && ...);
+        return index;
+    }();
+
+    template<typename... Events, std::size_t... I>
+    constexpr bool distinctEvents(std::index_sequence<I...>)
+    {
+        return ((eventIndex<Events, Events...> == I) && ...);
+    }
+}
+
+namespace SignalConcepts {
+
+    /**
+     * @brief Verify that an event is one of a bus.
+     * @tparam Event Type to verify.
+     * @tparam Events Events of the bus.
+     */
+    template<typename Event, typename... Events>
+    concept BusEvent = SignalDetail::eventIndex<Event, Events...> < sizeof...(Events);
+}
+
+/**
+ * @brief Any event of an @ref EventBus, as given to the methods connected with @ref BasicEventBus::connectAll().
+ * Only a reference: valid during the call.
+ * @tparam Events Events of the bus.
+ */
+template<typename... Events>
+class EventRef
+{
+public:
+    template<SignalConcepts::BusEvent<Events...> Event>
+    explicit EventRef(const Event & event) : which(SignalDetail::eventIndex<Event, Events...>), event(&event) {}
+
+    /**
+     * @brief Position of the event type in Events.
+     */
+    std::size_t index() const
+    {
+        return this->which;
+    }
+
+    template<SignalConcepts::BusEvent<Events...> Event>
+    bool is() const
+    {
+        return this->which == SignalDetail::eventIndex<Event, Events...>;
+    }
+
+    /**
+     * @brief The event if it is an Event, else nullptr.
+     */
+    template<SignalConcepts::BusEvent<Events...> Event>
+    const Event * get() const
+    {
+        return this->is<Event>() ? static_cast<const Event *>(this->event) : nullptr;
+    }
+
+    /**
+     * @brief Call a visitor with the event, as its own type.
+     * @param visitor Callable taking any of the Events.
+     */
+    template<typename Visitor>
+    void visit(Visitor&& visitor) const
+    {
+        this->visitAt(visitor, std::index_sequence_for<Events...>{});
+    }
+
+private:
+    std::size_t which;
+    const void * event;
+
+    template<typename Visitor, std::size_t... I>
+    void visitAt(Visitor & visitor, std::index_sequence<I...>) const
+    {
+        ((this->which == I ? (visitor(*static_cast<const Events *>(this->event)), true) : false) || ...);
+    }
+};
+
+/**
+ * @brief Implementation of @ref EventBus for a given synchronization policy.
+ *
+ * One signal per event type, held in a tuple: @ref BasicEventBus::emit() picks it at compile time,
+ * without any lookup. Methods connected with @ref BasicEventBus::connectAll() get every event
+ * through an @ref EventRef; they live in a list of their own, checked with a single load on emit.
+ * @tparam Policy One of @ref SignalPolicy.
+ * @tparam Events Event types, all different.
+ */
+template<typename Policy, typename... Events>
+class BasicEventBus
+{
+    static_assert(sizeof...(Events) > 0, "An EventBus needs events");
+    static_assert(SignalDetail::distinctEvents<Events...>(std::index_sequence_for<Events...>{}), "EventBus events must be different types");
+
+public:
+    /**
+     * @brief Reference to any event, see @ref EventRef.
+     */
+    using Any = EventRef<Events...>;
+
+    /**
+     * @brief Signal of an event type.
+     */
+    template<typename Event>
+    using SignalOf = BasicSignal<Policy, const Event &>;
+
+    BasicEventBus() = default;
+
+    /**
+     * @brief Bus whose signals allocate from a memory resource, see @ref BasicSignal::BasicSignal(std::pmr::memory_resource*).
+     * @param resource Memory resource of every signal.
+     */
+    explicit BasicEventBus(std::pmr::memory_resource * resource)
+        : signals(((void)sizeof(Events), resource)...), all(resource) {}
+
+    /**
+     * @brief Deleted. Connections point to the signals.
+     */
+    BasicEventBus(const BasicEventBus &) = delete;
+
+    /**
+     * @brief Deleted. Connections point to the signals.
+     */
+    BasicEventBus & operator=(const BasicEventBus &) = delete;
+
+    /**
+     * @brief Connect a method to an event type, see @ref BasicSignal::connect().
+     * @tparam Event One of Events, given as const Event & to the method.
+     * @param args Same as for @ref BasicSignal::connect().
+     * @return Connection, which must be kept.
+     *
+     * @code{.cpp}
+     * EventBus<OrderFilled, Heartbeat> bus;
+     * Connection c = bus.connect<OrderFilled>(&book, &Book::onFill);
+     * @endcode
+     */
+    template<SignalConcepts::BusEvent<Events...> Event, typename... ConnectArgs>
+    auto connect(ConnectArgs&&... args)
+    {
+        return this->template signal<Event>().connect(std::forward<ConnectArgs>(args)...);
+    }
+
+    /**
+     * @brief Connect a method to every event type, given as const @ref EventRef &.
+     * Called after the methods of the event type.
+     * @param args Same as for @ref BasicSignal::connect().
+     * @return Connection, which must be kept.
+     */
+    template<typename... ConnectArgs>
+    auto connectAll(ConnectArgs&&... args)
+    {
+        return this->all.connect(std::forward<ConnectArgs>(args)...);
+    }
+
+    /**
+     * @brief Emit an event to its methods, then to those of every event.
+     * @param event Event to emit.
+     */
+    template<SignalConcepts::BusEvent<Events...> Event>
+    void emit(const Event & event)
+    {
+        this->template signal<Event>().emit(event);
+        if(this->all.hasActiveListeners())
+        {
+            this->all.emit(Any(event));
+        }
+    }
+
+    /**
+     * @brief Build an event and emit it, see @ref BasicEventBus::emit(const Event&).
+     * @tparam Event One of Events.
+     * @param args Arguments of the event, braced initialized for aggregates.
+     *
+     * @code{.cpp}
+     * bus.emit<OrderFilled>(id, price);
+     * @endcode
+     */
+    template<SignalConcepts::BusEvent<Events...> Event, typename... A>
+    void emit(A&&... args)
+    {
+        if constexpr (sizeof...(A) == 1 && (std::is_same_v<std::remove_cvref_t<A>, Event> && ...))
+        {
+            this->emit(static_cast<const Event &>(args)...);
+        }
+        else if constexpr (std::is_aggregate_v<Event>)
+        {
+            this->emit(static_cast<const Event &>(Event{std::forward<A>(args)...}));
+        }
+        else
+        {
+            this->emit(static_cast<const Event &>(Event(std::forward<A>(args)...)));
+        }
+    }
+
+    /**
+     * @brief Whether an emit of Event would call something.
+     */
+    template<SignalConcepts::BusEvent<Events...> Event>
+    bool hasActiveListeners() const
+    {
+        return this->template signal<Event>().hasActiveListeners() || this->all.hasActiveListeners();
+    }
+
+    /**
+     * @brief Signal of an event type, for its other emits and connects.
+     * Methods connected to every event are not called by its emits.
+     * @tparam Event One of Events.
+     */
+    template<SignalConcepts::BusEvent<Events...> Event>
+    SignalOf<Event> & signal()
+    {
+        return std::get<SignalDetail::eventIndex<Event, Events...>>(this->signals);
+    }
+
+    template<SignalConcepts::BusEvent<Events...> Event>
+    const SignalOf<Event> & signal() const
+    {
+        return std::get<SignalDetail::eventIndex<Event, Events...>>(this->signals);
+    }
+
+private:
+    std::tuple<SignalOf<Events>...> signals;
+    /**
+     * @brief all Methods connected to every event.
+     */
+    BasicSignal<Policy, const Any &> all;
+};
+
+/**
+ * @brief Typed event bus: one signal per event type, routed at compile time.
+ * Uses @ref SignalPolicy::Mutex, give another policy as first parameter to change it.
+ * @tparam Events Event types, all different.
+ *
+ * @code{.cpp}
+ * EventBus<OrderFilled, OrderCancelled> bus;
+ * Connection c1 = bus.connect<OrderFilled>([](const OrderFilled & f) { ... });
+ * Connection c2 = bus.connectAll([](const EventRef<OrderFilled, OrderCancelled> & e) { ... });
+ * bus.emit(OrderFilled{42, 1.25});
+ * @endcode
+ */
+template<typename... Events>
+class EventBus : public BasicEventBus<SignalPolicy::Mutex, Events...>
+{
+public:
+    using BasicEventBus<SignalPolicy::Mutex, Events...>::BasicEventBus;
+};
+
+/**
+ * @brief Event bus with an explicit synchronization policy.
+ * @tparam Policy One of @ref SignalPolicy.
+ * @tparam Events Event types, all different.
+ */
+template<SignalConcepts::SyncPolicy Policy, typename... Events>
+class EventBus<Policy, Events...> : public BasicEventBus<Policy, Events...>
+{
+public:
+    using BasicEventBus<Policy, Events...>::BasicEventBus;
+};
+
+#endif //SIGNAL_EVENT_BUS_H
@@ -0,0 +1,333 @@
+#ifndef SIGNAL_EXECUTOR_H
+#define SIGNAL_EXECUTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "function.h"
+
+/**
+ * @def SIGNAL_EVENT_CAPACITY
+ * @brief Inline capacity, in bytes, of a queued event. Events capturing bigger arguments allocate.
+ */
+#ifndef SIGNAL_EVENT_CAPACITY
+#define SIGNAL_EVENT_CAPACITY 64
+#endif
+
+namespace SignalDetail {
+
+    /**
+     * @brief A queued call, linked in an @ref Executor queue or in the pool.
+     */
+    struct EventNode
+    {
+        std::atomic<EventNode *> next{nullptr};
+        MoveOnlyFunction<void(), SIGNAL_EVENT_CAPACITY> task;
+    };
+
+    /**
+     * @brief Recycles event nodes so posting doesn't hit the global allocator once warmed up.
+     *
+     * Each thread takes nodes from its own cache. Executors give back consumed nodes to a shared
+     * lock-free stack, that a thread with an empty cache takes whole: a single exchange, no ABA.
+     */
+    class EventPool
+    {
+        /**
+         * @brief Nodes owned by the current thread.
+         */
+        struct Cache
+        {
+            EventNode * head = nullptr;
+
+            ~Cache()
+            {
+                while(this->head != nullptr)
+                {
+                    EventNode * next = this->head->next.load(std::memory_order_relaxed);
+                    delete this->head;
+                    this->head = next;
+                }
+            }
+        };
+
+        static std::atomic<EventNode *> & returned()
+        {
+            static std::atomic<EventNode *> stack{nullptr};
+            return stack;
+        }
+
+        static Cache & cache()
+        {
+            thread_local Cache local;
+            return local;
+        }
+
+    public:
+        /**
+         * @brief Get an empty node.
+         * @return A node, owned by the caller.
+         */
+        static EventNode * acquire()
+        {
+            Cache & local = cache();
+            if(local.head == nullptr)
+            {
+                local.head = returned().exchange(nullptr, std::memory_order_acquire);
+                if(local.head == nullptr)
+                {
+                    return new EventNode();
+                }
+            }
+            EventNode * node = local.head;
+            local.head = node->next.load(std::memory_order_relaxed);
+            node->next.store(nullptr, std::memory_order_relaxed);
+            return node;
+        }
+
+        /**
+         * @brief Give back a node whose task was destroyed. Callable from any thread.
+         * @param node Node to recycle.
+         */
+        static void release(EventNode * node)
+        {
+            std::atomic<EventNode *> & stack = returned();
+            EventNode * head = stack.load(std::memory_order_relaxed);
+            do
+            {
+                node->next.store(head, std::memory_order_relaxed);
+            }
+            while(!stack.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+        }
+    };
+}
+
+/**
+ * @brief Runs queued calls on the thread of its choice, see queued connections in @ref BasicSignal::connect().
+ *
+ * Any thread can @ref Executor::post(), it is lock-free and doesn't allocate once the event pool is warmed up.
+ * A single thread at a time drains the queue with @ref Executor::poll() or @ref Executor::run().
+ *
+ * @code{.cpp}
+ * Executor worker;
+ * std::thread t([&worker](){ worker.run(); });
+ * signal.connect(worker, &consumer, &Consumer::onTick);
+ * ...
+ * worker.stop();
+ * t.join();
+ * @endcode
+ */
+class Executor
+{
+public:
+    Executor() = default;
+
+    /**
+     * @brief Deleted. Connections point to the executor.
+     */
+    Executor(const Executor &) = delete;
+
+    /**
+     * @brief Deleted. Connections point to the executor.
+     */
+    Executor & operator=(const Executor &) = delete;
+
+    /**
+     * @brief Drop the calls still queued.
+     */
+    ~Executor()
+    {
+        while(SignalDetail::EventNode * node = this->pop())
+        {
+            node->task = nullptr;
+            SignalDetail::EventPool::release(node);
+        }
+    }
+
+    /**
+     * @brief Queue a call. Lock-free, callable from any thread.
+     * @param task Callable without parameter.
+     */
+    template<typename Task>
+    void post(Task&& task)
+    {
+        SignalDetail::EventNode * node = SignalDetail::EventPool::acquire();
+        node->task = std::forward<Task>(task);
+        this->push(node);
+        this->sequence.fetch_add(1, std::memory_order_seq_cst);
+        if(this->waiting.load(std::memory_order_seq_cst))
+        {
+            this->sequence.notify_one();
+        }
+    }
+
+    /**
+     * @brief Run every queued call. Only one thread may drain at a time.
+     * @return Number of calls run.
+     */
+    std::size_t poll()
+    {
+        std::size_t count = 0;
+        while(SignalDetail::EventNode * node = this->pop())
+        {
+            node->task();
+            node->task = nullptr;
+            SignalDetail::EventPool::release(node);
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Run queued calls as they come, sleeping when there is none, until @ref Executor::stop().
+     */
+    void run()
+    {
+        while(!this->stopped.load(std::memory_order_acquire))
+        {
+            const std::uint32_t seen = this->sequence.load(std::memory_order_seq_cst);
+            if(this->poll() == 0 && !this->stopped.load(std::memory_order_acquire))
+            {
+                this->waiting.store(true, std::memory_order_seq_cst);
+                this->sequence.wait(seen, std::memory_order_seq_cst);
+                this->waiting.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Make @ref Executor::run() return. Calls still queued stay queued.
+     */
+    void stop()
+    {
+        this->stopped.store(true, std::memory_order_release);
+        this->sequence.fetch_add(1, std::memory_order_seq_cst);
+        this->sequence.notify_all();
+    }
+
+private:
+    /**
+     * @brief Always in the queue so producers never see it empty.
+     */
+    SignalDetail::EventNode stub;
+    /**
+     * @brief Last pushed node, exchanged by producers.
+     */
+    alignas(64) std::atomic<SignalDetail::EventNode *> head{&stub};
+    /**
+     * @brief Next node to pop, only touched by the consumer.
+     */
+    alignas(64) SignalDetail::EventNode * tail = &stub;
+    /**
+     * @brief Bumped on every post, waited on by @ref Executor::run().
+     */
+    std::atomic<std::uint32_t> sequence{0};
+    std::atomic<bool> waiting{false};
+    std::atomic<bool> stopped{false};
+
+    /**
+     * @brief Intrusive multi producer single consumer push (D. Vyukov).
+     * @param node Node to append.
+     */
+    void push(SignalDetail::EventNode * node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        SignalDetail::EventNode * prev = this->head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer side pop.
+     * @return Oldest node, or nullptr if empty or if a producer is still linking it.
+     */
+    SignalDetail::EventNode * pop()
+    {
+        SignalDetail::EventNode * tail = this->tail;
+        SignalDetail::EventNode * next = tail->next.load(std::memory_order_acquire);
+        if(tail == &this->stub)
+        {
+            if(next == nullptr)
+            {
+                return nullptr;
+            }
+            this->tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if(next != nullptr)
+        {
+            this->tail = next;
+            return tail;
+        }
+        if(tail != this->head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        this->push(&this->stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if(next != nullptr)
+        {
+            this->tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+};
+
+namespace SignalDetail {
+
+    /**
+     * @brief Stored in place of a method connected through an @ref Executor.
+     * Calls copy the arguments into an event posted to the executor.
+     * Events only keep a weak reference, so they are dropped once the method is disconnected.
+     * @tparam Method Connected callable.
+     * @tparam Args Signal parameters.
+     */
+    template<typename Method, typename... Args>
+    class QueuedMethod
+    {
+        struct State
+        {
+            Method method;
+        };
+
+        using Event = std::tuple<std::decay_t<Args>...>;
+
+    public:
+        template<typename M>
+        QueuedMethod(Executor & executor, M&& method)
+            : executor(&executor), state(std::make_shared<State>(State{std::forward<M>(method)})) {}
+
+        template<typename... A>
+        void operator()(A&&... args) const
+        {
+            this->executor->post([state = std::weak_ptr<State>(this->state), event = Event(std::forward<A>(args)...)]() mutable {
+                if(std::shared_ptr<State> s = state.lock())
+                {
+                    deliver(s->method, event, std::index_sequence_for<Args...>{});
+                }
+            });
+        }
+
+    private:
+        Executor * executor;
+        std::shared_ptr<State> state;
+
+        /**
+         * @brief Call the method with the event copy: as lvalue for reference parameters, moved otherwise.
+         */
+        template<std::size_t... I>
+        static void deliver(Method & method, Event & event, std::index_sequence<I...>)
+        {
+            std::invoke(method, static_cast<Args&&>(std::get<I>(event))...);
+        }
+    };
+}
+
+#endif //SIGNAL_EXECUTOR_H
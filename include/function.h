@@ -0,0 +1,447 @@
+#ifndef SIGNAL_FUNCTION_H
+#define SIGNAL_FUNCTION_H
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @def SIGNAL_METHOD_CAPACITY
+ * @brief Inline capacity, in bytes, of the callables stored by @ref BasicSignal.
+ * The default makes a stored method exactly 64 bytes. Define it before including signals.h to change it.
+ */
+#ifndef SIGNAL_METHOD_CAPACITY
+#define SIGNAL_METHOD_CAPACITY 48
+#endif
+
+/**
+ * @brief Where @ref BasicFunction puts a callable too large for its buffer.
+ */
+enum class FunctionStorage
+{
+    /**
+     * @brief Never allocate, a callable that doesn't fit is a compile time error.
+     */
+    Inplace,
+    /**
+     * @brief Store small callables inline, allocate the others.
+     */
+    SmallBuffer
+};
+
+template<typename Signature, std::size_t Capacity, FunctionStorage Storage, bool Copyable>
+class BasicFunction;
+
+namespace SignalDetail {
+
+    /**
+     * @brief std::invoke converting the result to R, or discarding it when R is void.
+     */
+    template<typename R, typename F, typename... A>
+    R invokeAs(F&& f, A&&... args)
+    {
+        if constexpr (std::is_void_v<R>)
+        {
+            std::invoke(std::forward<F>(f), std::forward<A>(args)...);
+        }
+        else
+        {
+            return std::invoke(std::forward<F>(f), std::forward<A>(args)...);
+        }
+    }
+}
+
+/**
+ * @brief Type erased callable with an inline buffer, replacement for std::function.
+ *
+ * The call goes through a single function pointer stored in the object.
+ * Trivially copyable callables that fit, such as function pointers or lambdas capturing pointers,
+ * are copied with memcpy and need no destructor call.
+ * Callables that don't fit are allocated from a std::pmr memory resource, the default one unless
+ * given with std::allocator_arg. Copies allocate from the same resource.
+ * @tparam R Return type.
+ * @tparam A Parameters.
+ * @tparam Capacity Size of the inline buffer in bytes.
+ * @tparam Storage What to do with callables bigger than the buffer, see @ref FunctionStorage.
+ * @tparam Copyable false to accept move only callables, the function then can't be copied.
+ */
+template<typename R, typename... A, std::size_t Capacity, FunctionStorage Storage, bool Copyable>
+class BasicFunction<R(A...), Capacity, Storage, Copyable>
+{
+    template<typename, std::size_t, FunctionStorage, bool> friend class BasicFunction;
+
+    using Invoker = R (*)(void *, A&&...);
+
+    /**
+     * @brief Lifetime management of the stored callable. nullptr for trivial ones.
+     */
+    struct Manager
+    {
+        void (*move)(void * dst, void * src) noexcept;
+        void (*copy)(void * dst, const void * src, std::pmr::memory_resource * resource);
+        void (*destroy)(void * storage) noexcept;
+    };
+
+    template<typename F>
+    static constexpr bool fitsInline = sizeof(F) <= Capacity
+                                    && alignof(F) <= alignof(std::max_align_t)
+                                    && std::is_nothrow_move_constructible_v<F>;
+
+    template<typename F>
+    static constexpr bool isTrivial = fitsInline<F>
+                                   && std::is_trivially_copyable_v<F>
+                                   && std::is_trivially_destructible_v<F>;
+
+    /**
+     * @brief Operations on a callable stored inline.
+     */
+    template<typename F>
+    struct Inline
+    {
+        static R invoke(void * storage, A&&... args)
+        {
+            return SignalDetail::invokeAs<R>(*static_cast<F *>(storage), std::forward<A>(args)...);
+        }
+
+        static void move(void * dst, void * src) noexcept
+        {
+            ::new (dst) F(std::move(*static_cast<F *>(src)));
+            static_cast<F *>(src)->~F();
+        }
+
+        static void copy(void * dst, const void * src, std::pmr::memory_resource *)
+        {
+            if constexpr (Copyable)
+            {
+                ::new (dst) F(*static_cast<const F *>(src));
+            }
+        }
+
+        static void destroy(void * storage) noexcept
+        {
+            static_cast<F *>(storage)->~F();
+        }
+
+        static constexpr Manager manager{&move, &copy, &destroy};
+    };
+
+    /**
+     * @brief Operations on a callable stored on the heap, the buffer only holds a pointer.
+     * The block remembers its memory resource so it can be freed from anywhere.
+     */
+    template<typename F>
+    struct Heap
+    {
+        struct Block
+        {
+            std::pmr::memory_resource * resource;
+            F f;
+        };
+
+        static Block *& get(void * storage)
+        {
+            return *static_cast<Block **>(storage);
+        }
+
+        template<typename... C>
+        static void create(void * dst, std::pmr::memory_resource * resource, C&&... from)
+        {
+            std::pmr::polymorphic_allocator<Block> alloc(resource);
+            Block * block = alloc.allocate(1);
+            try
+            {
+                ::new (static_cast<void *>(block)) Block{resource, F(std::forward<C>(from)...)};
+            }
+            catch(...)
+            {
+                alloc.deallocate(block, 1);
+                throw;
+            }
+            ::new (dst) Block *(block);
+        }
+
+        static R invoke(void * storage, A&&... args)
+        {
+            return SignalDetail::invokeAs<R>(get(storage)->f, std::forward<A>(args)...);
+        }
+
+        static void move(void * dst, void * src) noexcept
+        {
+            ::new (dst) Block *(get(src));
+        }
+
+        static void copy(void * dst, const void * src, std::pmr::memory_resource * resource)
+        {
+            if constexpr (Copyable)
+            {
+                create(dst, resource, (*static_cast<Block * const *>(src))->f);
+            }
+        }
+
+        static void destroy(void * storage) noexcept
+        {
+            Block * block = get(storage);
+            std::pmr::polymorphic_allocator<Block> alloc(block->resource);
+            block->~Block();
+            alloc.deallocate(block, 1);
+        }
+
+        static constexpr Manager manager{&move, &copy, &destroy};
+    };
+
+    [[noreturn]] static R invokeEmpty(void *, A&&...)
+    {
+        throw std::bad_function_call();
+    }
+
+public:
+    /**
+     * @brief Makes containers with a std::pmr allocator give it to the functions they hold.
+     */
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    /**
+     * @brief Inline capacity in bytes.
+     */
+    static constexpr std::size_t capacity = Capacity;
+
+    /**
+     * @brief Whether a callable is stored without allocating.
+     * @tparam F Callable type.
+     */
+    template<typename F>
+    static constexpr bool isStoredInline = fitsInline<std::decay_t<F>>;
+
+    /**
+     * @brief Empty function. Calling it throws std::bad_function_call.
+     */
+    BasicFunction() noexcept = default;
+
+    /**
+     * @brief Empty function.
+     */
+    BasicFunction(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief Store a callable.
+     * @param f Callable, invocable with A... and returning something convertible to R.
+     */
+    template<typename F>
+    requires (!std::is_same_v<std::decay_t<F>, BasicFunction>)
+          && std::is_invocable_r_v<R, std::decay_t<F> &, A...>
+          && (!Copyable || std::is_copy_constructible_v<std::decay_t<F>>)
+    BasicFunction(F&& f) : BasicFunction(std::allocator_arg, allocator_type(), std::forward<F>(f)) {}
+
+    /**
+     * @brief Store a callable, allocating it from alloc if it doesn't fit inline.
+     * @param alloc Allocator giving the memory resource.
+     * @param f Callable, invocable with A... and returning something convertible to R.
+     */
+    template<typename F>
+    requires (!std::is_same_v<std::decay_t<F>, BasicFunction>)
+          && std::is_invocable_r_v<R, std::decay_t<F> &, A...>
+          && (!Copyable || std::is_copy_constructible_v<std::decay_t<F>>)
+    BasicFunction(std::allocator_arg_t, const allocator_type & alloc, F&& f)
+    {
+        using Fn = std::decay_t<F>;
+        if constexpr (std::is_pointer_v<Fn> || std::is_member_pointer_v<Fn>)
+        {
+            if(f == nullptr)
+            {
+                return;
+            }
+        }
+        if constexpr (fitsInline<Fn>)
+        {
+            ::new (static_cast<void *>(this->buffer)) Fn(std::forward<F>(f));
+            this->invoker = &Inline<Fn>::invoke;
+            if constexpr (!isTrivial<Fn>)
+            {
+                this->manager = &Inline<Fn>::manager;
+            }
+        }
+        else
+        {
+            static_assert(Storage == FunctionStorage::SmallBuffer,
+                          "Callable doesn't fit in the inline buffer, give a bigger capacity or use FunctionStorage::SmallBuffer");
+            Heap<Fn>::create(this->buffer, alloc.resource(), std::forward<F>(f));
+            this->invoker = &Heap<Fn>::invoke;
+            this->manager = &Heap<Fn>::manager;
+        }
+    }
+
+    /**
+     * @brief Copy the stored callable. Only for copyable functions.
+     * @param other Function to copy.
+     */
+    BasicFunction(const BasicFunction & other) requires Copyable
+    {
+        this->copyFrom(other, std::pmr::get_default_resource());
+    }
+
+    /**
+     * @brief Copy the stored callable, allocating it from alloc if it doesn't fit inline. Only for copyable functions.
+     * @param alloc Allocator giving the memory resource.
+     * @param other Function to copy.
+     */
+    BasicFunction(std::allocator_arg_t, const allocator_type & alloc, const BasicFunction & other) requires Copyable
+    {
+        this->copyFrom(other, alloc.resource());
+    }
+
+    /**
+     * @brief Steal the stored callable.
+     * @param other Function to move, empty afterward.
+     */
+    BasicFunction(BasicFunction && other) noexcept
+    {
+        this->moveFrom(other);
+    }
+
+    /**
+     * @brief Steal the stored callable. A block on the heap keeps the resource it came from.
+     * @param other Function to move, empty afterward.
+     */
+    BasicFunction(std::allocator_arg_t, const allocator_type &, BasicFunction && other) noexcept
+    {
+        this->moveFrom(other);
+    }
+
+    /**
+     * @brief Copy operator. Only for copyable functions.
+     * @param other Function to copy.
+     * @return Itself.
+     */
+    BasicFunction & operator=(const BasicFunction & other) requires Copyable
+    {
+        if(this != &other)
+        {
+            BasicFunction copy(other);
+            this->reset();
+            this->moveFrom(copy);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move operator.
+     * @param other Function to move, empty afterward.
+     * @return Itself.
+     */
+    BasicFunction & operator=(BasicFunction && other) noexcept
+    {
+        if(this != &other)
+        {
+            this->reset();
+            this->moveFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Empty the function.
+     * @return Itself.
+     */
+    BasicFunction & operator=(std::nullptr_t) noexcept
+    {
+        this->reset();
+        return *this;
+    }
+
+    ~BasicFunction()
+    {
+        this->reset();
+    }
+
+    /**
+     * @brief Whether a callable is stored.
+     */
+    explicit operator bool() const noexcept
+    {
+        return this->invoker != &invokeEmpty;
+    }
+
+    /**
+     * @brief Call the stored callable.
+     * @param args Arguments to forward.
+     * @return What the callable returned.
+     */
+    R operator()(A... args) const
+    {
+        return this->invoker(const_cast<unsigned char *>(this->buffer), std::forward<A>(args)...);
+    }
+
+private:
+    /**
+     * @brief Zeroed: trivial callables are copied with the whole buffer, never partly uninitialized.
+     */
+    alignas(std::max_align_t) unsigned char buffer[Capacity]{};
+    Invoker invoker = &invokeEmpty;
+    const Manager * manager = nullptr;
+
+    void reset() noexcept
+    {
+        if(this->manager != nullptr)
+        {
+            this->manager->destroy(this->buffer);
+        }
+        this->invoker = &invokeEmpty;
+        this->manager = nullptr;
+    }
+
+    void moveFrom(BasicFunction & other) noexcept
+    {
+        if(other.manager != nullptr)
+        {
+            other.manager->move(this->buffer, other.buffer);
+        }
+        else
+        {
+            std::memcpy(this->buffer, other.buffer, Capacity);
+        }
+        this->invoker = other.invoker;
+        this->manager = other.manager;
+        other.invoker = &invokeEmpty;
+        other.manager = nullptr;
+    }
+
+    void copyFrom(const BasicFunction & other, std::pmr::memory_resource * resource)
+    {
+        if(other.manager != nullptr)
+        {
+            other.manager->copy(this->buffer, other.buffer, resource);
+        }
+        else
+        {
+            std::memcpy(this->buffer, other.buffer, Capacity);
+        }
+        this->invoker = other.invoker;
+        this->manager = other.manager;
+    }
+};
+
+/**
+ * @brief Copyable function that never allocates. Callables bigger than Capacity don't compile.
+ */
+template<typename Signature, std::size_t Capacity = SIGNAL_METHOD_CAPACITY>
+using InplaceFunction = BasicFunction<Signature, Capacity, FunctionStorage::Inplace, true>;
+
+/**
+ * @brief Copyable function storing callables up to Capacity bytes inline, allocating bigger ones.
+ */
+template<typename Signature, std::size_t Capacity = SIGNAL_METHOD_CAPACITY>
+using SmallFunction = BasicFunction<Signature, Capacity, FunctionStorage::SmallBuffer, true>;
+
+/**
+ * @brief Move only function storing callables up to Capacity bytes inline, allocating bigger ones.
+ * Accepts callables that can't be copied.
+ */
+template<typename Signature, std::size_t Capacity = SIGNAL_METHOD_CAPACITY>
+using MoveOnlyFunction = BasicFunction<Signature, Capacity, FunctionStorage::SmallBuffer, false>;
+
+#endif //SIGNAL_FUNCTION_H
@@ -0,0 +1,390 @@
+#ifndef SIGNAL_INSTRUMENTATION_H
+#define SIGNAL_INSTRUMENTATION_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dispatch.h"
+#include "slot_table.h"
+
+namespace SignalPolicy {
+
+    /**
+     * @brief Policy adding counters and latency histograms to another one, see @ref SignalStats.
+     * Other policies pay nothing for it: no counter, no clock read.
+     * @tparam Policy One of @ref SignalPolicy, the synchronization used.
+     *
+     * @code{.cpp}
+     * Signal<SignalPolicy::Instrumented<SignalPolicy::LockFree>, int> ticks("ticks");
+     * @endcode
+     */
+    template<typename Policy>
+    struct Instrumented
+    {
+        template<typename List>
+        using Storage = typename Policy::template Storage<List>;
+    };
+
+    /**
+     * @brief Policy letting a @ref SignalRecorder log every emit of the signal, with its arguments.
+     * Until a recorder is attached, an emit pays one atomic load for it; other policies pay nothing.
+     * Wrap @ref SignalPolicy::Instrumented with it to have both.
+     * @tparam Policy One of @ref SignalPolicy, the synchronization used.
+     *
+     * @code{.cpp}
+     * Signal<SignalPolicy::Recorded<SignalPolicy::Mutex>, Order> orders;
+     * @endcode
+     */
+    template<typename Policy>
+    struct Recorded
+    {
+        template<typename List>
+        using Storage = typename Policy::template Storage<List>;
+    };
+}
+
+/**
+ * @brief Counters of one connected method, shared by every copy of the slot list.
+ */
+struct SlotStats
+{
+    /**
+     * @brief Latency buckets: bucket k counts calls of [2^(k-1), 2^k) ns, the last one everything slower.
+     */
+    static constexpr std::size_t bucketCount = 32;
+
+    SignalDetail::idType id = 0;
+    std::atomic<std::uint64_t> calls{0};
+    /**
+     * @brief Cumulative time spent in the method.
+     */
+    std::atomic<std::uint64_t> nanoseconds{0};
+    std::array<std::atomic<std::uint64_t>, bucketCount> histogram{};
+
+    /**
+     * @brief Count one call. Relaxed: counters are only read for reporting.
+     * @param ns Duration of the call.
+     */
+    void record(const std::uint64_t ns)
+    {
+        this->calls.fetch_add(1, std::memory_order_relaxed);
+        this->nanoseconds.fetch_add(ns, std::memory_order_relaxed);
+        const std::size_t bucket = std::min<std::size_t>(std::bit_width(ns), bucketCount - 1);
+        this->histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief What @ref SignalStats::report() read, plain values to export.
+ */
+struct SignalReport
+{
+    struct Slot
+    {
+        SignalDetail::idType id;
+        std::uint64_t calls;
+        std::uint64_t nanoseconds;
+        std::array<std::uint64_t, SlotStats::bucketCount> histogram;
+    };
+
+    std::uint64_t emits;
+    /**
+     * @brief One entry per connected method, in connection order.
+     */
+    std::vector<Slot> slots;
+};
+
+/**
+ * @brief Counters of an instrumented signal, see @ref SignalPolicy::Instrumented.
+ *
+ * Counts emits, and for each method its calls, cumulative time and a log2 latency histogram.
+ * Methods are timed around their call, so every kind of emit is covered; a batch counts as one call.
+ * Counters are relaxed atomics: cheap, but threads emitting the same signal share their cache lines.
+ * Named signals are listed by @ref SignalRegistry.
+ */
+class SignalStats
+{
+public:
+    SignalStats() = default;
+    SignalStats(const SignalStats &) = delete;
+    SignalStats & operator=(const SignalStats &) = delete;
+
+    /**
+     * @brief Leave the registry.
+     */
+    ~SignalStats();
+
+    /**
+     * @brief Count emits.
+     * @param events Number of events emitted at once.
+     */
+    void onEmit(const std::size_t events = 1)
+    {
+        this->emits.fetch_add(events, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Report the counters of a new method, as long as any copy of the method lives.
+     * @param slot Counters given to the timed method, id already set.
+     */
+    void addSlot(const std::shared_ptr<SlotStats> & slot)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        std::erase_if(this->slots, [](const std::weak_ptr<SlotStats> & s) { return s.expired(); });
+        this->slots.push_back(slot);
+    }
+
+    /**
+     * @brief Read the counters. Methods just disconnected may still appear while an emit holds them.
+     * @return Values at the time of the call.
+     */
+    SignalReport report() const
+    {
+        SignalReport report{this->emits.load(std::memory_order_relaxed), {}};
+        std::lock_guard<std::mutex> lock(this->mtx);
+        for(const std::weak_ptr<SlotStats> & weak: this->slots)
+        {
+            if(std::shared_ptr<SlotStats> slot = weak.lock())
+            {
+                SignalReport::Slot & r = report.slots.emplace_back();
+                r.id = slot->id;
+                r.calls = slot->calls.load(std::memory_order_relaxed);
+                r.nanoseconds = slot->nanoseconds.load(std::memory_order_relaxed);
+                for(std::size_t k = 0; k < SlotStats::bucketCount; ++k)
+                {
+                    r.histogram[k] = slot->histogram[k].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        return report;
+    }
+
+    /**
+     * @brief Make the signal visible in @ref SignalRegistry under a name.
+     * @param name Name, copied. Several signals may share it.
+     */
+    void publish(std::string_view name);
+
+private:
+    alignas(64) std::atomic<std::uint64_t> emits{0};
+    /**
+     * @brief mtx Protects slots, never taken by emit.
+     */
+    mutable std::mutex mtx;
+    std::vector<std::weak_ptr<SlotStats>> slots;
+    bool published = false;
+};
+
+/**
+ * @brief Named instrumented signals of the program, for export to a metrics agent.
+ * Signals declared with @ref public_signal or @ref protected_signal register under their name.
+ *
+ * @code{.cpp}
+ * SignalRegistry::instance().forEach([](std::string_view name, const SignalReport & report) {
+ *     agent.gauge(name, report.emits);
+ * });
+ * @endcode
+ */
+class SignalRegistry
+{
+public:
+    /**
+     * @brief The registry, shared by the whole program.
+     * @return The registry.
+     */
+    static SignalRegistry & instance()
+    {
+        static SignalRegistry registry;
+        return registry;
+    }
+
+    SignalRegistry(const SignalRegistry &) = delete;
+    SignalRegistry & operator=(const SignalRegistry &) = delete;
+
+    /**
+     * @brief Report every registered signal. Signals can't be destroyed meanwhile.
+     * @param visitor Callable taking (std::string_view name, const SignalReport & report).
+     */
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        for(const Entry & entry: this->entries)
+        {
+            visitor(std::string_view(entry.name), entry.stats->report());
+        }
+    }
+
+    /**
+     * @brief Number of registered signals.
+     * @return Signals count.
+     */
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->entries.size();
+    }
+
+private:
+    friend class SignalStats;
+
+    struct Entry
+    {
+        std::string name;
+        const SignalStats * stats;
+    };
+
+    SignalRegistry() = default;
+
+    mutable std::mutex mtx;
+    std::vector<Entry> entries;
+
+    void add(const std::string_view name, const SignalStats * stats)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->entries.push_back(Entry{std::string(name), stats});
+    }
+
+    void remove(const SignalStats * stats)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        std::erase_if(this->entries, [stats](const Entry & entry) { return entry.stats == stats; });
+    }
+};
+
+inline SignalStats::~SignalStats()
+{
+    if(this->published)
+    {
+        SignalRegistry::instance().remove(this);
+    }
+}
+
+inline void SignalStats::publish(const std::string_view name)
+{
+    if(!this->published)
+    {
+        this->published = true;
+        SignalRegistry::instance().add(name, this);
+    }
+}
+
+namespace SignalDetail {
+
+    /**
+     * @brief Counters of a signal that is not instrumented: nothing, compiled away.
+     */
+    struct NoStats
+    {
+        void onEmit(std::size_t = 1) {}
+        void publish(std::string_view) {}
+    };
+
+    /**
+     * @brief Counters of a signal using Policy.
+     */
+    template<typename Policy>
+    struct StatsOf
+    {
+        using type = NoStats;
+    };
+
+    template<typename Policy>
+    struct StatsOf<SignalPolicy::Instrumented<Policy>>
+    {
+        using type = SignalStats;
+    };
+
+    template<typename Policy, typename R>
+    struct StatsOf<Returning<Policy, R>> : StatsOf<Policy> {};
+
+    /**
+     * @brief Where a recorded signal sends its emits, see @ref SignalRecorder.
+     * Given the argument pointers of the emit, like stored methods.
+     */
+    struct RecordTap
+    {
+        void (*write)(const RecordTap & tap, void * const * argv);
+        /**
+         * @brief Called once the signal stops using the tap without the recorder asking: destroyed, or taken by another recorder.
+         */
+        void (*forget)(const RecordTap & tap);
+    };
+
+    /**
+     * @brief Counters of a recorded signal: those of the wrapped policy, and the recorder attached if any.
+     * @tparam Base Counters of the wrapped policy.
+     */
+    template<typename Base>
+    struct Recording : Base
+    {
+        std::atomic<const RecordTap *> tap{nullptr};
+
+        Recording() = default;
+        Recording(const Recording &) = delete;
+        Recording & operator=(const Recording &) = delete;
+
+        /**
+         * @brief A signal destroyed first leaves its recorder, which would otherwise detach it later.
+         */
+        ~Recording()
+        {
+            if(const RecordTap * current = this->tap.exchange(nullptr, std::memory_order_acq_rel))
+            {
+                current->forget(*current);
+            }
+        }
+
+        void record(void * const * argv) const
+        {
+            if(const RecordTap * current = this->tap.load(std::memory_order_acquire))
+            {
+                current->write(*current, argv);
+            }
+        }
+    };
+
+    template<typename Policy>
+    struct StatsOf<SignalPolicy::Recorded<Policy>>
+    {
+        using type = Recording<typename StatsOf<Policy>::type>;
+    };
+
+    /**
+     * @brief Whether counters can record emits, see @ref SignalPolicy::Recorded.
+     */
+    template<typename Stats>
+    inline constexpr bool isRecording = requires(const Stats & stats, void * const * argv) { stats.record(argv); };
+
+    /**
+     * @brief Wraps the adapter of a method of an instrumented signal to time its calls.
+     * @tparam Adapter Adapter of the method, see @ref BasicSignal::addMethod().
+     */
+    template<typename Adapter>
+    struct Timed
+    {
+        Adapter adapter;
+        std::shared_ptr<SlotStats> stats;
+
+        void operator()(const Pass pass, void * const * argv)
+        {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            this->adapter(pass, argv);
+            const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+            this->stats->record(static_cast<std::uint64_t>(elapsed.count()));
+        }
+    };
+}
+
+#endif //SIGNAL_INSTRUMENTATION_H
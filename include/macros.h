@@ -6,36 +6,46 @@
  * @brief Project all connect function from signal.
  * Projected functions will be named : connect_<name>
  * @param name Name of an existing signal.
- * @param ... Parameter pack of the signal.
+ * @param ... Parameter pack of the signal, optionally starting with a @ref SignalPolicy.
  */
 #define SIGNAL_CONNECT_FORWARD(name, ...) \
     template<typename Method> \
-    inline Connection<__VA_ARGS__> connect_##name(Method&& method) { \
+    inline auto connect_##name(Method&& method) { \
         return name.connect(std::forward<Method>(method)); \
     } \
  \
     template<typename T, typename Method> \
-    inline Connection<__VA_ARGS__> connect_##name(T* instance, Method&& method) { \
+    inline auto connect_##name(T* instance, Method&& method) { \
         return name.connect(instance, std::forward<Method>(method)); \
     } \
+ \
+    template<auto Method, typename T> \
+    inline auto connect_##name(T* instance) { \
+        return name.template connect<Method>(instance); \
+    } \
  \
     template<typename T, typename Method> \
-    inline Connection<__VA_ARGS__> connect_##name(std::shared_ptr<T>& instance, Method&& method) { \
+    inline auto connect_##name(std::shared_ptr<T>& instance, Method&& method) { \
         return name.connect(instance, std::forward<Method>(method)); \
     } \
+ \
+    template<typename... ConnectArgs> \
+    inline auto connect_##name(Executor& executor, ConnectArgs&&... connectArgs) { \
+        return name.connect(executor, std::forward<ConnectArgs>(connectArgs)...); \
+    } \
  \
     template<typename Method, typename... BoundArgs> \
-    inline Connection<__VA_ARGS__> connect_##name(Method&& method, BoundArgs&&... boundArgs) { \
+    inline auto connect_##name(Method&& method, BoundArgs&&... boundArgs) { \
         return name.connect(std::forward<Method>(method), std::forward<BoundArgs>(boundArgs)...); \
 } \
  \
     template<typename T, typename Method, typename... BoundArgs> \
-    inline Connection<__VA_ARGS__> connect_##name(T* instance, Method&& method, BoundArgs&&... boundArgs) { \
+    inline auto connect_##name(T* instance, Method&& method, BoundArgs&&... boundArgs) { \
         return name.connect(instance, std::forward<Method>(method), std::forward<BoundArgs>(boundArgs)...); \
 } \
  \
     template<typename T, typename Method, typename... BoundArgs> \
-    inline Connection<__VA_ARGS__> connect_##name(std::shared_ptr<T>& instance, Method&& method, BoundArgs&&... boundArgs) { \
+    inline auto connect_##name(std::shared_ptr<T>& instance, Method&& method, BoundArgs&&... boundArgs) { \
         return name.connect(instance, std::forward<Method>(method), std::forward<BoundArgs>(boundArgs)...); \
 }
 
@@ -43,6 +53,7 @@
  * @def public_signal
  * @brief Define a new signal as private and forward all connect functions as public.
  * Projected functions will be named : connect_<name>
+ * An instrumented signal registers in @ref SignalRegistry under name.
  * @param name Name that will be given to the signal
  * @param ... Parameter pack of the signal.
  */
@@ -50,12 +61,13 @@
 public: \
     SIGNAL_CONNECT_FORWARD(name, __VA_ARGS__) \
 private: \
-    Signal<__VA_ARGS__> name;
+    Signal<__VA_ARGS__> name{#name};
 
 /**
  * @def public_signal
  * @brief Define a new signal as private and forward all connect functions as protected.
  * Projected functions will be named : connect_<name>
+ * An instrumented signal registers in @ref SignalRegistry under name.
  * @param name Name that will be given to the signal
  * @param ... Parameter pack of the signal.
  */
@@ -63,6 +75,60 @@ private: \
 protected: \
     SIGNAL_CONNECT_FORWARD(name, __VA_ARGS__) \
 private: \
-    Signal<__VA_ARGS__> name;
+    Signal<__VA_ARGS__> name{#name};
+
+/**
+ * @def SIGNAL_BUS_CONNECT_FORWARD
+ * @brief Project the connect functions of an @ref EventBus.
+ * Projected functions will be named : connect_<name><Event>(...) and connectAll_<name>(...)
+ * @param name Name of an existing bus.
+ */
+#define SIGNAL_BUS_CONNECT_FORWARD(name) \
+    template<typename Event, typename... ConnectArgs> \
+    inline auto connect_##name(ConnectArgs&&... connectArgs) { \
+        return name.template connect<Event>(std::forward<ConnectArgs>(connectArgs)...); \
+    } \
+ \
+    template<typename... ConnectArgs> \
+    inline auto connectAll_##name(ConnectArgs&&... connectArgs) { \
+        return name.connectAll(std::forward<ConnectArgs>(connectArgs)...); \
+    }
+
+/**
+ * @def public_bus
+ * @brief Define a new @ref EventBus as private and forward its connect functions as public.
+ * Projected functions will be named : connect_<name><Event>(...) and connectAll_<name>(...)
+ * @param name Name that will be given to the bus
+ * @param ... Events of the bus, optionally starting with a @ref SignalPolicy.
+ */
+#define public_bus(name, ...) \
+public: \
+    SIGNAL_BUS_CONNECT_FORWARD(name) \
+private: \
+    EventBus<__VA_ARGS__> name;
+
+/**
+ * @def protected_bus
+ * @brief Define a new @ref EventBus as private and forward its connect functions as protected.
+ * Projected functions will be named : connect_<name><Event>(...) and connectAll_<name>(...)
+ * @param name Name that will be given to the bus
+ * @param ... Events of the bus, optionally starting with a @ref SignalPolicy.
+ */
+#define protected_bus(name, ...) \
+protected: \
+    SIGNAL_BUS_CONNECT_FORWARD(name) \
+private: \
+    EventBus<__VA_ARGS__> name;
+
+/**
+ * @def static_signal
+ * @brief Define a new @ref StaticSignal as private: its methods are fixed, so there is nothing to forward.
+ * Emit it with name.emit(...)
+ * @param name Name that will be given to the signal
+ * @param ... Signature of the signal, then its methods, e.g. void(int), &log, &store.
+ */
+#define static_signal(name, ...) \
+private: \
+    static constexpr StaticSignal<__VA_ARGS__> name{};
 
 #endif //SIGNAL_MACROS_H
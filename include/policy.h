@@ -0,0 +1,482 @@
+#ifndef SIGNAL_POLICY_H
+#define SIGNAL_POLICY_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "epoch.h"
+#include "function.h"
+
+/**
+ * @brief Synchronization policies of @ref Signal. Give one as first template parameter, e.g. Signal<SignalPolicy::LockFree, int>.
+ *
+ * A policy provides a Storage<List> class template holding the published slot list with:
+ * - a constructor taking the std::pmr::memory_resource lists are allocated from.
+ * - read(): a snapshot usable like a pointer to const List, kept valid while alive.
+ * - mutate(mutation): apply mutation(List&) and publish the result.
+ * - mutate(prepare, mutation): call prepare(List&) right away and return its result, then apply mutation(List&, result).
+ *   prepare may run on a list being visited, so it can only touch what visitors don't hold.
+ *
+ * Mutations must own what they capture: a policy may apply them after mutate() returned.
+ *
+ * With the snapshots of Mutex and SharedMutex, a method may destroy the signal calling it, or its owner:
+ * the emit finishes on its snapshot and no longer touches the signal. SingleThreaded and LockFree emits
+ * visit lists destroyed with the signal, so their methods must not. Neither may those of @ref BasicSignal::emitParallel().
+ */
+namespace SignalPolicy {
+
+    /**
+     * @brief No synchronization at all, for signals used by a single thread.
+     *
+     * Emit visits the live list: no lock, no atomic, no reference count, and changes never copy it.
+     * Changes made while an emit runs, from a method for example, are queued and applied in order
+     * once the outermost emit returns, so that emit still calls exactly the methods it started with.
+     * Connecting from a method still gets its id right away.
+     * Methods run by @ref BasicSignal::emitParallel() must not change the signal.
+     */
+    struct SingleThreaded
+    {
+        template<typename List>
+        class Storage
+        {
+        public:
+            /**
+             * @brief Read section over the live list. Changes wait for the outermost one to end.
+             */
+            class Snapshot
+            {
+            public:
+                explicit Snapshot(Storage & storage) : storage(&storage)
+                {
+                    ++storage.depth;
+                }
+
+                Snapshot(const Snapshot &) = delete;
+                Snapshot & operator=(const Snapshot &) = delete;
+
+                ~Snapshot()
+                {
+                    if(--this->storage->depth == 0 && !this->storage->pending.empty())
+                    {
+                        this->storage->flush();
+                    }
+                }
+
+                explicit operator bool() const { return true; }
+                const List & operator*() const { return this->storage->list; }
+                const List * operator->() const { return &this->storage->list; }
+
+            private:
+                Storage * storage;
+            };
+
+            /**
+             * @brief Changes made during an emit are already queued here, see @ref BasicSignal::mutate().
+             */
+            static constexpr bool defersChanges = true;
+
+            /**
+             * @param resource Where the list and the queued changes are allocated.
+             */
+            explicit Storage(std::pmr::memory_resource * resource = std::pmr::get_default_resource())
+                : list(std::pmr::polymorphic_allocator<>(resource)), pending(resource) {}
+            Storage(const Storage &) = delete;
+            Storage & operator=(const Storage &) = delete;
+
+            /**
+             * @brief Enter a read section over the list.
+             * @return Snapshot of the list, never empty.
+             */
+            Snapshot read()
+            {
+                return Snapshot(*this);
+            }
+
+            /**
+             * @brief Change the list in place, or queue the change if a read section is running.
+             * @param mutation Callable taking a List& to modify.
+             */
+            template<typename Mutation>
+            void mutate(Mutation&& mutation)
+            {
+                if(this->depth != 0)
+                {
+                    this->pending.emplace_back(std::forward<Mutation>(mutation));
+                    return;
+                }
+                //Methods destroyed by the change may change the list too: they queue behind it.
+                Snapshot section(*this);
+                mutation(this->list);
+            }
+
+            /**
+             * @brief Call prepare on the live list now, apply mutation now or once the read sections end.
+             * @param prepare Callable taking a List&, its result is returned.
+             * @param mutation Callable taking a List& and the result of prepare.
+             * @return Result of prepare.
+             */
+            template<typename Prepare, typename Mutation>
+            auto mutate(Prepare&& prepare, Mutation&& mutation)
+            {
+                auto prepared = prepare(this->list);
+                if(this->depth != 0)
+                {
+                    this->pending.emplace_back([mutation = std::forward<Mutation>(mutation), prepared](List & list) mutable {
+                        mutation(list, prepared);
+                    });
+                    return prepared;
+                }
+                Snapshot section(*this);
+                mutation(this->list, prepared);
+                return prepared;
+            }
+
+        private:
+            List list;
+            /**
+             * @brief Number of read sections running, nested emits included.
+             */
+            std::size_t depth = 0;
+            /**
+             * @brief Changes made during a read section, in order.
+             */
+            std::pmr::vector<MoveOnlyFunction<void(List &)>> pending;
+
+            /**
+             * @brief Apply the queued changes, and those they queue in turn.
+             */
+            void flush()
+            {
+                ++this->depth;
+                try
+                {
+                    for(std::size_t k = 0; k < this->pending.size(); ++k)
+                    {
+                        //Moved out first: applying it may queue more and grow the vector.
+                        MoveOnlyFunction<void(List &)> mutation = std::move(this->pending[k]);
+                        mutation(this->list);
+                    }
+                }
+                catch(...)
+                {
+                    this->pending.clear();
+                    --this->depth;
+                    throw;
+                }
+                this->pending.clear();
+                --this->depth;
+            }
+        };
+    };
+
+    /**
+     * @brief Default policy. Writers serialize on a mutex, emit atomically loads a reference counted snapshot.
+     */
+    struct Mutex
+    {
+        template<typename List>
+        class Storage
+        {
+        public:
+            /**
+             * @brief Snapshot shares ownership of the list it was read from.
+             */
+            using Snapshot = std::shared_ptr<const List>;
+
+            /**
+             * @param resource Where lists and their reference counts are allocated.
+             */
+            explicit Storage(std::pmr::memory_resource * resource = std::pmr::get_default_resource()) : alloc(resource) {}
+
+            /**
+             * @brief Get the current list. Never locks the mutex.
+             * @return Snapshot of the current list, might be empty.
+             */
+            Snapshot read() const
+            {
+                return this->current.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Copy the current list, apply a change to the copy and publish it.
+             * @param mutation Callable taking a List& to modify.
+             */
+            template<typename Mutation>
+            void mutate(Mutation&& mutation)
+            {
+                Snapshot old;
+                {
+                    std::lock_guard<std::mutex> lock(this->mtx);
+                    old = this->current.load(std::memory_order_relaxed);
+                    auto next = old ? std::allocate_shared<List>(this->alloc, *old) : std::allocate_shared<List>(this->alloc);
+                    mutation(*next);
+                    this->current.store(std::move(next), std::memory_order_release);
+                }
+                //Unlocked: destroying old methods may disconnect from this signal.
+            }
+
+            /**
+             * @brief Apply both steps of a change on the same copy, see @ref SignalPolicy.
+             * @param prepare Callable taking a List&, its result is returned.
+             * @param mutation Callable taking a List& and the result of prepare.
+             * @return Result of prepare.
+             */
+            template<typename Prepare, typename Mutation>
+            auto mutate(Prepare&& prepare, Mutation&& mutation)
+            {
+                decltype(prepare(std::declval<List &>())) prepared{};
+                this->mutate([&](List & list) {
+                    prepared = prepare(list);
+                    mutation(list, prepared);
+                });
+                return prepared;
+            }
+
+        private:
+            /**
+             * @brief mtx Serialize writers.
+             */
+            std::mutex mtx;
+            /**
+             * @brief Published list.
+             */
+            std::atomic<std::shared_ptr<const List>> current;
+            std::pmr::polymorphic_allocator<List> alloc;
+        };
+    };
+
+    /**
+     * @brief Like @ref SignalPolicy::Mutex, with the published list behind a std::shared_mutex.
+     * Emitters only share the lock to copy the snapshot, writers prepare the new list under
+     * their own mutex and hold the exclusive lock just to swap it.
+     */
+    struct SharedMutex
+    {
+        template<typename List>
+        class Storage
+        {
+        public:
+            /**
+             * @brief Snapshot shares ownership of the list it was read from.
+             */
+            using Snapshot = std::shared_ptr<const List>;
+
+            /**
+             * @param resource Where lists and their reference counts are allocated.
+             */
+            explicit Storage(std::pmr::memory_resource * resource = std::pmr::get_default_resource()) : alloc(resource) {}
+
+            /**
+             * @brief Get the current list under a shared lock.
+             * @return Snapshot of the current list, might be empty.
+             */
+            Snapshot read() const
+            {
+                std::shared_lock<std::shared_mutex> lock(this->listMtx);
+                return this->current;
+            }
+
+            /**
+             * @brief Copy the current list, apply a change to the copy and publish it.
+             * @param mutation Callable taking a List& to modify.
+             */
+            template<typename Mutation>
+            void mutate(Mutation&& mutation)
+            {
+                Snapshot old;
+                {
+                    std::lock_guard<std::mutex> lock(this->writeMtx);
+                    //Only this writer replaces current, reading it needs no lock.
+                    auto next = this->current ? std::allocate_shared<List>(this->alloc, *this->current)
+                                              : std::allocate_shared<List>(this->alloc);
+                    mutation(*next);
+                    std::unique_lock<std::shared_mutex> publish(this->listMtx);
+                    old = std::exchange(this->current, std::move(next));
+                }
+                //Unlocked: destroying old methods may disconnect from this signal.
+            }
+
+            /**
+             * @brief Apply both steps of a change on the same copy, see @ref SignalPolicy.
+             * @param prepare Callable taking a List&, its result is returned.
+             * @param mutation Callable taking a List& and the result of prepare.
+             * @return Result of prepare.
+             */
+            template<typename Prepare, typename Mutation>
+            auto mutate(Prepare&& prepare, Mutation&& mutation)
+            {
+                decltype(prepare(std::declval<List &>())) prepared{};
+                this->mutate([&](List & list) {
+                    prepared = prepare(list);
+                    mutation(list, prepared);
+                });
+                return prepared;
+            }
+
+        private:
+            /**
+             * @brief writeMtx Serialize writers.
+             */
+            std::mutex writeMtx;
+            /**
+             * @brief listMtx Protects current, exclusive only while swapping it.
+             */
+            mutable std::shared_mutex listMtx;
+            /**
+             * @brief Published list.
+             */
+            Snapshot current;
+            std::pmr::polymorphic_allocator<List> alloc;
+        };
+    };
+
+    /**
+     * @brief Emit never blocks nor touches a shared reference count: the list is a plain atomic pointer
+     * protected by @ref SignalDetail::EpochDomain. Writers still serialize on a mutex.
+     * Emitters only write to a record of their own thread, and skip the fence on Linux: writers pay it, see @ref SignalDetail::EpochDomain.
+     * Best when several threads emit the same signal, much more often than it changes.
+     */
+    struct LockFree
+    {
+        template<typename List>
+        class Storage
+        {
+        public:
+            /**
+             * @brief Read section over the list it was read from.
+             */
+            class Snapshot
+            {
+            public:
+                explicit Snapshot(const std::atomic<List *> & current) : list(current.load(std::memory_order_seq_cst)) {}
+
+                explicit operator bool() const { return this->list != nullptr; }
+                const List & operator*() const { return *this->list; }
+                const List * operator->() const { return this->list; }
+
+            private:
+                /**
+                 * @brief Must be built before list is loaded.
+                 */
+                SignalDetail::EpochDomain::Guard guard;
+                const List * list;
+            };
+
+            /**
+             * @param resource Where lists are allocated.
+             */
+            explicit Storage(std::pmr::memory_resource * resource = std::pmr::get_default_resource()) : alloc(resource) {}
+            Storage(const Storage &) = delete;
+            Storage & operator=(const Storage &) = delete;
+
+            /**
+             * @brief Destroy the lists, old ones included: nothing emits a signal being destroyed.
+             */
+            ~Storage()
+            {
+                SignalDetail::EpochDomain::instance().reclaim(this);
+                if(List * list = this->current.load(std::memory_order_relaxed))
+                {
+                    this->alloc.delete_object(list);
+                }
+            }
+
+            /**
+             * @brief Get the current list. Wait-free apart from the first call of a thread.
+             * @return Snapshot of the current list, might be empty.
+             */
+            Snapshot read() const
+            {
+                return Snapshot(this->current);
+            }
+
+            /**
+             * @brief Copy the current list, apply a change to the copy and publish it.
+             * The old list is destroyed once no emit uses it anymore.
+             * @param mutation Callable taking a List& to modify.
+             */
+            template<typename Mutation>
+            void mutate(Mutation&& mutation)
+            {
+                List * old;
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    List * current = this->current.load(std::memory_order_relaxed);
+                    List * next = current ? this->alloc.template new_object<List>(*current) : this->alloc.template new_object<List>();
+                    try
+                    {
+                        mutation(*next);
+                    }
+                    catch(...)
+                    {
+                        this->alloc.delete_object(next);
+                        throw;
+                    }
+                    old = this->current.exchange(next, std::memory_order_seq_cst);
+                }
+                //Unlocked: destroying old methods may disconnect from this signal.
+                SignalDetail::EpochDomain::instance().retire(old, [](void * p) {
+                    List * list = static_cast<List *>(p);
+                    std::pmr::polymorphic_allocator<List>(list->get_allocator().resource()).delete_object(list);
+                }, this);
+            }
+
+            /**
+             * @brief Apply both steps of a change on the same copy, see @ref SignalPolicy.
+             * @param prepare Callable taking a List&, its result is returned.
+             * @param mutation Callable taking a List& and the result of prepare.
+             * @return Result of prepare.
+             */
+            template<typename Prepare, typename Mutation>
+            auto mutate(Prepare&& prepare, Mutation&& mutation)
+            {
+                decltype(prepare(std::declval<List &>())) prepared{};
+                this->mutate([&](List & list) {
+                    prepared = prepare(list);
+                    mutation(list, prepared);
+                });
+                return prepared;
+            }
+
+        private:
+            /**
+             * @brief mtx Serialize writers.
+             */
+            std::mutex mtx;
+            /**
+             * @brief Published list.
+             */
+            std::atomic<List *> current{nullptr};
+            std::pmr::polymorphic_allocator<List> alloc;
+        };
+    };
+}
+
+namespace SignalDetail {
+
+    /**
+     * @brief Whether a policy storage queues the changes made during an emit itself, see @ref SignalPolicy::SingleThreaded.
+     */
+    template<typename Storage>
+    inline constexpr bool defersChanges = requires { requires Storage::defersChanges; };
+}
+
+namespace SignalConcepts {
+
+    /**
+     * @brief Verify that a type is a synchronization policy, see @ref SignalPolicy.
+     * @tparam Policy Type to verify.
+     */
+    template<typename Policy>
+    concept SyncPolicy = requires {
+        typename Policy::template Storage<int>;
+    };
+}
+
+#endif //SIGNAL_POLICY_H
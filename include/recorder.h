@@ -0,0 +1,706 @@
+#ifndef SIGNAL_RECORDER_H
+#define SIGNAL_RECORDER_H
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "signals.h"
+#include "wire.h"
+
+namespace SignalDetail {
+
+    inline constexpr std::uint64_t recordMagic = 0x5349475245433031;
+
+    /**
+     * @brief Start of a log file, followed by records up to tail.
+     * Record: u32 size of the whole record, u8 kind, varint channel, u64 nanoseconds since start, then
+     * the channel name or the encoded arguments of the emit, see @ref SignalWire.
+     */
+    struct RecordHeader
+    {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t capacity;
+        /**
+         * @brief wallStart System clock at start, in nanoseconds since epoch, to date the records.
+         */
+        std::int64_t wallStart;
+        /**
+         * @brief tail End of the last reserved record, never beyond capacity.
+         */
+        std::atomic<std::uint64_t> tail;
+        std::atomic<std::uint64_t> dropped;
+    };
+
+    enum class RecordKind : std::uint8_t
+    {
+        Channel = 0,
+        Event = 1
+    };
+
+    /**
+     * @brief File mapped in memory, unmapped and closed on destruction.
+     */
+    class RecordFile
+    {
+    public:
+        /**
+         * @brief Create or truncate the file and map size bytes of it.
+         * @throw std::system_error If the file can't be created or mapped.
+         */
+        static RecordFile create(const std::string & path, const std::size_t size)
+        {
+            const int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+            if(fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "open " + path);
+            }
+            if(ftruncate(fd, static_cast<off_t>(size)) != 0)
+            {
+                const int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "ftruncate " + path);
+            }
+            return RecordFile(fd, size, PROT_READ | PROT_WRITE, path);
+        }
+
+        /**
+         * @brief Map a whole file, read only.
+         * @throw std::system_error If the file doesn't exist or is too short for a header.
+         */
+        static RecordFile open(const std::string & path)
+        {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if(fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "open " + path);
+            }
+            struct stat info{};
+            if(fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(RecordHeader)))
+            {
+                close(fd);
+                throw std::system_error(EPROTO, std::generic_category(), "open " + path);
+            }
+            return RecordFile(fd, static_cast<std::size_t>(info.st_size), PROT_READ, path);
+        }
+
+        RecordFile(RecordFile && other) noexcept
+            : fd(std::exchange(other.fd, -1)), memory(std::exchange(other.memory, nullptr)), size(other.size) {}
+
+        RecordFile(const RecordFile &) = delete;
+        RecordFile & operator=(const RecordFile &) = delete;
+        RecordFile & operator=(RecordFile &&) = delete;
+
+        ~RecordFile()
+        {
+            if(this->memory)
+            {
+                munmap(this->memory, this->size);
+            }
+            if(this->fd >= 0)
+            {
+                close(this->fd);
+            }
+        }
+
+        /**
+         * @brief Unmap, then cut the file to its used part.
+         */
+        void shrink(const std::size_t used)
+        {
+            munmap(this->memory, this->size);
+            this->memory = nullptr;
+            if(ftruncate(this->fd, static_cast<off_t>(used)) != 0)
+            {
+                //The log stays whole, only longer than needed.
+            }
+        }
+
+        std::byte * data() const
+        {
+            return static_cast<std::byte *>(this->memory);
+        }
+
+        std::size_t bytes() const
+        {
+            return this->size;
+        }
+
+    private:
+        int fd;
+        void * memory;
+        std::size_t size;
+
+        RecordFile(const int fd, const std::size_t size, const int protection, const std::string & path) : fd(fd), size(size)
+        {
+            this->memory = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+            if(this->memory == MAP_FAILED)
+            {
+                const int error = errno;
+                this->memory = nullptr;
+                close(fd);
+                this->fd = -1;
+                throw std::system_error(error, std::generic_category(), "mmap " + path);
+            }
+        }
+    };
+}
+
+/**
+ * @brief Append-only log of the emits of recorded signals, in a memory mapped file, see @ref SignalReplayer.
+ *
+ * Each emit is written with its time and its arguments, encoded by @ref SignalWire, into a buffer of the
+ * emitting thread. Full buffers are copied to the file in one go, at an offset reserved with a single atomic
+ * operation: threads never wait for each other, nor for a system call. The file has a fixed capacity;
+ * buffers that don't fit anymore are dropped and counted. Records in the mapping reach the file even if the
+ * process crashes, those still in buffers don't: call @ref SignalRecorder::flush() at the points that matter.
+ *
+ * Only signals using @ref SignalPolicy::Recorded can be recorded. They must stop emitting, or be stopped with
+ * @ref SignalRecorder::stop(), before the recorder is destroyed. A recorded signal may be destroyed first: it leaves the recorder.
+ *
+ * @code{.cpp}
+ * Signal<SignalPolicy::Recorded<SignalPolicy::Mutex>, Order> orders;
+ * SignalRecorder recorder("orders.log");
+ * recorder.record(orders, "orders");
+ * orders.emit(order); //Recorded, then delivered.
+ * @endcode
+ */
+class SignalRecorder
+{
+public:
+    /**
+     * @brief Create the log, replacing any file of the same name.
+     * @param path File of the log.
+     * @param capacity Size of the file, header included. Cut to the used part on destruction.
+     * @param flushBytes Size from which a thread buffer is copied to the file.
+     * @throw std::system_error If the file can't be created or mapped.
+     */
+    explicit SignalRecorder(const std::string & path, const std::size_t capacity = std::size_t(64) << 20, const std::size_t flushBytes = std::size_t(64) << 10)
+        : file(SignalDetail::RecordFile::create(path, std::max(capacity, sizeof(SignalDetail::RecordHeader)))),
+          flushBytes(flushBytes), start(std::chrono::steady_clock::now()), serial(nextSerial())
+    {
+        SignalDetail::RecordHeader * header = new (this->file.data()) SignalDetail::RecordHeader{};
+        header->magic = SignalDetail::recordMagic;
+        header->version = 1;
+        header->headerSize = sizeof(SignalDetail::RecordHeader);
+        header->capacity = this->file.bytes();
+        header->wallStart = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        header->tail.store(sizeof(SignalDetail::RecordHeader), std::memory_order_release);
+    }
+
+    SignalRecorder(const SignalRecorder &) = delete;
+    SignalRecorder & operator=(const SignalRecorder &) = delete;
+
+    /**
+     * @brief Stop recording, copy every buffer to the file and cut it to its used part.
+     */
+    ~SignalRecorder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            for(const Entry & entry: this->entries)
+            {
+                entry.stop();
+            }
+        }
+        this->flush();
+        this->file.shrink(this->header().tail.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Record every emit of a signal from now on, under a name.
+     * A signal recorded by another recorder moves to this one.
+     * @param signal Signal using @ref SignalPolicy::Recorded, with arguments known to @ref SignalWire::Codec.
+     * @param name Name given to @ref SignalReplayer::bind() to replay it.
+     */
+    template<typename Policy, typename... Args>
+    requires SignalDetail::isRecording<typename SignalDetail::StatsOf<Policy>::type>
+    void record(BasicSignal<Policy, Args...> & signal, const std::string_view name)
+    {
+        const SignalDetail::RecordTap * previous = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            std::unique_ptr<Channel> & channel = this->channels.emplace_back(std::make_unique<Channel>());
+            channel->write = &SignalRecorder::write<Args...>;
+            channel->forget = &SignalRecorder::forget;
+            channel->recorder = this;
+            channel->id = this->channels.size() - 1;
+            std::vector<std::byte> bytes;
+            SignalWire::Writer w(bytes);
+            this->begin(w, bytes, SignalDetail::RecordKind::Channel, channel->id);
+            SignalWire::Codec<std::string>::write(w, std::string(name));
+            this->end(bytes, 0);
+            this->reserve(bytes, 0);
+            this->entries.push_back(Entry{&signal, channel.get(), &SignalRecorder::detach<Policy, Args...>});
+            previous = signal.setRecordTap(channel.get());
+        }
+        //Unlocked: the previous recorder may be this one.
+        if(previous != nullptr)
+        {
+            previous->forget(*previous);
+        }
+    }
+
+    /**
+     * @brief Stop recording a signal. Its emits already recorded stay in the log.
+     */
+    template<typename Policy, typename... Args>
+    requires SignalDetail::isRecording<typename SignalDetail::StatsOf<Policy>::type>
+    void stop(BasicSignal<Policy, Args...> & signal)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        std::erase_if(this->entries, [&signal](const Entry & entry) {
+            if(entry.signal != &signal)
+            {
+                return false;
+            }
+            entry.stop();
+            return true;
+        });
+    }
+
+    /**
+     * @brief Copy the buffer of every thread to the file.
+     */
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        for(const std::unique_ptr<ThreadBuffer> & buffer: this->buffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mtx);
+            this->flush(*buffer);
+        }
+    }
+
+    /**
+     * @brief Number of emits lost because the file was full.
+     */
+    std::uint64_t dropped() const
+    {
+        return this->header().dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Bytes of the file used so far, header included.
+     */
+    std::uint64_t size() const
+    {
+        return this->header().tail.load(std::memory_order_acquire);
+    }
+
+private:
+    /**
+     * @brief Records of one thread waiting to be copied to the file.
+     * Its mutex is only contended by @ref SignalRecorder::flush().
+     */
+    struct ThreadBuffer
+    {
+        std::mutex mtx;
+        std::vector<std::byte> bytes;
+        std::uint64_t records = 0;
+    };
+
+    struct Channel : SignalDetail::RecordTap
+    {
+        SignalRecorder * recorder;
+        std::uint64_t id;
+    };
+
+    /**
+     * @brief A recorded signal, to detach it when the recorder goes away.
+     * Dropped without touching the signal once it is destroyed or taken over by another recorder.
+     */
+    struct Entry
+    {
+        void * signal;
+        const SignalDetail::RecordTap * tap;
+        void (*detach)(void * signal, const SignalDetail::RecordTap * tap);
+
+        void stop() const
+        {
+            this->detach(this->signal, this->tap);
+        }
+    };
+
+    SignalDetail::RecordFile file;
+    const std::size_t flushBytes;
+    const std::chrono::steady_clock::time_point start;
+    /**
+     * @brief serial Tells the recorder apart in thread caches, never reused.
+     */
+    const std::uint64_t serial;
+    /**
+     * @brief mtx Protects channels, entries and buffers, never taken by emit once a thread has its buffer.
+     */
+    std::mutex mtx;
+    std::vector<std::unique_ptr<Channel>> channels;
+    std::vector<Entry> entries;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    /**
+     * @brief owners Threads owning the buffers, same order.
+     */
+    std::vector<std::thread::id> owners;
+
+    static std::uint64_t nextSerial()
+    {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    SignalDetail::RecordHeader & header() const
+    {
+        return *std::launder(reinterpret_cast<SignalDetail::RecordHeader *>(this->file.data()));
+    }
+
+    /**
+     * @brief Drop the entry of a signal gone or taken over, without touching the signal.
+     */
+    static void forget(const SignalDetail::RecordTap & tap)
+    {
+        SignalRecorder * recorder = static_cast<const Channel &>(tap).recorder;
+        std::lock_guard<std::mutex> lock(recorder->mtx);
+        std::erase_if(recorder->entries, [&tap](const Entry & entry) { return entry.tap == &tap; });
+    }
+
+    template<typename Policy, typename... Args>
+    static void detach(void * signal, const SignalDetail::RecordTap * tap)
+    {
+        static_cast<BasicSignal<Policy, Args...> *>(signal)->clearRecordTap(tap);
+    }
+
+    template<typename... Args>
+    static void write(const SignalDetail::RecordTap & tap, void * const * argv)
+    {
+        const Channel & channel = static_cast<const Channel &>(tap);
+        channel.recorder->append(channel.id, [argv](SignalWire::Writer & w) {
+            [&w, argv]<std::size_t... I>(std::index_sequence<I...>) {
+                SignalDetail::writeAll(w, std::tie(SignalDetail::argAt<Args>(argv, I)...));
+            }(std::index_sequence_for<Args...>{});
+        });
+    }
+
+    /**
+     * @brief Buffer of the calling thread, created on its first record.
+     * Threads remember the last recorder they wrote to, so only a thread writing to several looks it up again.
+     */
+    ThreadBuffer & buffer()
+    {
+        struct Cache
+        {
+            std::uint64_t serial = 0;
+            ThreadBuffer * buffer = nullptr;
+        };
+        thread_local Cache cache;
+        if(cache.serial != this->serial)
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            const std::thread::id self = std::this_thread::get_id();
+            ThreadBuffer * found = nullptr;
+            for(std::size_t k = 0; k < this->buffers.size(); ++k)
+            {
+                if(this->owners[k] == self)
+                {
+                    found = this->buffers[k].get();
+                }
+            }
+            if(!found)
+            {
+                found = this->buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+                found->bytes.reserve(this->flushBytes + 256);
+                this->owners.push_back(self);
+            }
+            cache = Cache{this->serial, found};
+        }
+        return *cache.buffer;
+    }
+
+    template<typename Encode>
+    void append(const std::uint64_t channel, Encode && encode)
+    {
+        ThreadBuffer & buffer = this->buffer();
+        std::lock_guard<std::mutex> lock(buffer.mtx);
+        const std::size_t first = buffer.bytes.size();
+        SignalWire::Writer w(buffer.bytes);
+        this->begin(w, buffer.bytes, SignalDetail::RecordKind::Event, channel);
+        encode(w);
+        this->end(buffer.bytes, first);
+        ++buffer.records;
+        if(buffer.bytes.size() >= this->flushBytes)
+        {
+            this->flush(buffer);
+        }
+    }
+
+    void begin(SignalWire::Writer & w, std::vector<std::byte> & bytes, const SignalDetail::RecordKind kind, const std::uint64_t channel) const
+    {
+        bytes.resize(bytes.size() + sizeof(std::uint32_t));
+        const std::uint8_t k = static_cast<std::uint8_t>(kind);
+        w.raw(&k, sizeof(k));
+        w.varint(channel);
+        const std::uint64_t ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count());
+        w.raw(&ns, sizeof(ns));
+    }
+
+    /**
+     * @brief Write the size of the record starting at first.
+     */
+    static void end(std::vector<std::byte> & bytes, const std::size_t first)
+    {
+        const std::uint32_t size = static_cast<std::uint32_t>(bytes.size() - first);
+        std::memcpy(bytes.data() + first, &size, sizeof(size));
+    }
+
+    void flush(ThreadBuffer & buffer)
+    {
+        if(!buffer.bytes.empty())
+        {
+            this->reserve(buffer.bytes, buffer.records);
+            buffer.bytes.clear();
+            buffer.records = 0;
+        }
+    }
+
+    /**
+     * @brief Copy records to the file, or drop them all if they don't fit.
+     * @param bytes Whole records.
+     * @param records Number of emits in bytes, counted if dropped.
+     */
+    void reserve(const std::vector<std::byte> & bytes, const std::uint64_t records)
+    {
+        SignalDetail::RecordHeader & header = this->header();
+        std::uint64_t offset = header.tail.load(std::memory_order_relaxed);
+        do
+        {
+            if(offset + bytes.size() > this->file.bytes())
+            {
+                header.dropped.fetch_add(records, std::memory_order_relaxed);
+                return;
+            }
+        }
+        while(!header.tail.compare_exchange_weak(offset, offset + bytes.size(), std::memory_order_acq_rel, std::memory_order_relaxed));
+        std::memcpy(this->file.data() + offset, bytes.data(), bytes.size());
+    }
+};
+
+/**
+ * @brief Pace of @ref SignalReplayer::replay().
+ */
+enum class ReplayPace
+{
+    /**
+     * @brief Emit as fast as possible.
+     */
+    FullSpeed,
+    /**
+     * @brief Keep the time between emits as recorded.
+     */
+    RealTime
+};
+
+/**
+ * @brief Emits again what a @ref SignalRecorder logged, on signals bound by name.
+ *
+ * Emits are replayed in time order, whatever thread recorded them; those of one thread keep their order.
+ * A log still being written is read up to its last complete buffer.
+ *
+ * @code{.cpp}
+ * Signal<Order> orders;
+ * SignalReplayer replayer("orders.log");
+ * replayer.bind("orders", orders);
+ * replayer.replay(ReplayPace::RealTime);
+ * @endcode
+ */
+class SignalReplayer
+{
+public:
+    /**
+     * @brief Read a log.
+     * @param path File written by a @ref SignalRecorder.
+     * @throw std::system_error If the file can't be read.
+     * @throw std::runtime_error If the file is not a log.
+     */
+    explicit SignalReplayer(const std::string & path) : file(SignalDetail::RecordFile::open(path))
+    {
+        const SignalDetail::RecordHeader & header = *reinterpret_cast<const SignalDetail::RecordHeader *>(this->file.data());
+        if(header.magic != SignalDetail::recordMagic || header.version != 1 || header.headerSize != sizeof(SignalDetail::RecordHeader))
+        {
+            throw std::runtime_error("SignalReplayer: " + path + " is not a signal log");
+        }
+        this->wallStart = header.wallStart;
+        const std::size_t tail = std::min<std::size_t>(header.tail.load(std::memory_order_acquire), this->file.bytes());
+        std::size_t offset = sizeof(SignalDetail::RecordHeader);
+        while(offset + sizeof(std::uint32_t) <= tail)
+        {
+            std::uint32_t size = 0;
+            std::memcpy(&size, this->file.data() + offset, sizeof(size));
+            if(size <= sizeof(size) || offset + size > tail)
+            {
+                //Reserved but not written yet, or cut.
+                break;
+            }
+            this->parse(std::span<const std::byte>(this->file.data() + offset + sizeof(size), size - sizeof(size)));
+            offset += size;
+        }
+        std::stable_sort(this->events.begin(), this->events.end(), [](const Event & a, const Event & b) { return a.time < b.time; });
+    }
+
+    SignalReplayer(const SignalReplayer &) = delete;
+    SignalReplayer & operator=(const SignalReplayer &) = delete;
+
+    /**
+     * @brief Replay the emits recorded under a name on a signal.
+     * @param name Name given to @ref SignalRecorder::record().
+     * @param signal Signal with the arguments of the recorded one, any policy. Must outlive the replays.
+     */
+    template<typename Policy, typename... Args>
+    void bind(const std::string_view name, BasicSignal<Policy, Args...> & signal)
+    {
+        this->targets.insert_or_assign(std::string(name), [&signal](SignalWire::Reader & r) {
+            std::tuple<std::decay_t<Args>...> event;
+            if(!SignalDetail::readAll(r, event) || r.remaining() != 0)
+            {
+                return false;
+            }
+            std::apply([&signal](auto &... args) { signal.emit(args...); }, event);
+            return true;
+        });
+    }
+
+    /**
+     * @brief Emit every recorded event of the bound names, others are skipped.
+     * @param pace How fast, see @ref ReplayPace.
+     * @return Number of emits.
+     */
+    std::size_t replay(const ReplayPace pace = ReplayPace::FullSpeed)
+    {
+        std::unordered_map<std::uint64_t, MoveOnlyFunction<bool(SignalWire::Reader &)> *> bound;
+        for(const auto & [channel, name]: this->names)
+        {
+            const auto found = this->targets.find(name);
+            if(found != this->targets.end())
+            {
+                bound.emplace(channel, &found->second);
+            }
+        }
+        this->malformed = 0;
+        std::size_t emitted = 0;
+        const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        const std::uint64_t first = this->events.empty() ? 0 : this->events.front().time;
+        for(const Event & event: this->events)
+        {
+            const auto target = bound.find(event.channel);
+            if(target == bound.end())
+            {
+                continue;
+            }
+            if(pace == ReplayPace::RealTime)
+            {
+                std::this_thread::sleep_until(begin + std::chrono::nanoseconds(event.time - first));
+            }
+            SignalWire::Reader r(event.payload);
+            if((*target->second)(r))
+            {
+                ++emitted;
+            }
+            else
+            {
+                ++this->malformed;
+            }
+        }
+        return emitted;
+    }
+
+    /**
+     * @brief Number of recorded emits, of every name.
+     */
+    std::size_t size() const
+    {
+        return this->events.size();
+    }
+
+    /**
+     * @brief Emits of the last replay whose arguments didn't decode as those of the bound signal.
+     */
+    std::size_t skipped() const
+    {
+        return this->malformed;
+    }
+
+    /**
+     * @brief When the recording started.
+     */
+    std::chrono::system_clock::time_point started() const
+    {
+        return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(this->wallStart)));
+    }
+
+private:
+    struct Event
+    {
+        std::uint64_t time;
+        std::uint64_t channel;
+        std::span<const std::byte> payload;
+    };
+
+    SignalDetail::RecordFile file;
+    std::int64_t wallStart = 0;
+    std::unordered_map<std::uint64_t, std::string> names;
+    std::vector<Event> events;
+    std::unordered_map<std::string, MoveOnlyFunction<bool(SignalWire::Reader &)>> targets;
+    std::size_t malformed = 0;
+
+    void parse(const std::span<const std::byte> record)
+    {
+        SignalWire::Reader r(record);
+        std::uint8_t kind = 0;
+        std::uint64_t channel = 0;
+        std::uint64_t time = 0;
+        if(!r.raw(&kind, sizeof(kind)) || !r.varint(channel) || !r.raw(&time, sizeof(time)))
+        {
+            return;
+        }
+        if(kind == static_cast<std::uint8_t>(SignalDetail::RecordKind::Channel))
+        {
+            std::string name;
+            if(SignalWire::Codec<std::string>::read(r, name))
+            {
+                this->names.insert_or_assign(channel, std::move(name));
+            }
+        }
+        else if(kind == static_cast<std::uint8_t>(SignalDetail::RecordKind::Event))
+        {
+            this->events.push_back(Event{time, channel, record.subspan(r.position())});
+        }
+    }
+};
+
+#endif
+
+#endif //SIGNAL_RECORDER_H
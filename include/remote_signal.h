@@ -0,0 +1,772 @@
+#ifndef SIGNAL_REMOTE_SIGNAL_H
+#define SIGNAL_REMOTE_SIGNAL_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/socket.h>
+#endif
+
+#include "signals.h"
+#include "wire.h"
+
+/**
+ * @brief Byte stream between two @ref RemoteLink "links". Neither call may block.
+ */
+class SignalTransport
+{
+public:
+    virtual ~SignalTransport() = default;
+
+    /**
+     * @brief Send the start of some bytes.
+     * @param bytes Bytes to send.
+     * @return Number of bytes sent, 0 if none can be right now.
+     */
+    virtual std::size_t send(std::span<const std::byte> bytes) = 0;
+
+    /**
+     * @brief Read the bytes received so far.
+     * @param bytes Where to write them.
+     * @return Number of bytes read, 0 if none is waiting.
+     */
+    virtual std::size_t receive(std::span<std::byte> bytes) = 0;
+
+    /**
+     * @brief Whether the peer is gone for good: nothing waits for the transport anymore, the bytes queued are dropped.
+     */
+    virtual bool closed() const
+    {
+        return false;
+    }
+};
+
+#if defined(__linux__)
+/**
+ * @brief Transport over a connected stream socket (TCP, Unix), used without blocking.
+ * The socket stays owned by the caller.
+ */
+class SocketTransport : public SignalTransport
+{
+public:
+    explicit SocketTransport(const int fd) : fd(fd) {}
+
+    std::size_t send(std::span<const std::byte> bytes) override
+    {
+        const ssize_t n = ::send(this->fd, bytes.data(), bytes.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if(n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            this->broken.store(true, std::memory_order_relaxed);
+        }
+        return n > 0 ? static_cast<std::size_t>(n) : 0;
+    }
+
+    std::size_t receive(std::span<std::byte> bytes) override
+    {
+        const ssize_t n = ::recv(this->fd, bytes.data(), bytes.size(), MSG_DONTWAIT);
+        if(n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        {
+            this->broken.store(true, std::memory_order_relaxed);
+        }
+        return n > 0 ? static_cast<std::size_t>(n) : 0;
+    }
+
+    /**
+     * @brief Whether the peer closed the socket or it failed.
+     */
+    bool closed() const override
+    {
+        return this->broken.load(std::memory_order_relaxed);
+    }
+
+private:
+    int fd;
+    std::atomic<bool> broken{false};
+};
+#endif
+
+/**
+ * @brief What a @ref RemoteLink does with an emit once too many bytes wait for the transport.
+ */
+enum class RemoteOverflow
+{
+    /**
+     * @brief The emit sends until there is room again, or the transport is closed.
+     */
+    Block,
+    /**
+     * @brief The event is dropped and counted, see @ref RemoteLink::dropped().
+     */
+    Drop
+};
+
+/**
+ * @brief Batching and backpressure of a @ref RemoteLink.
+ */
+struct RemoteOptions
+{
+    /**
+     * @brief A frame is sent once it holds that many bytes.
+     */
+    std::size_t maxFrame = 16 * 1024;
+    /**
+     * @brief Or once its first event waited that long, checked by emits and @ref RemoteLink::poll().
+     */
+    std::chrono::nanoseconds flushWindow = std::chrono::microseconds(200);
+    /**
+     * @brief Bytes waiting for the transport before @ref RemoteOptions::overflow applies.
+     */
+    std::size_t maxPending = 1024 * 1024;
+    RemoteOverflow overflow = RemoteOverflow::Block;
+};
+
+namespace SignalDetail {
+
+    /**
+     * @brief Messages of a frame: kind, channel, body size then body.
+     */
+    enum class RemoteMessage : std::uint8_t
+    {
+        Event = 0,
+        Subscribe = 1,
+        Unsubscribe = 2
+    };
+
+    /**
+     * @brief Channel subscribed to by this side, its events come from the peer.
+     */
+    class RemoteInbound
+    {
+    public:
+        virtual ~RemoteInbound() = default;
+
+        /**
+         * @brief Decode an event and emit it locally.
+         * @return false if the event is malformed.
+         */
+        virtual bool deliver(SignalWire::Reader & body) = 0;
+    };
+
+    /**
+     * @brief Signal published by this side, the peer subscribes to it.
+     */
+    class RemoteOutbound
+    {
+    public:
+        virtual ~RemoteOutbound() = default;
+        virtual void subscribe(std::uint64_t channel) = 0;
+        virtual void unsubscribe(std::uint64_t channel) = 0;
+    };
+
+    template<typename Policy, typename... Args>
+    class PublishedSignal;
+}
+
+/**
+ * @brief Bridges signals between two nodes over a @ref SignalTransport.
+ *
+ * One side publishes local signals by name, the other subscribes to them and gets a @ref Connection
+ * like for any signal: the first subscription to a name subscribes remotely, dropping the last
+ * Connection unsubscribes remotely, so no event is sent for nobody. Both sides may publish and subscribe.
+ *
+ * Emits of a published signal encode their arguments with @ref SignalWire::Codec into the open frame,
+ * sent once it is full or its flush window is over. Received events are emitted by the thread calling
+ * @ref RemoteLink::poll(), which also handles subscriptions and late frames. Call it in a loop, or on a timer.
+ * Subscribing and dropping a Connection never wait for the transport: what it doesn't take right away goes
+ * with the next poll(). Nothing waits for a transport once it is @ref SignalTransport::closed().
+ *
+ * @code{.cpp}
+ * //Node A.
+ * Signal<Order> orders;
+ * RemoteLink link(transport);
+ * link.publish("orders", orders);
+ *
+ * //Node B.
+ * RemoteLink link(transport);
+ * Connection c = link.subscribe<Order>("orders", &book, &Book::add);
+ * while(running) { link.poll(); }
+ * @endcode
+ * Connections from @ref RemoteLink::subscribe() must go before the link, published signals must outlive it.
+ */
+class RemoteLink
+{
+template<typename...> friend class SignalDetail::RemoteChannel;
+template<typename, typename...> friend class SignalDetail::PublishedSignal;
+using RemoteMessage = SignalDetail::RemoteMessage;
+
+public:
+    /**
+     * @brief Link over a transport, kept by reference.
+     * @param transport Stream to the peer.
+     * @param options Batching and backpressure.
+     */
+    explicit RemoteLink(SignalTransport & transport, const RemoteOptions options = {})
+        : transport(transport), options(options) {}
+
+    /**
+     * @brief Deleted. Connections point to the link.
+     */
+    RemoteLink(const RemoteLink &) = delete;
+
+    /**
+     * @brief Deleted. Connections point to the link.
+     */
+    RemoteLink & operator=(const RemoteLink &) = delete;
+
+    /**
+     * @brief Make a signal available to the peer under a name.
+     * Nothing happens on emit until the peer subscribes: the link connects to the signal then.
+     * @param name Name the peer subscribes with.
+     * @param signal Signal to publish, must outlive the link.
+     * @throw std::logic_error If the name is already published: the peer is subscribed to that signal.
+     */
+    template<typename Policy, typename... Args>
+    void publish(std::string_view name, BasicSignal<Policy, Args...> & signal)
+    {
+        std::lock_guard<std::mutex> lock(this->channelsMtx);
+        const std::pair<std::unordered_map<std::string, std::unique_ptr<SignalDetail::RemoteOutbound>>::iterator, bool> added = this->published.try_emplace(std::string(name));
+        if(!added.second)
+        {
+            throw std::logic_error("RemoteLink: " + std::string(name) + " already published");
+        }
+        std::unique_ptr<SignalDetail::RemoteOutbound> & out = added.first->second;
+        out = std::make_unique<SignalDetail::PublishedSignal<Policy, Args...>>(*this, signal);
+        std::unordered_map<std::string, std::vector<std::uint64_t>>::iterator early = this->early.find(std::string(name));
+        if(early != this->early.end())
+        {
+            for(const std::uint64_t channel: early->second)
+            {
+                out->subscribe(channel);
+                this->subscribers[channel] = out.get();
+            }
+            this->early.erase(early);
+        }
+    }
+
+    /**
+     * @brief Connect a method to a signal published by the peer.
+     * @tparam Args Parameters of the remote signal.
+     * @param name Name it was published with.
+     * @param args Same as for @ref BasicSignal::connect().
+     * @return Connection, disconnecting the last one of a name unsubscribes remotely.
+     * @throw std::logic_error If the name was already subscribed to with other parameters.
+     */
+    template<typename... Args, typename... ConnectArgs>
+    Connection<Args...> subscribe(std::string_view name, ConnectArgs&&... args)
+    {
+        SignalDetail::RemoteChannel<Args...> * channel = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(this->channelsMtx);
+            std::unordered_map<std::string, std::uint64_t>::iterator found = this->names.find(std::string(name));
+            if(found == this->names.end())
+            {
+                const std::uint64_t id = this->nextChannel++;
+                std::unique_ptr<SignalDetail::RemoteChannel<Args...>> made = std::make_unique<SignalDetail::RemoteChannel<Args...>>(*this, id, std::string(name));
+                channel = made.get();
+                this->inbound.emplace(id, std::move(made));
+                this->names.emplace(std::string(name), id);
+            }
+            else
+            {
+                channel = dynamic_cast<SignalDetail::RemoteChannel<Args...> *>(this->inbound.at(found->second).get());
+                if(channel == nullptr)
+                {
+                    throw std::logic_error("RemoteLink: " + std::string(name) + " subscribed with other parameters");
+                }
+            }
+        }
+        return channel->connect(std::forward<ConnectArgs>(args)...);
+    }
+
+    /**
+     * @brief Send late frames, then read what the peer sent: events are emitted, subscriptions applied.
+     * @return Number of events emitted.
+     */
+    std::size_t poll()
+    {
+        this->flushDue();
+        for(;;)
+        {
+            const std::size_t old = this->inbox.size();
+            this->inbox.resize(old + 64 * 1024);
+            const std::size_t n = this->transport.receive(std::span<std::byte>(this->inbox).subspan(old));
+            this->inbox.resize(old + n);
+            if(n == 0)
+            {
+                break;
+            }
+        }
+        SignalWire::Reader reader(this->inbox);
+        std::size_t consumed = 0;
+        std::size_t events = 0;
+        std::uint64_t size = 0;
+        std::span<const std::byte> frame;
+        while(reader.varint(size) && reader.take(size, frame))
+        {
+            consumed = reader.position();
+            events += this->read(frame);
+        }
+        this->inbox.erase(this->inbox.begin(), this->inbox.begin() + static_cast<std::ptrdiff_t>(consumed));
+        return events;
+    }
+
+    /**
+     * @brief Send the open frame now, waiting for the transport if needed, unless it is @ref SignalTransport::closed().
+     */
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(this->outMtx);
+        this->seal();
+        while(!this->drain())
+        {
+            if(this->transport.closed())
+            {
+                this->discard();
+                return;
+            }
+            lock.unlock();
+            std::this_thread::yield();
+            lock.lock();
+        }
+    }
+
+    /**
+     * @brief Events dropped by @ref RemoteOverflow::Drop.
+     */
+    std::size_t dropped() const
+    {
+        return this->droppedCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Frames handed to the transport so far.
+     */
+    std::size_t frames() const
+    {
+        return this->frameCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    SignalTransport & transport;
+    const RemoteOptions options;
+
+    /**
+     * @brief outMtx Protects the frames on their way out, taken by emits of published signals.
+     */
+    std::mutex outMtx;
+    std::vector<std::byte> frame;
+    std::vector<std::byte> body;
+    std::chrono::steady_clock::time_point opened;
+    /**
+     * @brief Whether the open frame holds a subscription message, sealed by the next poll() whatever its age.
+     */
+    bool urgent = false;
+    /**
+     * @brief Sealed frames, sent from sent on.
+     */
+    std::vector<std::byte> outgoing;
+    std::size_t sent = 0;
+    std::atomic<std::size_t> droppedCount{0};
+    std::atomic<std::size_t> frameCount{0};
+
+    /**
+     * @brief Received bytes not making a whole frame yet, only touched by poll().
+     */
+    std::vector<std::byte> inbox;
+
+    /**
+     * @brief channelsMtx Protects the channels, never taken by emits.
+     */
+    std::mutex channelsMtx;
+    std::unordered_map<std::uint64_t, std::unique_ptr<SignalDetail::RemoteInbound>> inbound;
+    std::unordered_map<std::string, std::uint64_t> names;
+    std::uint64_t nextChannel = 0;
+    std::unordered_map<std::string, std::unique_ptr<SignalDetail::RemoteOutbound>> published;
+    /**
+     * @brief Channels of the peer by its ids, and those waiting for a name to be published.
+     */
+    std::unordered_map<std::uint64_t, SignalDetail::RemoteOutbound *> subscribers;
+    std::unordered_map<std::string, std::vector<std::uint64_t>> early;
+
+    /**
+     * @brief Queue an event of a published signal.
+     */
+    template<typename... A>
+    void send(const std::uint64_t channel, const A&... args)
+    {
+        std::unique_lock<std::mutex> lock(this->outMtx);
+        while(this->pending() >= this->options.maxPending)
+        {
+            this->seal();
+            if(this->drain())
+            {
+                break;
+            }
+            if(this->transport.closed())
+            {
+                this->discard();
+                break;
+            }
+            if(this->options.overflow == RemoteOverflow::Drop)
+            {
+                this->droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            lock.unlock();
+            std::this_thread::yield();
+            lock.lock();
+        }
+        this->body.clear();
+        SignalWire::Writer w(this->body);
+        (SignalWire::Codec<std::remove_cvref_t<A>>::write(w, args), ...);
+        this->append(RemoteMessage::Event, channel);
+        const bool late = std::chrono::steady_clock::now() - this->opened >= this->options.flushWindow;
+        if(this->frame.size() >= this->options.maxFrame || late)
+        {
+            this->seal();
+            this->drain();
+        }
+    }
+
+    /**
+     * @brief Add a subscription message to the open frame, in call order. Sent by the next @ref RemoteLink::kick() or poll().
+     */
+    void control(const RemoteMessage kind, const std::uint64_t channel, std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(this->outMtx);
+        this->body.clear();
+        this->body.insert(this->body.end(), reinterpret_cast<const std::byte *>(name.data()), reinterpret_cast<const std::byte *>(name.data()) + name.size());
+        this->append(kind, channel);
+        this->urgent = true;
+    }
+
+    /**
+     * @brief Send what the transport takes right now, the rest goes with the next poll(). Never waits.
+     */
+    void kick()
+    {
+        std::lock_guard<std::mutex> lock(this->outMtx);
+        this->seal();
+        this->drain();
+    }
+
+    /**
+     * @brief Add the message in body to the open frame. outMtx must be held.
+     */
+    void append(const RemoteMessage kind, const std::uint64_t channel)
+    {
+        if(this->frame.empty())
+        {
+            this->opened = std::chrono::steady_clock::now();
+        }
+        SignalWire::Writer w(this->frame);
+        w.varint(static_cast<std::uint64_t>(kind));
+        w.varint(channel);
+        w.varint(this->body.size());
+        w.raw(this->body.data(), this->body.size());
+    }
+
+    /**
+     * @brief Close the open frame, queueing it with its size. outMtx must be held.
+     */
+    void seal()
+    {
+        if(this->frame.empty())
+        {
+            return;
+        }
+        SignalWire::Writer w(this->outgoing);
+        w.varint(this->frame.size());
+        w.raw(this->frame.data(), this->frame.size());
+        this->frame.clear();
+        this->urgent = false;
+        this->frameCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Send queued frames as long as the transport takes them. outMtx must be held.
+     * @return Whether everything was sent.
+     */
+    bool drain()
+    {
+        while(this->sent < this->outgoing.size())
+        {
+            const std::size_t n = this->transport.send(std::span<const std::byte>(this->outgoing).subspan(this->sent));
+            if(n == 0)
+            {
+                break;
+            }
+            this->sent += n;
+        }
+        if(this->sent == this->outgoing.size())
+        {
+            this->outgoing.clear();
+            this->sent = 0;
+            return true;
+        }
+        return false;
+    }
+
+    std::size_t pending() const
+    {
+        return this->outgoing.size() - this->sent + this->frame.size();
+    }
+
+    void flushDue()
+    {
+        std::lock_guard<std::mutex> lock(this->outMtx);
+        if(!this->frame.empty() && (this->urgent || std::chrono::steady_clock::now() - this->opened >= this->options.flushWindow))
+        {
+            this->seal();
+        }
+        if(!this->drain() && this->transport.closed())
+        {
+            this->discard();
+        }
+    }
+
+    /**
+     * @brief Drop the frames of a closed transport. outMtx must be held.
+     */
+    void discard()
+    {
+        this->outgoing.clear();
+        this->sent = 0;
+        this->frame.clear();
+        this->urgent = false;
+    }
+
+    /**
+     * @brief Handle the messages of a frame, up to the first malformed one.
+     * @return Number of events emitted.
+     */
+    std::size_t read(const std::span<const std::byte> frame)
+    {
+        SignalWire::Reader reader(frame);
+        std::size_t events = 0;
+        std::uint64_t kind = 0;
+        std::uint64_t channel = 0;
+        std::uint64_t size = 0;
+        std::span<const std::byte> message;
+        while(reader.varint(kind) && reader.varint(channel) && reader.varint(size) && reader.take(size, message))
+        {
+            if(kind == static_cast<std::uint64_t>(RemoteMessage::Event))
+            {
+                SignalDetail::RemoteInbound * target = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(this->channelsMtx);
+                    std::unordered_map<std::uint64_t, std::unique_ptr<SignalDetail::RemoteInbound>>::iterator found = this->inbound.find(channel);
+                    target = found == this->inbound.end() ? nullptr : found->second.get();
+                }
+                SignalWire::Reader body(message);
+                //Channels are never removed: the pointer stays valid once the lock is released.
+                events += target != nullptr && target->deliver(body);
+            }
+            else
+            {
+                const std::string name(reinterpret_cast<const char *>(message.data()), message.size());
+                std::lock_guard<std::mutex> lock(this->channelsMtx);
+                if(kind == static_cast<std::uint64_t>(RemoteMessage::Subscribe))
+                {
+                    std::unordered_map<std::string, std::unique_ptr<SignalDetail::RemoteOutbound>>::iterator found = this->published.find(name);
+                    if(found == this->published.end())
+                    {
+                        this->early[name].push_back(channel);
+                    }
+                    else
+                    {
+                        found->second->subscribe(channel);
+                        this->subscribers[channel] = found->second.get();
+                    }
+                }
+                else if(kind == static_cast<std::uint64_t>(RemoteMessage::Unsubscribe))
+                {
+                    std::unordered_map<std::uint64_t, SignalDetail::RemoteOutbound *>::iterator found = this->subscribers.find(channel);
+                    if(found != this->subscribers.end())
+                    {
+                        found->second->unsubscribe(channel);
+                        this->subscribers.erase(found);
+                    }
+                    else
+                    {
+                        std::unordered_map<std::string, std::vector<std::uint64_t>>::iterator waiting = this->early.find(name);
+                        if(waiting != this->early.end())
+                        {
+                            std::erase(waiting->second, channel);
+                        }
+                    }
+                }
+            }
+        }
+        return events;
+    }
+};
+
+namespace SignalDetail {
+
+    /**
+     * @brief Local end of a subscription: a signal emitted with the events of the peer,
+     * and the connections to it handed out by @ref RemoteLink::subscribe().
+     * @tparam Args Parameters of the remote signal.
+     */
+    template<typename... Args>
+    class RemoteChannel : public ConnectionTarget, public RemoteInbound
+    {
+    public:
+        RemoteChannel(RemoteLink & link, const std::uint64_t channel, std::string name)
+            : link(link), channel(channel), name(std::move(name)) {}
+
+        template<typename... ConnectArgs>
+        Connection<Args...> connect(ConnectArgs&&... args)
+        {
+            Connection<Args...> inner = this->local.connect(std::forward<ConnectArgs>(args)...);
+            idType id = 0;
+            bool first = false;
+            {
+                //Queued under mtx: subscriptions leave in the order the links changed.
+                std::lock_guard<std::mutex> lock(this->mtx);
+                id = ++this->next;
+                this->links.emplace(id, std::move(inner));
+                first = this->links.size() == 1;
+                if(first)
+                {
+                    this->link.control(RemoteMessage::Subscribe, this->channel, this->name);
+                }
+            }
+            //Sent unlocked, without waiting: poll() sends what the transport didn't take.
+            if(first)
+            {
+                this->link.kick();
+            }
+            return Connection<Args...>(this, id);
+        }
+
+        bool deliver(SignalWire::Reader & body) override
+        {
+            std::tuple<std::decay_t<Args>...> event;
+            if(!SignalDetail::readAll(body, event))
+            {
+                return false;
+            }
+            std::apply([this](auto &... args) { this->local.emit(args...); }, event);
+            return true;
+        }
+
+    private:
+        RemoteLink & link;
+        const std::uint64_t channel;
+        const std::string name;
+        Signal<Args...> local;
+        /**
+         * @brief mtx Protects links and next, and orders the subscription messages.
+         */
+        std::mutex mtx;
+        std::unordered_map<idType, Connection<Args...>> links;
+        idType next = 0;
+
+        void disconnect(const idType id) override
+        {
+            Connection<Args...> gone;
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(this->mtx);
+                typename std::unordered_map<idType, Connection<Args...>>::iterator found = this->links.find(id);
+                if(found == this->links.end())
+                {
+                    return;
+                }
+                gone = std::move(found->second);
+                this->links.erase(found);
+                last = this->links.empty();
+                if(last)
+                {
+                    this->link.control(RemoteMessage::Unsubscribe, this->channel, this->name);
+                }
+            }
+            if(last)
+            {
+                this->link.kick();
+            }
+        }
+
+        void disconnect(std::span<const idType> ids) override
+        {
+            for(const idType id: ids)
+            {
+                this->disconnect(id);
+            }
+        }
+
+        void setBlocked(const idType id, const bool blocked) override
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            typename std::unordered_map<idType, Connection<Args...>>::iterator found = this->links.find(id);
+            if(found != this->links.end())
+            {
+                blocked ? found->second.block() : found->second.unblock();
+            }
+        }
+
+        void setBlocked(std::span<const idType> ids, const bool blocked) override
+        {
+            for(const idType id: ids)
+            {
+                this->setBlocked(id, blocked);
+            }
+        }
+    };
+
+    /**
+     * @brief Remote end of a published signal: one connection to it per subscribed channel of the peer.
+     * @tparam Policy Policy of the published signal.
+     * @tparam Args Parameters of the published signal.
+     */
+    template<typename Policy, typename... Args>
+    class PublishedSignal : public RemoteOutbound
+    {
+    public:
+        PublishedSignal(RemoteLink & link, BasicSignal<Policy, Args...> & signal) : link(link), signal(signal) {}
+
+        void subscribe(const std::uint64_t channel) override
+        {
+            this->remotes[channel] = this->signal.connect([link = &this->link, channel](const Args&... args) {
+                link->send(channel, args...);
+            });
+        }
+
+        void unsubscribe(const std::uint64_t channel) override
+        {
+            this->remotes.erase(channel);
+        }
+
+    private:
+        RemoteLink & link;
+        BasicSignal<Policy, Args...> & signal;
+        /**
+         * @brief Only touched with the channels lock of the link held.
+         */
+        std::unordered_map<std::uint64_t, Connection<Args...>> remotes;
+    };
+}
+
+#endif //SIGNAL_REMOTE_SIGNAL_H
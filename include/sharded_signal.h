@@ -0,0 +1,408 @@
+#ifndef SIGNAL_SHARDED_SIGNAL_H
+#define SIGNAL_SHARDED_SIGNAL_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "topology.h"
+
+/**
+ * @brief How threads are spread over the shards of a @ref ShardedSignal.
+ */
+enum class ShardBy
+{
+    /**
+     * @brief One shard per CPU.
+     */
+    Core,
+    /**
+     * @brief One shard per NUMA node.
+     */
+    Node
+};
+
+/**
+ * @brief Which methods an emit of a @ref ShardedSignal reaches.
+ */
+enum class ShardDelivery
+{
+    /**
+     * @brief Methods of the emitting shard only: nothing outside the shard is read.
+     */
+    Local,
+    /**
+     * @brief Every method, reading the shard-local methods of the other shards too.
+     */
+    All
+};
+
+/**
+ * @brief Signal split in shards, one per CPU or NUMA node, so emits only read memory of their own shard.
+ *
+ * Each shard holds two signals: the methods connected with @ref BasicShardedSignal::connect(), copied
+ * into every shard, and the methods connected to this shard only with @ref BasicShardedSignal::connectLocal().
+ * An emit picks the shard of the CPU running it. The default @ref ShardDelivery::Local delivery calls
+ * the copied methods and those local to the shard; @ref ShardDelivery::All also calls the local
+ * methods of the other shards. Connecting and disconnecting touch every shard, keep them off the hot path.
+ *
+ * Shards are allocated by the thread building the signal, unless a memory resource is given for each:
+ * give node local resources to keep each shard and its slot lists on its node.
+ * Priorities order the methods of a shard signal: the copied ones are called before the local ones.
+ * @tparam Policy Synchronization of each shard, see @ref SignalPolicy.
+ * @tparam Args All arguments that will be emited by the signal.
+ */
+template<typename Policy, typename... Args>
+class BasicShardedSignal : public SignalDetail::ConnectionTarget
+{
+using idType = SignalDetail::idType;
+using ShardSignal = BasicSignal<Policy, Args...>;
+
+public:
+    /**
+     * @brief Gives the memory resource of a shard, from its index (the NUMA node with @ref ShardBy::Node).
+     */
+    using ResourceFor = std::pmr::memory_resource * (*)(std::size_t shard);
+
+    /**
+     * @brief Shards following the machine topology.
+     * @param by One shard per CPU or per NUMA node.
+     * @param resourceFor Memory resource of each shard, the default one if null.
+     *
+     * @code{.cpp}
+     * ShardedSignal<int> s(ShardBy::Node, [](std::size_t node) { return nodeResource(node); });
+     * @endcode
+     */
+    explicit BasicShardedSignal(const ShardBy by = ShardBy::Node, const ResourceFor resourceFor = nullptr)
+    {
+        const SignalDetail::CpuTopology & topology = SignalDetail::CpuTopology::instance();
+        this->shardOfCpu.resize(topology.cpuCount());
+        for(std::size_t cpu = 0; cpu < this->shardOfCpu.size(); ++cpu)
+        {
+            this->shardOfCpu[cpu] = by == ShardBy::Core ? cpu : topology.nodeOf(cpu);
+        }
+        this->build(by == ShardBy::Core ? topology.cpuCount() : topology.nodeCount(), resourceFor);
+    }
+
+    /**
+     * @brief A fixed number of shards, CPU n using shard n % count.
+     * @param count Number of shards, at least 1.
+     * @param resourceFor Memory resource of each shard, the default one if null.
+     */
+    explicit BasicShardedSignal(const std::size_t count, const ResourceFor resourceFor = nullptr)
+    {
+        const std::size_t shards = count == 0 ? 1 : count;
+        this->shardOfCpu.resize(SignalDetail::CpuTopology::instance().cpuCount());
+        for(std::size_t cpu = 0; cpu < this->shardOfCpu.size(); ++cpu)
+        {
+            this->shardOfCpu[cpu] = cpu % shards;
+        }
+        this->build(shards, resourceFor);
+    }
+
+    /**
+     * @brief Deleted. Connections point to the signal.
+     */
+    BasicShardedSignal(const BasicShardedSignal &) = delete;
+
+    /**
+     * @brief Deleted. Connections point to the signal.
+     */
+    BasicShardedSignal & operator=(const BasicShardedSignal &) = delete;
+
+    /**
+     * @brief Disconnect everything before the shards go.
+     */
+    ~BasicShardedSignal()
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->links.clear();
+    }
+
+    /**
+     * @brief Number of shards.
+     */
+    std::size_t size() const
+    {
+        return this->shards.size();
+    }
+
+    /**
+     * @brief Shard of the CPU running the calling thread. Only a hint unless the thread is pinned.
+     * @return Index of the shard.
+     */
+    std::size_t localShard() const
+    {
+        const std::size_t cpu = SignalDetail::CpuTopology::currentCpu();
+        return cpu < this->shardOfCpu.size() ? this->shardOfCpu[cpu] : cpu % this->shards.size();
+    }
+
+    /**
+     * @brief Connect a method to every shard, see @ref BasicSignal::connect().
+     * The method is copied into each shard, so every emit reaches it without leaving its shard.
+     * @param connectArgs What @ref BasicSignal::connect() takes, copied for each shard.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void main() {
+     *  ShardedSignal<int> s;
+     *  Connection c = s.connect([](int){ ... });
+     * }
+     * @endcode
+     */
+    template<typename... ConnectArgs>
+    requires requires(ShardSignal & s, ConnectArgs&... a) { s.connect(a...); }
+    Connection<Args...> connect(ConnectArgs&&... connectArgs)
+    {
+        std::vector<Connection<Args...>> made;
+        made.reserve(this->shards.size());
+        for(const ShardPtr & shard: this->shards)
+        {
+            made.push_back(shard->every.connect(connectArgs...));
+        }
+        return this->link(std::move(made));
+    }
+
+    /**
+     * @brief Connect a method to one shard: only emits of that shard, or with @ref ShardDelivery::All, reach it.
+     * @param shard Index of the shard, below @ref BasicShardedSignal::size().
+     * @param connectArgs What @ref BasicSignal::connect() takes.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     */
+    template<typename... ConnectArgs>
+    requires requires(ShardSignal & s, ConnectArgs&&... a) { s.connect(std::forward<ConnectArgs>(a)...); }
+    Connection<Args...> connectShard(const std::size_t shard, ConnectArgs&&... connectArgs)
+    {
+        std::vector<Connection<Args...>> made;
+        made.push_back(this->shards[shard]->own.connect(std::forward<ConnectArgs>(connectArgs)...));
+        return this->link(std::move(made));
+    }
+
+    /**
+     * @brief Connect a method to the shard of the calling thread, see @ref BasicShardedSignal::connectShard().
+     * @param connectArgs What @ref BasicSignal::connect() takes.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void worker(ShardedSignal<Order> & orders) {
+     *  pin(std::this_thread);
+     *  Connection c = orders.connectLocal([](const Order &){ ... });
+     * }
+     * @endcode
+     */
+    template<typename... ConnectArgs>
+    requires requires(ShardSignal & s, ConnectArgs&&... a) { s.connect(std::forward<ConnectArgs>(a)...); }
+    Connection<Args...> connectLocal(ConnectArgs&&... connectArgs)
+    {
+        return this->connectShard(this->localShard(), std::forward<ConnectArgs>(connectArgs)...);
+    }
+
+    /**
+     * @brief emit Call the methods of the shard of the calling thread, see @ref ShardDelivery::Local.
+     * @param args Signal parameters.
+     */
+    void emit(const Args&... args)
+    {
+        this->emitOn(this->localShard(), ShardDelivery::Local, args...);
+    }
+
+    /**
+     * @brief emit Same as @ref BasicShardedSignal::emit(const Args&...), choosing which methods are reached.
+     * @param delivery Methods of this shard only, or every method.
+     * @param args Signal parameters.
+     */
+    void emit(const ShardDelivery delivery, const Args&... args)
+    {
+        this->emitOn(this->localShard(), delivery, args...);
+    }
+
+    /**
+     * @brief Emit from a given shard, for threads that know where they run.
+     * @param shard Index of the shard, below @ref BasicShardedSignal::size().
+     * @param delivery Methods of this shard only, or every method.
+     * @param args Signal parameters.
+     */
+    void emitOn(const std::size_t shard, const ShardDelivery delivery, const Args&... args)
+    {
+        Shard & local = *this->shards[shard];
+        local.every.emit(args...);
+        local.own.emit(args...);
+        if(delivery == ShardDelivery::All)
+        {
+            for(std::size_t other = 0; other < this->shards.size(); ++other)
+            {
+                if(other != shard)
+                {
+                    this->shards[other]->own.emit(args...);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Same as @ref BasicShardedSignal::emit(const Args&...).
+     * @param args Signal parameters.
+     */
+    void operator()(const Args&... args)
+    {
+        this->emit(args...);
+    }
+
+    /**
+     * @brief disconnectAll Disconnect all methods, of every shard.
+     */
+    void disconnectAll()
+    {
+        std::unordered_map<idType, std::vector<Connection<Args...>>> gone;
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            gone.swap(this->links);
+        }
+    }
+
+private:
+    /**
+     * @brief Signals of a shard, on their own cache lines.
+     */
+    struct alignas(64) Shard
+    {
+        explicit Shard(std::pmr::memory_resource * resource) : every(resource), own(resource) {}
+
+        /**
+         * @brief Methods copied into every shard.
+         */
+        ShardSignal every;
+        /**
+         * @brief Methods of this shard only.
+         */
+        ShardSignal own;
+    };
+
+    /**
+     * @brief Gives a shard back to the resource it was allocated from.
+     */
+    struct ShardDeleter
+    {
+        std::pmr::memory_resource * resource;
+
+        void operator()(Shard * shard) const
+        {
+            shard->~Shard();
+            this->resource->deallocate(shard, sizeof(Shard), alignof(Shard));
+        }
+    };
+
+    using ShardPtr = std::unique_ptr<Shard, ShardDeleter>;
+
+    std::vector<ShardPtr> shards;
+    /**
+     * @brief Shard of each CPU.
+     */
+    std::vector<std::size_t> shardOfCpu;
+    /**
+     * @brief mtx Protects links, never taken by emit.
+     */
+    std::mutex mtx;
+    /**
+     * @brief Connections to the shard signals, by id of the connection given out.
+     */
+    std::unordered_map<idType, std::vector<Connection<Args...>>> links;
+    idType nextId = 1;
+
+    void build(const std::size_t count, const ResourceFor resourceFor)
+    {
+        this->shards.reserve(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            std::pmr::memory_resource * resource = resourceFor != nullptr ? resourceFor(i) : std::pmr::get_default_resource();
+            void * memory = resource->allocate(sizeof(Shard), alignof(Shard));
+            this->shards.push_back(ShardPtr(new (memory) Shard(resource), ShardDeleter{resource}));
+        }
+    }
+
+    Connection<Args...> link(std::vector<Connection<Args...>> && made)
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        const idType id = this->nextId++;
+        this->links.emplace(id, std::move(made));
+        return Connection<Args...>(this, id);
+    }
+
+    void disconnect(const idType id) override
+    {
+        std::vector<Connection<Args...>> gone;
+        std::lock_guard<std::mutex> lock(this->mtx);
+        auto it = this->links.find(id);
+        if(it != this->links.end())
+        {
+            gone = std::move(it->second);
+            this->links.erase(it);
+        }
+    }
+
+    void disconnect(std::span<const idType> ids) override
+    {
+        for(const idType id: ids)
+        {
+            this->disconnect(id);
+        }
+    }
+
+    void setBlocked(std::span<const idType> ids, const bool blocked) override
+    {
+        for(const idType id: ids)
+        {
+            this->setBlocked(id, blocked);
+        }
+    }
+
+    void setBlocked(const idType id, const bool blocked) override
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        auto it = this->links.find(id);
+        if(it != this->links.end())
+        {
+            for(Connection<Args...> & connection: it->second)
+            {
+                blocked ? connection.block() : connection.unblock();
+            }
+        }
+    }
+};
+
+/**
+ * @brief Sharded signal, see @ref BasicShardedSignal. Shards use @ref SignalPolicy::LockFree,
+ * as threads of a shard still emit concurrently; give another policy as first parameter to change it.
+ * @tparam Args All arguments that will be emited by the signal.
+ *
+ * @code{.cpp}
+ * ShardedSignal<int> s;
+ * ShardedSignal<SignalPolicy::Mutex, int> s2(ShardBy::Core);
+ * @endcode
+ */
+template<typename... Args>
+class ShardedSignal : public BasicShardedSignal<SignalPolicy::LockFree, Args...>
+{
+public:
+    using BasicShardedSignal<SignalPolicy::LockFree, Args...>::BasicShardedSignal;
+};
+
+/**
+ * @brief Sharded signal with an explicit synchronization policy for its shards.
+ * @tparam Policy One of @ref SignalPolicy.
+ * @tparam Args All arguments that will be emited by the signal.
+ */
+template<SignalConcepts::SyncPolicy Policy, typename... Args>
+class ShardedSignal<Policy, Args...> : public BasicShardedSignal<Policy, Args...>
+{
+public:
+    using BasicShardedSignal<Policy, Args...>::BasicShardedSignal;
+};
+
+#endif //SIGNAL_SHARDED_SIGNAL_H
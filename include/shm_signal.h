@@ -0,0 +1,606 @@
+#ifndef SIGNAL_SHM_SIGNAL_H
+#define SIGNAL_SHM_SIGNAL_H
+
+#if defined(__linux__)
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "function.h"
+
+namespace SignalDetail {
+
+    /**
+     * @brief Written last by the producer: a segment holding it is ready to use.
+     */
+    inline constexpr std::uint64_t shmMagic = 0x53484d5349474e31;
+
+    /**
+     * @brief Cursor of a consumer, on its own cache line.
+     */
+    struct alignas(64) ShmConsumer
+    {
+        /**
+         * @brief Next sequence the consumer reads. Everything before it may be overwritten.
+         */
+        std::atomic<std::uint64_t> cursor{0};
+        /**
+         * @brief 0 free, 1 reading, 2 being claimed.
+         */
+        std::atomic<std::uint32_t> state{0};
+        std::atomic<pid_t> pid{0};
+    };
+
+    /**
+     * @brief Start of a shared segment, followed by the consumers then the ring slots.
+     */
+    struct ShmHeader
+    {
+        std::atomic<std::uint64_t> magic{0};
+        std::uint64_t layout = 0;
+        std::uint64_t capacity = 0;
+        std::uint64_t stride = 0;
+        std::uint64_t consumers = 0;
+        /**
+         * @brief Next sequence the producer writes, everything before it is readable.
+         */
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        /**
+         * @brief Futex word, bumped when a waiting consumer has to look again.
+         */
+        alignas(64) std::atomic<std::uint32_t> wakeups{0};
+        std::atomic<std::uint32_t> waiters{0};
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+                  "Shared memory signals need lock free atomics");
+
+    /**
+     * @brief Where each argument lives in a ring slot, and a fingerprint of the types to check both ends agree.
+     * @tparam Args Trivially copyable arguments.
+     */
+    template<typename... Args>
+    struct ShmPayload
+    {
+        static constexpr std::array<std::size_t, sizeof...(Args)> offsets = []() {
+            std::array<std::size_t, sizeof...(Args)> out{};
+            std::size_t at = 0;
+            std::size_t k = 0;
+            ((at = (at + alignof(Args) - 1) / alignof(Args) * alignof(Args), out[k++] = at, at += sizeof(Args)), ...);
+            return out;
+        }();
+
+        static constexpr std::size_t size = []() {
+            std::size_t at = 0;
+            ((at = (at + alignof(Args) - 1) / alignof(Args) * alignof(Args) + sizeof(Args)), ...);
+            return at;
+        }();
+
+        /**
+         * @brief Slot size, whole cache lines so a consumer reading a slot doesn't share a line with the next write.
+         */
+        static constexpr std::size_t stride = size == 0 ? 64 : (size + 63) / 64 * 64;
+
+        static constexpr std::uint64_t layout = []() {
+            std::uint64_t hash = 14695981039346656037ull;
+            ((hash = (hash ^ sizeof(Args)) * 1099511628211ull, hash = (hash ^ alignof(Args)) * 1099511628211ull), ...);
+            return (hash ^ sizeof...(Args)) * 1099511628211ull;
+        }();
+    };
+
+    inline void futexWait(std::atomic<std::uint32_t> & word, const std::uint32_t expected, const timespec * timeout)
+    {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+    }
+
+    inline void futexWake(std::atomic<std::uint32_t> & word)
+    {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    /**
+     * @brief A mapped POSIX shared memory object, unmapped on destruction.
+     */
+    class ShmMapping
+    {
+    public:
+        /**
+         * @brief Create the object, replacing any stale one of the same name, and map it.
+         * @throw std::system_error If the object can't be created or mapped.
+         */
+        static ShmMapping create(const std::string & name, const std::size_t size)
+        {
+            shm_unlink(name.c_str());
+            const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if(fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+            }
+            if(ftruncate(fd, static_cast<off_t>(size)) != 0)
+            {
+                const int error = errno;
+                close(fd);
+                shm_unlink(name.c_str());
+                throw std::system_error(error, std::generic_category(), "ftruncate " + name);
+            }
+            return ShmMapping(fd, size, name);
+        }
+
+        /**
+         * @brief Map an existing object.
+         * @throw std::system_error If the object doesn't exist or can't be mapped.
+         */
+        static ShmMapping open(const std::string & name)
+        {
+            const int fd = shm_open(name.c_str(), O_RDWR, 0);
+            if(fd < 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+            }
+            const off_t size = lseek(fd, 0, SEEK_END);
+            if(size < static_cast<off_t>(sizeof(ShmHeader)))
+            {
+                close(fd);
+                throw std::system_error(EPROTO, std::generic_category(), "shm_open " + name);
+            }
+            return ShmMapping(fd, static_cast<std::size_t>(size), {});
+        }
+
+        ShmMapping(ShmMapping && other) noexcept
+            : memory(std::exchange(other.memory, nullptr)), size(other.size), owned(std::move(other.owned)) {}
+
+        ShmMapping(const ShmMapping &) = delete;
+        ShmMapping & operator=(const ShmMapping &) = delete;
+        ShmMapping & operator=(ShmMapping &&) = delete;
+
+        /**
+         * @brief Unmap, and remove the name if this mapping created it. Other mappings keep working.
+         */
+        ~ShmMapping()
+        {
+            if(this->memory)
+            {
+                munmap(this->memory, this->size);
+            }
+            if(!this->owned.empty())
+            {
+                shm_unlink(this->owned.c_str());
+            }
+        }
+
+        std::byte * data() const
+        {
+            return static_cast<std::byte *>(this->memory);
+        }
+
+        std::size_t bytes() const
+        {
+            return this->size;
+        }
+
+    private:
+        void * memory;
+        std::size_t size;
+        /**
+         * @brief Name to unlink on destruction, empty if not the creator.
+         */
+        std::string owned;
+
+        ShmMapping(const int fd, const std::size_t size, std::string owned)
+            : memory(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)), size(size), owned(std::move(owned))
+        {
+            const int error = errno;
+            close(fd);
+            if(this->memory == MAP_FAILED)
+            {
+                this->memory = nullptr;
+                if(!this->owned.empty())
+                {
+                    shm_unlink(this->owned.c_str());
+                }
+                throw std::system_error(error, std::generic_category(), "mmap");
+            }
+        }
+    };
+
+    /**
+     * @brief Segment layout: header, consumers, then the slots.
+     */
+    inline constexpr std::size_t shmConsumersOffset = (sizeof(ShmHeader) + 63) / 64 * 64;
+
+    inline ShmConsumer * shmConsumers(std::byte * base)
+    {
+        return std::launder(reinterpret_cast<ShmConsumer *>(base + shmConsumersOffset));
+    }
+
+    inline std::byte * shmSlots(std::byte * base, const std::size_t consumers)
+    {
+        return base + shmConsumersOffset + consumers * sizeof(ShmConsumer);
+    }
+}
+
+/**
+ * @brief Producer side of a signal shared between processes of the same host.
+ *
+ * Emits copy the arguments into a single producer, multi consumer ring buffer in POSIX shared memory.
+ * Each @ref ShmReceiver has its own cursor in the segment and calls the methods of a local signal with
+ * references into the ring: nothing is copied on the consumer side, and the slot is only reused once
+ * every consumer moved past it. A full ring makes @ref ShmSignal::emit() wait for the slowest consumer;
+ * consumers of processes that died are dropped then. Waiting consumers sleep on a futex, woken by the
+ * emit that follows.
+ *
+ * A single thread emits at a time. Linux only.
+ * @code{.cpp}
+ * //Producer process.
+ * ShmSignal<Tick> ticks("/ticks", 4096);
+ * ticks.emit(tick);
+ *
+ * //Consumer process.
+ * Signal<Tick> local;
+ * Connection c = local.connect(&book, &Book::update);
+ * ShmReceiver<Tick> receiver("/ticks", local);
+ * receiver.run();
+ * @endcode
+ * @tparam Args Arguments of the signal, trivially copyable.
+ */
+template<typename... Args>
+class ShmSignal
+{
+    static_assert((std::is_trivially_copyable_v<Args> && ...), "ShmSignal arguments must be trivially copyable");
+    static_assert(((alignof(Args) <= 64) && ...), "ShmSignal arguments must not be aligned on more than a cache line");
+
+using Payload = SignalDetail::ShmPayload<Args...>;
+
+public:
+    /**
+     * @brief Create the shared segment, replacing a stale one of the same name.
+     * @param name Name of the POSIX shared memory object, like "/ticks".
+     * @param capacity Number of slots, rounded up to a power of 2.
+     * @param consumers Maximum number of receivers at a time.
+     * @throw std::system_error If the segment can't be created.
+     */
+    explicit ShmSignal(std::string_view name, const std::size_t capacity = 1024, const std::size_t consumers = 8)
+        : mapping(SignalDetail::ShmMapping::create(std::string(name), bytes(roundUp(capacity), consumers)))
+    {
+        std::byte * base = this->mapping.data();
+        this->header = ::new(base) SignalDetail::ShmHeader();
+        this->header->layout = Payload::layout;
+        this->header->capacity = roundUp(capacity);
+        this->header->stride = Payload::stride;
+        this->header->consumers = consumers;
+        this->readers = SignalDetail::shmConsumers(base);
+        for(std::size_t k = 0; k < consumers; ++k)
+        {
+            ::new(base + SignalDetail::shmConsumersOffset + k * sizeof(SignalDetail::ShmConsumer)) SignalDetail::ShmConsumer();
+        }
+        this->slots = SignalDetail::shmSlots(base, consumers);
+        this->mask = this->header->capacity - 1;
+        this->header->magic.store(SignalDetail::shmMagic, std::memory_order_release);
+    }
+
+    /**
+     * @brief Deleted. Only one producer per segment.
+     */
+    ShmSignal(const ShmSignal &) = delete;
+
+    /**
+     * @brief Deleted. Only one producer per segment.
+     */
+    ShmSignal & operator=(const ShmSignal &) = delete;
+
+    /**
+     * @brief Send to every receiver, waiting for room if the ring is full.
+     * @param args Arguments, copied into the ring.
+     */
+    void emit(const Args&... args)
+    {
+        for(unsigned spin = 0; !this->tryEmit(args...); ++spin)
+        {
+            if(spin >= 64)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief Send to every receiver, unless the ring is full.
+     * @param args Arguments, copied into the ring.
+     * @return Whether the arguments were sent.
+     */
+    bool tryEmit(const Args&... args)
+    {
+        const std::uint64_t head = this->header->head.load(std::memory_order_relaxed);
+        if(head - this->slowest >= this->header->capacity)
+        {
+            this->slowest = this->scan(head);
+            if(head - this->slowest >= this->header->capacity)
+            {
+                return false;
+            }
+        }
+        std::byte * slot = this->slots + (head & this->mask) * Payload::stride;
+        this->write(slot, std::index_sequence_for<Args...>{}, args...);
+        this->header->head.store(head + 1, std::memory_order_seq_cst);
+        if(this->header->waiters.load(std::memory_order_seq_cst) != 0)
+        {
+            this->header->wakeups.fetch_add(1, std::memory_order_seq_cst);
+            SignalDetail::futexWake(this->header->wakeups);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Number of receivers attached.
+     */
+    std::size_t receivers() const
+    {
+        std::size_t count = 0;
+        for(std::size_t k = 0; k < this->header->consumers; ++k)
+        {
+            count += this->readers[k].state.load(std::memory_order_acquire) == 1;
+        }
+        return count;
+    }
+
+private:
+    SignalDetail::ShmMapping mapping;
+    SignalDetail::ShmHeader * header;
+    SignalDetail::ShmConsumer * readers;
+    std::byte * slots;
+    std::uint64_t mask;
+    /**
+     * @brief Lowest cursor seen by the last scan, only rescanned once the ring looks full.
+     */
+    std::uint64_t slowest = 0;
+
+    static std::size_t roundUp(const std::size_t capacity)
+    {
+        std::size_t out = 1;
+        while(out < capacity)
+        {
+            out <<= 1;
+        }
+        return out;
+    }
+
+    static std::size_t bytes(const std::size_t capacity, const std::size_t consumers)
+    {
+        return SignalDetail::shmConsumersOffset + consumers * sizeof(SignalDetail::ShmConsumer) + capacity * Payload::stride;
+    }
+
+    template<std::size_t... I>
+    static void write(std::byte * slot, std::index_sequence<I...>, const Args&... args)
+    {
+        (std::memcpy(slot + Payload::offsets[I], std::addressof(args), sizeof(Args)), ...);
+    }
+
+    /**
+     * @brief Lowest cursor of the attached receivers, dropping those of dead processes.
+     * @param head Next sequence to write, returned if there is no receiver.
+     */
+    std::uint64_t scan(const std::uint64_t head)
+    {
+        std::uint64_t lowest = head;
+        for(std::size_t k = 0; k < this->header->consumers; ++k)
+        {
+            SignalDetail::ShmConsumer & reader = this->readers[k];
+            if(reader.state.load(std::memory_order_seq_cst) != 1)
+            {
+                continue;
+            }
+            const std::uint64_t cursor = reader.cursor.load(std::memory_order_acquire);
+            if(head - cursor >= this->header->capacity && kill(reader.pid.load(std::memory_order_relaxed), 0) != 0 && errno == ESRCH)
+            {
+                std::uint32_t reading = 1;
+                reader.state.compare_exchange_strong(reading, 0, std::memory_order_acq_rel);
+                continue;
+            }
+            lowest = head - cursor > head - lowest ? cursor : lowest;
+        }
+        return lowest;
+    }
+};
+
+/**
+ * @brief Consumer side of a @ref ShmSignal: emits every received event on a local signal.
+ * Methods are called by the thread calling @ref ShmReceiver::poll() or @ref ShmReceiver::run(),
+ * with references into the shared ring, valid during the call only.
+ * A receiver sees the events emitted after it attached.
+ * @tparam Args Arguments of the signal, same as the producer.
+ */
+template<typename... Args>
+class ShmReceiver
+{
+    static_assert((std::is_trivially_copyable_v<Args> && ...), "ShmSignal arguments must be trivially copyable");
+
+using Payload = SignalDetail::ShmPayload<Args...>;
+
+public:
+    /**
+     * @brief Attach to a segment created by a @ref ShmSignal.
+     * @param name Name given to the producer.
+     * @param target Signal emitted for each event, or anything with an emit(const Args&...), kept by reference.
+     * @throw std::system_error If the segment doesn't exist.
+     * @throw std::runtime_error If the segment is not ready, holds other arguments, or has no free receiver.
+     */
+    template<typename Target>
+        requires requires(Target & t, const Args&... args) { t.emit(args...); }
+    ShmReceiver(std::string_view name, Target & target)
+        : mapping(SignalDetail::ShmMapping::open(std::string(name))),
+          target([&target](const Args&... args) { target.emit(args...); })
+    {
+        std::byte * base = this->mapping.data();
+        this->header = std::launder(reinterpret_cast<SignalDetail::ShmHeader *>(base));
+        if(this->header->magic.load(std::memory_order_acquire) != SignalDetail::shmMagic)
+        {
+            throw std::runtime_error("ShmReceiver: segment not ready");
+        }
+        if(this->header->layout != Payload::layout || this->header->stride != Payload::stride)
+        {
+            throw std::runtime_error("ShmReceiver: segment made for other arguments");
+        }
+        this->slots = SignalDetail::shmSlots(base, this->header->consumers);
+        this->mask = this->header->capacity - 1;
+        this->attach(SignalDetail::shmConsumers(base));
+    }
+
+    /**
+     * @brief Deleted. The cursor belongs to this receiver.
+     */
+    ShmReceiver(const ShmReceiver &) = delete;
+
+    /**
+     * @brief Deleted. The cursor belongs to this receiver.
+     */
+    ShmReceiver & operator=(const ShmReceiver &) = delete;
+
+    /**
+     * @brief Detach, freeing the producer from waiting on this receiver.
+     */
+    ~ShmReceiver()
+    {
+        this->reader->state.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Emit every event received so far on the local signal.
+     * @return Number of events emitted.
+     */
+    std::size_t poll()
+    {
+        const std::uint64_t head = this->header->head.load(std::memory_order_acquire);
+        const std::uint64_t from = this->cursor;
+        while(this->cursor != head)
+        {
+            this->deliver(this->slots + (this->cursor & this->mask) * Payload::stride, std::index_sequence_for<Args...>{});
+            ++this->cursor;
+            //The slot is free once the methods returned.
+            this->reader->cursor.store(this->cursor, std::memory_order_release);
+        }
+        return head - from;
+    }
+
+    /**
+     * @brief Sleep until an event is received, the timeout is reached or @ref ShmReceiver::stop() is called.
+     * @param timeout Longest wait, negative to wait without limit.
+     * @return Whether an event is waiting.
+     */
+    bool wait(const std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1))
+    {
+        if(this->ready())
+        {
+            return true;
+        }
+        timespec limit{};
+        limit.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+        limit.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+        this->header->waiters.fetch_add(1, std::memory_order_seq_cst);
+        const std::uint32_t seen = this->header->wakeups.load(std::memory_order_seq_cst);
+        if(!this->ready() && !this->stopped.load(std::memory_order_acquire))
+        {
+            SignalDetail::futexWait(this->header->wakeups, seen, timeout.count() < 0 ? nullptr : &limit);
+        }
+        this->header->waiters.fetch_sub(1, std::memory_order_seq_cst);
+        return this->ready();
+    }
+
+    /**
+     * @brief Emit events as they come until @ref ShmReceiver::stop().
+     */
+    void run()
+    {
+        while(!this->stopped.load(std::memory_order_acquire))
+        {
+            if(this->wait())
+            {
+                this->poll();
+            }
+        }
+        this->stopped.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Make @ref ShmReceiver::run() return, from any thread.
+     */
+    void stop()
+    {
+        this->stopped.store(true, std::memory_order_release);
+        //Wakes the other receivers of the segment too, they only look again.
+        this->header->wakeups.fetch_add(1, std::memory_order_seq_cst);
+        SignalDetail::futexWake(this->header->wakeups);
+    }
+
+private:
+    SignalDetail::ShmMapping mapping;
+    MoveOnlyFunction<void(const Args&...)> target;
+    SignalDetail::ShmHeader * header = nullptr;
+    SignalDetail::ShmConsumer * reader = nullptr;
+    std::byte * slots = nullptr;
+    std::uint64_t mask = 0;
+    /**
+     * @brief Next sequence to read, mirrored in the shared cursor.
+     */
+    std::uint64_t cursor = 0;
+    std::atomic<bool> stopped{false};
+
+    bool ready() const
+    {
+        return this->header->head.load(std::memory_order_seq_cst) != this->cursor;
+    }
+
+    /**
+     * @brief Claim a free cursor, starting at the current head.
+     */
+    void attach(SignalDetail::ShmConsumer * readers)
+    {
+        for(std::size_t k = 0; k < this->header->consumers; ++k)
+        {
+            std::uint32_t free = 0;
+            if(readers[k].state.compare_exchange_strong(free, 2, std::memory_order_acq_rel))
+            {
+                this->reader = &readers[k];
+                this->reader->pid.store(getpid(), std::memory_order_relaxed);
+                this->reader->cursor.store(this->header->head.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+                this->reader->state.store(1, std::memory_order_seq_cst);
+                //Read again once visible: a producer that didn't see this receiver hasn't gone past this head.
+                this->cursor = this->header->head.load(std::memory_order_seq_cst);
+                this->reader->cursor.store(this->cursor, std::memory_order_seq_cst);
+                return;
+            }
+        }
+        throw std::runtime_error("ShmReceiver: no free receiver in segment");
+    }
+
+    template<std::size_t... I>
+    void deliver(const std::byte * slot, std::index_sequence<I...>)
+    {
+        this->target(*std::launder(reinterpret_cast<const Args *>(slot + Payload::offsets[I]))...);
+    }
+};
+
+#endif
+
+#endif //SIGNAL_SHM_SIGNAL_H
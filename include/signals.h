@@ -1,29 +1,167 @@
 #ifndef SIGNAL_H
 #define SIGNAL_H
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <memory>
-#include <mutex>
-#include <unordered_map>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "coalescer.h"
+#include "combiner.h"
+#include "coroutine.h"
+#include "dispatch.h"
+#include "executor.h"
+#include "function.h"
+#include "instrumentation.h"
+#include "policy.h"
+#include "slot_pool.h"
+#include "slot_table.h"
+#include "static_signal.h"
+#include "thread_pool.h"
+
+template<typename Policy, typename... Args>
+class BasicSignal;
 
 template<typename... Args>
-class Signal;
+class Connection;
+
+class ConnectionGroup;
+
+namespace SignalDetail {
+
+    template<typename... Args>
+    class RemoteChannel;
+
+    /**
+     * @brief What a @ref Connection needs from its signal, whatever its policy.
+     */
+    class ConnectionTarget
+    {
+    template<typename...> friend class ::Connection;
+    friend class ::ConnectionGroup;
+
+    protected:
+        ~ConnectionTarget() = default;
+
+        /**
+         * @brief Disconnect the method with the id key.
+         * @param id Id of the method.
+         */
+        virtual void disconnect(const idType id) = 0;
+
+        /**
+         * @brief Disconnect several methods with a single change of the slot list.
+         * @param ids Ids of the methods.
+         */
+        virtual void disconnect(std::span<const idType> ids) = 0;
+
+        /**
+         * @brief Change if a method is blocked by id.
+         * @param id Id of the method.
+         * @param blocked true/false.
+         */
+        virtual void setBlocked(const idType id, const bool blocked) = 0;
+
+        /**
+         * @brief Change if several methods are blocked with a single change of the slot list.
+         * @param ids Ids of the methods.
+         * @param blocked true/false.
+         */
+        virtual void setBlocked(std::span<const idType> ids, const bool blocked) = 0;
+    };
+
+    /**
+     * @brief State of a @ref Connection, whatever the signal parameters, and its links in a @ref ConnectionGroup.
+     * Groups are circular lists around a sentinel hook, so linking and unlinking are O(1) and never allocate.
+     */
+    class ConnectionHook
+    {
+    friend class ::ConnectionGroup;
+
+    protected:
+        ConnectionHook() = default;
+        ConnectionHook(ConnectionTarget * s, const idType id) : id(id), sig(s) {}
+
+        /**
+         * @brief id Method id.
+         */
+        idType id = 0;
+        /**
+         * @brief sig Pointer to signal.
+         */
+        ConnectionTarget * sig = nullptr;
+
+        bool linked() const
+        {
+            return this->next != nullptr;
+        }
+
+        /**
+         * @brief Insert before another hook of a group.
+         */
+        void linkBefore(ConnectionHook * hook)
+        {
+            this->prev = hook->prev;
+            this->next = hook;
+            hook->prev->next = this;
+            hook->prev = this;
+        }
+
+        void unlink()
+        {
+            if(this->linked())
+            {
+                this->prev->next = this->next;
+                this->next->prev = this->prev;
+                this->prev = nullptr;
+                this->next = nullptr;
+            }
+        }
+
+        /**
+         * @brief Take the place of a moved from hook in its group.
+         */
+        void replace(ConnectionHook & other)
+        {
+            if(other.linked())
+            {
+                this->linkBefore(&other);
+                other.unlink();
+            }
+        }
+
+    private:
+        ConnectionHook * prev = nullptr;
+        ConnectionHook * next = nullptr;
+    };
+}
 
 /**
  * @brief The Connection class is a de-connection manager.
- * It's a result of all connect function from @ref Signal.
+ * It's a result of all connect function from @ref BasicSignal.
  * The generated Connection must be kept, else it could disconnect automatically because of its destructor.
  * @tparam Args Signal parameters.
  */
 template<typename... Args>
-class [[nodiscard ("rvalue must be kept, else will directly disconnect")]] Connection
+class [[nodiscard ("rvalue must be kept, else will directly disconnect")]] Connection : private SignalDetail::ConnectionHook
 {
-friend class Signal<Args...>;
-using idType = Signal<Args...>::idType;
+template<typename, typename...> friend class BasicSignal;
+template<typename, typename...> friend class BasicShardedSignal;
+template<typename...> friend class SignalDetail::RemoteChannel;
+friend class ConnectionGroup;
+using idType = SignalDetail::idType;
 
 public:
     /**
-     * @brief Connection base constructor.
+     * @brief Connection base constructor. Not linked to any signal.
      */
     Connection() = default;
 
@@ -36,9 +174,10 @@ public:
      * @brief Connection move constructor.
      * @param other Another connection object. Will loose it's properties.
      */
-    Connection(Connection && other) noexcept : id(other.id), sig(other.sig)
+    Connection(Connection && other) noexcept : ConnectionHook(other.sig, other.id)
     {
         other.sig = nullptr;
+        this->replace(other);
     }
 
     /**
@@ -55,10 +194,11 @@ public:
     {
         if(this != &other)
         {
-            delete this->sig;
+            this->disconnect();
             this->id = other.id;
             this->sig = other.sig;
             other.sig = nullptr;
+            this->replace(other);
         }
         return *this;
     }
@@ -72,30 +212,39 @@ public:
     }
 
     /**
-     * @brief disconnect Unregister method from signal. It won't be call again during an @ref Signal::emit().
+     * @brief disconnect Unregister method from signal. It won't be call again during an @ref BasicSignal::emit().
+     * Also leaves its @ref ConnectionGroup.
      */
     void disconnect()
     {
         if(this->sig != nullptr)
         {
             this->sig->disconnect(this->id);
+            this->sig = nullptr;
         }
+        this->unlink();
     }
 
     /**
-     * @brief Let you block a method so it won't be called during @ref Signal::emit().
+     * @brief Let you block a method so it won't be called during @ref BasicSignal::emit().
      */
     void block()
     {
-        this->sig->setBlocked(this->id, true);
+        if(this->sig != nullptr)
+        {
+            this->sig->setBlocked(this->id, true);
+        }
     }
 
     /**
-     * @brief Let you unblock a method so it will be called again during @ref Signal::emit().
+     * @brief Let you unblock a method so it will be called again during @ref BasicSignal::emit().
      */
     void unblock()
     {
-        this->sig->setBlocked(this->id, false);
+        if(this->sig != nullptr)
+        {
+            this->sig->setBlocked(this->id, false);
+        }
     }
 
 private:
@@ -105,387 +254,1915 @@ private:
      * @param s Signal.
      * @param id Signal id.
      */
-    Connection(Signal<Args...> * s, idType id) : sig(s), id(id) {}
-
-    /**
-     * @brief id Method id.
-     */
-    idType id;
-    /**
-     * @brief sig Pointer to signal.
-     */
-    Signal<Args...> * sig;
-
+    Connection(SignalDetail::ConnectionTarget * s, idType id) : ConnectionHook(s, id) {}
 };
 
-namespace SignalConcepts {
-
-    /**
-     * @brief Verify that a method is invocable with @ref Signal arguments.
-     * @tparam Method Method to verify.
-     * @tparam AllArgs Parameters of the method.
-     */
-    template <typename Method, typename... AllArgs>
-    concept ValidMethod =
-        std::is_invocable_v<std::remove_reference_t<Method>, AllArgs...>
-    ;
-
-/**
-     * @brief Verify that a method is invocable with @ref Signal arguments et that it's a class method.
-     * @tparam T The class that must contain the method.
-     * @tparam Method Method to verify.
-     * @tparam AllArgs Parameters of the method.
-     */
-    template <typename T, typename Method, typename ...AllArgs>
-    concept ValidClassMethod =
-        std::is_invocable_v<std::remove_reference_t<Method>, T*, AllArgs...>
-     && std::is_member_function_pointer_v<std::decay_t<Method>>
-    ;
-}
-
-/**
- * @brief The Signal class. This is the Qt way to make the observer/observable pattern.
- * @tparam Args All arguments that will be emited by the signal.
- */
-template<typename... Args>
-class Signal
-{
-friend class Connection<Args...>;
-/**
- * @brief Alias for signal id type.
- */
-using idType = unsigned int;
-
 /**
- * @brief Representation to know if a method should be called when a signal is emitted. See @ref Signal::emit().
+ * @brief Disconnects together connections of any signals, for objects holding many of them.
+ *
+ * Connections stay owned by the caller, the group only links them: adding and removing never allocate,
+ * and a connection leaves its group when it is disconnected, destroyed or moved from.
+ * Tearing the group down disconnects each signal once for all its connections.
+ * Not thread safe, like @ref Connection.
+ *
+ * @code{.cpp}
+ * class View
+ * {
+ *     Connection<int> onResize;
+ *     Connection<> onClose;
+ *     //Declared last, so destroyed before the connections.
+ *     ConnectionGroup connections;
+ *
+ * public:
+ *     View(Window & w) : onResize(w.connect_resized(this, &View::resize)), onClose(w.connect_closed(this, &View::close))
+ *     {
+ *         this->connections.add(this->onResize);
+ *         this->connections.add(this->onClose);
+ *     }
+ * };
+ * @endcode
  */
-struct MethodType
+class ConnectionGroup
 {
-    std::function<void(Args...)> func;
-    bool isBlocked = false;
-};
+    /**
+     * @brief Ids disconnected at once from a signal.
+     */
+    static constexpr std::size_t chunk = 32;
 
 public:
+    ConnectionGroup()
+    {
+        this->head.prev = &this->head;
+        this->head.next = &this->head;
+    }
+
     /**
-     * @brief Signal Default constructor.
+     * @brief Deleted. Connections point to the group.
      */
-    Signal() = default;
+    ConnectionGroup(const ConnectionGroup &) = delete;
 
     /**
-     * @brief Connect a static method or a lambda to a signal.
-     * @param method Static method or lambda.
-     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
-     *
-     * @code{.cpp}
-     * void f(int){ ... }
-     *
-     * void main() {
-     *  Signal<int> s;
-     *  Foo foo;
-     *  Connection c = s.connect(&f);
-     *  //or
-     *  Connection c = s.connect(f);
-     *  //or
-     *  Connection c = s.connect([](int){ ... });
-     * }
-     * @endcode
+     * @brief Deleted. Connections point to the group.
      */
-    template<typename Method>
-    requires SignalConcepts::ValidMethod<Method, Args...>
-    Connection<Args...> connect(Method&& method) noexcept
-    {
-        idType id = this->getNewId();
-        this->addMethod(id, std::move(method));
-        return Connection<Args...>(this, id);
-    }
+    ConnectionGroup & operator=(const ConnectionGroup &) = delete;
 
     /**
-     * @brief Connect a class method to a signal.
-     * @param instance Class object.
-     * @param method Class method.
-     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
-     *
-     * @code{.cpp}
-     * class Foo {
-     *  void f(int){ ... }
-     * }
-     *
-     * void main() {
-     *  Signal<int> s;
-     *  Foo foo;
-     *  Connection c = s.connect(&foo, &Foo::f);
-     * }
-     * @endcode
+     * @brief Disconnect every connection of the group.
      */
-    template<typename T, typename Method>
-    requires SignalConcepts::ValidClassMethod<T, Method, Args...>
-    Connection<Args...> connect(T* instance, Method&& method) noexcept
+    ~ConnectionGroup()
     {
-        auto bound = [instance, method](Args... args) -> void { (instance->*method)(args...); };
-
-        return connect(std::move(bound));
+        this->disconnectAll();
     }
 
     /**
-     * @brief Connect a class method to a signal. Will auto disconnect if instance is not valid anymore.
-     * @param instance Shared pointer to the class object.
-     * @param method The class method.
-     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
-     *
-     * @code{.cpp}
-     * class Foo {
-     *  void f(int){ ... }
-     * }
-     *
-     * void main() {
-     *  Signal<int> s;
-     *  std::shared_ptr<Foo> foo = std::make_shared<Foo>();
-     *  Connection c = s.connect(foo, &Foo::f);
-     * }
-     * @endcode
+     * @brief Add a connection, removing it from any other group. Connections already disconnected are ignored.
+     * @param connection Connection to add, still owned by the caller.
      */
-    template<typename T, typename Method>
-    requires SignalConcepts::ValidClassMethod<T, Method, Args...>
-    Connection<Args...> connect(std::shared_ptr<T>& instance, Method&& method) noexcept
+    template<typename... Args>
+    void add(Connection<Args...> & connection)
     {
-        std::weak_ptr<T> wp(instance);
-        idType id = this->getNewId();
-
-        auto bound = [wp, method = std::forward<Method>(method), id, this](Args... args) {
-            if(auto sp = wp.lock())
-            {
-                //instance can't become invalide here, we made a shared from a weak ptr.
-                //=> we can be the last to reference the instance
-                //=> instance will be destroy at the end of this fonction in that case
-                //+ this lambda will be disconected next time.
-                ((*sp).*method)(args...);
-            }
-            else
-            {
-                this->disconnect(id);
-            }
-        };
-
-        this->addMethod(id, std::move(bound));
-        return Connection<Args...>(this, id);
+        SignalDetail::ConnectionHook & hook = connection;
+        if(hook.sig != nullptr)
+        {
+            hook.unlink();
+            hook.linkBefore(&this->head);
+        }
     }
 
     /**
-     * @brief Connect a method and bound its aguments from left to right.
-     * @param method Static method or lambda. Must return void and have parameters to bind and then the same parameters as the signal.
-     * @param boundArgs Values to bound arguments to. Be aware that if you want to bound a ref you should cast it explicitly with std::ref().
-     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
-     *
-     * @code{.cpp}
-     * void f(string, int){ ... }
-     *
-     * void main() {
-     *  Signal<int> s;
-     *  Foo foo;
-     *  Connection c = s.connect(&f, "bar");
-     *  //or
-     *  Connection c = s.connect(f, "bar");
-     *  //or
-     *  Connection c = s.connect([](int){ ... }, "bar");
-     * }
-     * @endcode
+     * @brief Remove a connection from the group without disconnecting it.
+     * @param connection Connection of the group.
      */
-    template<typename Method, typename... BoundArgs>
-    requires SignalConcepts::ValidMethod<Method, BoundArgs..., Args...>
-    Connection<Args...> connect(Method&& method, BoundArgs&&... boundArgs) noexcept
+    template<typename... Args>
+    void remove(Connection<Args...> & connection)
     {
-        return connect(
-            [method = std::forward<Method>(method),
-            ... bound = std::forward<BoundArgs>(boundArgs)](Args... args) mutable {
-            std::invoke(method, bound..., std::forward<Args>(args)...);
-            }
-        );
+        static_cast<SignalDetail::ConnectionHook &>(connection).unlink();
     }
 
     /**
-     * @brief Connect a class method and bound its aguments from left to right.
-     * @param instance Class instance.
-     * @param method Class method. Must return void and have parameters to bind and then the same parameters as the signal.
-     * @param boundArgs Values to bound arguments to. Be aware that if you want to bound a ref you should cast it explicitly with std::ref().
-     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
-     *
-     * @code{.cpp}
-     * class Foo {
-     *  void f(string, int){ ... }
-     * }
-     *
-     * void main() {
-     *  Signal<int> s;
-     *  Foo foo;
-     *  Connection c = s.connect(&foo, &foo::f, "bar");
-     * }
-     * @endcode
+     * @brief Whether the group has no connection.
+     * @return true if empty.
      */
-    template<typename T, typename Method, typename... BoundArgs>
-    requires SignalConcepts::ValidClassMethod<T, Method, BoundArgs..., Args...>
-    Connection<Args...> connect(T* instance, Method&& method, BoundArgs&&... boundArgs)
+    bool empty() const
     {
-        return connect(
-            [instance,
-             method = std::forward<Method>(method),
-             ... bound = std::forward<BoundArgs>(boundArgs)](Args&&... args) mutable {
-                std::invoke(method, instance, bound..., std::forward<Args>(args)...);
-            }
-        );
+        return this->head.next == &this->head;
     }
 
     /**
-     * @brief Connect a class method and bound its aguments from left to right.
-     *  Will auto disconnect if instance is not valid anymore.
-     * @param instance Shared pointer to class instance.
-     * @param method Class method. Must return void and have parameters to bind and then the same parameters as the signal.
-     * @param boundArgs Values to bound arguments to. Be aware that if you want to bound a ref you should cast it explicitly with std::ref().
-     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
-     *
-     * @code{.cpp}
-     * class Foo {
-     *  void f(string, int){ ... }
-     * }
-     *
-     * void main() {
-     *  Signal<int> s;
-     *  std::shared_ptr<Foo> foo = std::make_shared<Foo>();
-     *  Connection c = s.connect(foo, &foo::f, "bar");
-     * }
-     * @endcode
+     * @brief Disconnect every connection of the group, one slot list change per signal.
      */
-    template<typename T, typename Method, typename... BoundArgs>
-    requires SignalConcepts::ValidClassMethod<T, Method, BoundArgs..., Args...>
-    Connection<Args...> connect(std::shared_ptr<T>& instance, Method&& method, BoundArgs&&... boundArgs)
+    void disconnectAll()
     {
-        std::weak_ptr<T> wp(instance);
-        idType id = this->getNewId();
-
-        auto bound = [
-            wp,
-            method = std::move(method),
-            ...boundArgs = std::forward<BoundArgs>(boundArgs),
-            id, this]
-            (Args... args)
+        while(!this->empty())
         {
-            if(auto sp = wp.lock())
+            SignalDetail::ConnectionTarget * target = this->head.next->sig;
+            SignalDetail::idType ids[chunk];
+            std::size_t count = 0;
+            for(SignalDetail::ConnectionHook * hook = this->head.next; hook != &this->head;)
             {
-                ((*sp).*method)(boundArgs..., args...);
+                SignalDetail::ConnectionHook * next = hook->next;
+                if(hook->sig == target)
+                {
+                    ids[count++] = hook->id;
+                    hook->sig = nullptr;
+                    hook->unlink();
+                    if(count == chunk)
+                    {
+                        target->disconnect(std::span<const SignalDetail::idType>(ids, count));
+                        count = 0;
+                    }
+                }
+                hook = next;
             }
-            else
+            if(count != 0)
             {
-                this->disconnect(id);
+                target->disconnect(std::span<const SignalDetail::idType>(ids, count));
             }
-        };
-        this->addMethod(id, std::move(bound));
-        return Connection<Args...>(this, id);
+        }
     }
 
     /**
-     * @brief emit Call all connected methods.
-     * @param args Signal parameters, same type as template.
-     * @code
-     * void main() {
-     *  Signal<int> s;
-     *  s.emit(1);
-     * }
-     * @endcode
+     * @brief Block every connection of the group, one slot list change per signal.
      */
-    void emit(Args... args)
+    void blockAll()
     {
-        std::unique_lock<std::mutex> lock(mtx);
-        auto copy = this->methods;
-        lock.unlock();
-        for(auto & [id, method]: copy)
-        {
-            if(!method.isBlocked)
-            {
-                method.func(args...);
-            }
-        }
+        this->setBlocked(true);
     }
 
     /**
-     * @brief disconnectAll Disconnect all methods
-     * @code
-     * void main() {
-     *  Signal<int> s;
-     *  s.disconnectAll();
-     * }
-     * @endcode
+     * @brief Unblock every connection of the group, one slot list change per signal.
      */
-    void disconnectAll()
+    void unblockAll()
     {
-        std::lock_guard<std::mutex> lock(mtx);
-        this->methods.erase();
+        this->setBlocked(false);
     }
 
 private:
     /**
-     * @brief nextId The next id to use. Won't backtrack if a connection if deleted for example.
-     * Don't manipulate, use @ref Signal::getNewId()
-     */
-    idType nextId = 0;
-    /**
-     * @brief mtx Mutex for thread safety.
+     * @brief Sentinel of the circular list.
      */
-    std::mutex mtx;
-    /**
-     * @brief Store methods with an id for de-connection.
-     * Don't manipulate, use @ref Signal::addMethod(const idType id, Method&& method).
-     */
-    std::unordered_map<idType, MethodType> methods;
+    struct Head : SignalDetail::ConnectionHook {} head;
 
-    /**
-     * @brief Get next free id in a thread safe manner.
-     * @return A free id.
-     */
-    idType getNewId()
+    void setBlocked(const bool blocked)
     {
-        std::unique_lock<std::mutex> lock(mtx);
-        return this->nextId++;
-    }
-
-    /**
-     * @brief Disconnect the method with the id key.
-     * @param id Id of the method.
-     */
-    void disconnect(const idType id)
+        std::vector<std::pair<SignalDetail::ConnectionTarget *, SignalDetail::idType>> entries;
+        for(SignalDetail::ConnectionHook * hook = this->head.next; hook != &this->head; hook = hook->next)
+        {
+            entries.emplace_back(hook->sig, hook->id);
+        }
+        std::stable_sort(entries.begin(), entries.end(), [](const auto & a, const auto & b) { return std::less<>()(a.first, b.first); });
+        std::vector<SignalDetail::idType> ids;
+        for(std::size_t begin = 0; begin < entries.size();)
+        {
+            std::size_t end = begin;
+            ids.clear();
+            while(end < entries.size() && entries[end].first == entries[begin].first)
+            {
+                ids.push_back(entries[end++].second);
+            }
+            entries[begin].first->setBlocked(std::span<const SignalDetail::idType>(ids), blocked);
+            begin = end;
+        }
+    }
+};
+
+namespace SignalConcepts {
+
+    /**
+     * @brief Verify that a method is invocable with @ref Signal arguments.
+     * @tparam Method Method to verify.
+     * @tparam AllArgs Parameters of the method.
+     */
+    template <typename Method, typename... AllArgs>
+    concept ValidMethod =
+        std::is_invocable_v<std::remove_reference_t<Method>, AllArgs...>
+    ;
+
+/**
+     * @brief Verify that a method is invocable with @ref Signal arguments et that it's a class method.
+     * @tparam T The class that must contain the method.
+     * @tparam Method Method to verify.
+     * @tparam AllArgs Parameters of the method.
+     */
+    template <typename T, typename Method, typename ...AllArgs>
+    concept ValidClassMethod =
+        std::is_invocable_v<std::remove_reference_t<Method>, T*, AllArgs...>
+     && std::is_member_function_pointer_v<std::decay_t<Method>>
+    ;
+}
+
+namespace SignalDetail {
+
+    /**
+     * @brief Synchronization policy of a signal, whatever its methods return: the key of its @ref SignalDetail::SignalCore.
+     */
+    template<typename Policy>
+    struct CoreOf
+    {
+        using type = Policy;
+    };
+
+    template<typename Policy, typename R>
+    struct CoreOf<Returning<Policy, R>>
+    {
+        using type = Policy;
+    };
+
+    /**
+     * @brief Emit registered on the thread running it, see @ref SignalDetail::SignalCore::EmitSection.
+     * Kept out of the templates: a thread_local member of the extern cores would need an init function.
+     */
+    struct EmitFrame
+    {
+        const void * key = nullptr;
+        EmitFrame * outer = nullptr;
+    };
+
+    /**
+     * @brief Innermost emit registered on this thread, for every signal.
+     */
+    inline thread_local EmitFrame * emitFrames = nullptr;
+
+    /**
+     * @brief Part of @ref BasicSignal not depending on the signal parameters: slot list, policy, ids and counters.
+     * Connected methods are type erased, see @ref BasicSignal::emit(), so one core serves every signal of a policy.
+     * Define SIGNAL_COMPILED_CORE and link the signals_core library to build it once for the policies of
+     * @ref SignalPolicy, instead of in every translation unit.
+     * @tparam Policy One of @ref SignalPolicy.
+     */
+    template<typename Policy>
+    class SignalCore : public ConnectionTarget
+    {
+    public:
+        /**
+         * @brief Alias for signal id type.
+         */
+        using idType = SignalDetail::idType;
+
+        /**
+         * @brief Type erased connected method, wrapping a @ref SignalDetail::Dispatcher. See @ref BasicSignal::emit().
+         * Stored inline up to @ref SIGNAL_METHOD_CAPACITY bytes. Define SIGNAL_INPLACE_METHODS to make bigger methods a compile error instead of a heap allocation.
+         */
+#ifdef SIGNAL_INPLACE_METHODS
+        using MethodType = InplaceFunction<void(Pass, void * const *)>;
+#else
+        using MethodType = SmallFunction<void(Pass, void * const *)>;
+#endif
+
+        /**
+         * @brief Table of connected methods, in connection order.
+         * A published table is never modified while an emit uses it, see @ref SignalDetail::SignalCore::mutate().
+         */
+        using SlotList = SlotTable<MethodType>;
+
+        /**
+         * @brief Counters of the signal, @ref SignalStats with @ref SignalPolicy::Instrumented, nothing otherwise.
+         * With @ref SignalPolicy::Recorded, they also hold the recorder of the signal.
+         */
+        using Stats = typename StatsOf<Policy>::type;
+        static constexpr bool instrumented = std::is_base_of_v<SignalStats, Stats>;
+        static constexpr bool recorded = isRecording<Stats>;
+
+        /**
+         * @brief Method adapted and waiting to be stored, see @ref SignalDetail::SignalCore::insertMany().
+         */
+        struct Pending
+        {
+            MethodType method;
+            std::weak_ptr<void> tracker;
+            int priority = 0;
+            /**
+             * @brief Counters of the method, only with @ref SignalPolicy::Instrumented.
+             */
+            std::shared_ptr<SlotStats> stats;
+        };
+
+        SignalCore() : SignalCore(std::pmr::get_default_resource()) {}
+
+        explicit SignalCore(std::pmr::memory_resource * resource) : slots(resource), resource(resource) {}
+
+        SignalCore(const std::string_view name, std::pmr::memory_resource * resource) : slots(resource), resource(resource)
+        {
+            this->instrumentation.publish(name);
+        }
+
+        /**
+         * @brief Disarm the emits of the signal running on this thread: a method may destroy the signal calling it.
+         */
+        ~SignalCore()
+        {
+            if constexpr (deferred)
+            {
+                EmitSection::disarm(this);
+            }
+        }
+
+        SignalCore(const SignalCore &) = delete;
+        SignalCore & operator=(const SignalCore &) = delete;
+
+        /**
+         * @brief Block every method with a single change of the slot list. Methods connected afterward are not blocked.
+         */
+        void blockAll()
+        {
+            this->mutate([](SlotList & list) { list.setAllBlocked(true); });
+        }
+
+        /**
+         * @brief Unblock every method with a single change of the slot list.
+         */
+        void unblockAll()
+        {
+            this->mutate([](SlotList & list) { list.setAllBlocked(false); });
+        }
+
+        /**
+         * @brief setTracking Choose how methods connected with a std::shared_ptr keep their object alive.
+         * Either way the objects are checked apart from the methods, and those found expired are
+         * disconnected together once the emit is done. @ref BasicSignal::emitMove() and @ref BasicSignal::emitParallel() always pin per emit.
+         * @param mode See @ref SignalTracking. Defaults to SignalTracking::PerCall.
+         * @code
+         * void main() {
+         *  Signal<int> s;
+         *  s.setTracking(SignalTracking::PerEmit);
+         * }
+         * @endcode
+         */
+        void setTracking(const SignalTracking mode)
+        {
+            this->mutate([mode](SlotList & list) { list.setTracking(mode); });
+        }
+
+        /**
+         * @brief stats Counters of an instrumented signal, see @ref SignalPolicy::Instrumented.
+         * @return The counters, report() reads them.
+         * @code
+         * void main() {
+         *  Signal<SignalPolicy::Instrumented<SignalPolicy::Mutex>, int> s;
+         *  SignalReport report = s.stats().report();
+         * }
+         * @endcode
+         */
+        const SignalStats & stats() const requires instrumented
+        {
+            return this->instrumentation;
+        }
+
+        /**
+         * @brief Send every emit to a recorder from now on, see @ref SignalRecorder::record().
+         * @param tap What the recorder gave, nullptr to stop.
+         * @return The tap replaced, nullptr if none: its recorder must be told, see @ref SignalDetail::RecordTap::forget.
+         */
+        const SignalDetail::RecordTap * setRecordTap(const SignalDetail::RecordTap * tap) requires recorded
+        {
+            return this->instrumentation.tap.exchange(tap, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief Stop sending emits to a recorder, unless another one took the signal over since.
+         * @param tap What the recorder gave.
+         */
+        void clearRecordTap(const SignalDetail::RecordTap * tap) requires recorded
+        {
+            this->instrumentation.tap.compare_exchange_strong(tap, nullptr, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief disconnectAll Disconnect all methods
+         * @code
+         * void main() {
+         *  Signal<int> s;
+         *  s.disconnectAll();
+         * }
+         * @endcode
+         */
+        void disconnectAll()
+        {
+            this->mutate([](SlotList & list) { list.clear(); });
+        }
+
+    protected:
+        /**
+         * @brief Current snapshot of connected methods, published by the policy. @ref BasicSignal::emit() never locks.
+         * Don't manipulate, use @ref SignalDetail::SignalCore::mutate(Mutation&& mutation).
+         */
+        typename Policy::template Storage<SlotList> slots;
+
+        /**
+         * @brief Resource of the slot lists, big methods are allocated from it too.
+         */
+        std::pmr::memory_resource * resource;
+
+        /**
+         * @brief Unblocked methods of the last slot list, see @ref BasicSignal::hasActiveListeners().
+         * Set by every mutation, once the policy applies it.
+         */
+        std::atomic<std::size_t> active{0};
+
+        /**
+         * @brief Emit and method counters, empty unless instrumented.
+         */
+        [[no_unique_address]] Stats instrumentation;
+
+        /**
+         * @brief Whether changes made during an emit are queued by the signal, the policy not doing it itself.
+         */
+        static constexpr bool deferred = !SignalDetail::defersChanges<typename Policy::template Storage<SlotList>>;
+
+        /**
+         * @brief Emit of the signal running on this thread, see @ref SignalDetail::SignalCore::mutate().
+         * Only the outermost one queues changes: nested emits of the signal publish what it queued, then read.
+         * A signal destroyed by one of its methods disarms its sections, so the emits stop touching it.
+         */
+        class EmitSection : private EmitFrame
+        {
+        public:
+            explicit EmitSection(SignalCore & signal) : signal(signal)
+            {
+                if constexpr (deferred)
+                {
+                    EmitSection * running = find(&signal);
+                    if(running)
+                    {
+                        //A nested emit comes after the changes queued so far: it never calls a method disconnected before it.
+                        running->root->publish();
+                    }
+                    this->root = running ? running->root : this;
+                    this->key = &signal;
+                    this->outer = emitFrames;
+                    emitFrames = this;
+                }
+            }
+
+            EmitSection(const EmitSection &) = delete;
+            EmitSection & operator=(const EmitSection &) = delete;
+
+            /**
+             * @brief Unregister, then publish the queued changes: those they cause are not queued anymore.
+             * Publishing allocates: if it throws while an exception unwinds the emit, from a method for example,
+             * the changes are dropped rather than ending in std::terminate.
+             */
+            ~EmitSection() noexcept(false)
+            {
+                if constexpr (deferred)
+                {
+                    emitFrames = this->outer;
+                    if(this->root == this && this->alive())
+                    {
+                        if(std::uncaught_exceptions() == 0)
+                        {
+                            this->publish();
+                            return;
+                        }
+                        try
+                        {
+                            this->publish();
+                        }
+                        catch(...)
+                        {
+                            this->pending.clear();
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Innermost emit of a signal on this thread, nullptr if none.
+             */
+            static EmitSection * find(const SignalCore * signal)
+            {
+                EmitFrame * frame = emitFrames;
+                while(frame && frame->key != signal)
+                {
+                    frame = frame->outer;
+                }
+                //Only sections of this core register it.
+                return static_cast<EmitSection *>(frame);
+            }
+
+            /**
+             * @brief Disarm the emits of a signal being destroyed on this thread: their queued changes are dropped.
+             */
+            static void disarm(const SignalCore * signal)
+            {
+                for(EmitFrame * frame = emitFrames; frame; frame = frame->outer)
+                {
+                    if(frame->key == signal)
+                    {
+                        EmitSection * section = static_cast<EmitSection *>(frame);
+                        section->key = nullptr;
+                        //Moved out first: destroying a change may disconnect, which must not queue into it.
+                        std::vector<MoveOnlyFunction<void(SlotList &)>> dropped = std::exchange(section->pending, {});
+                    }
+                }
+            }
+
+            /**
+             * @brief Whether the signal still exists, always true for the policies queueing changes themselves.
+             */
+            bool alive() const
+            {
+                return !deferred || this->key != nullptr;
+            }
+
+            /**
+             * @brief Apply the queued changes in order, with a single change of the slot list.
+             */
+            void publish()
+            {
+                if(!this->pending.empty())
+                {
+                    SignalCore * target = &this->signal;
+                    target->slots.mutate([target, changes = std::exchange(this->pending, {})](SlotList & list) mutable {
+                        for(MoveOnlyFunction<void(SlotList &)> & change: changes)
+                        {
+                            change(list);
+                        }
+                        target->active.store(list.activeCount(), std::memory_order_release);
+                    });
+                }
+            }
+
+            /**
+             * @brief Outermost emit of the signal on this thread, holding the queued changes.
+             */
+            EmitSection * root = nullptr;
+            std::vector<MoveOnlyFunction<void(SlotList &)>> pending;
+
+        private:
+            SignalCore & signal;
+        };
+
+        /**
+         * @brief Reserve ids with a single change of the slot list, see @ref SignalDetail::SlotTable::reserve().
+         * @param count Number of ids.
+         * @return The ids.
+         */
+        std::vector<idType> reserveIds(const std::size_t count)
+        {
+            return this->mutate([count](SlotList & list) {
+                std::vector<idType> ids;
+                ids.reserve(count);
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    ids.push_back(list.reserve());
+                }
+                return ids;
+            }, [](SlotList &, const std::vector<idType> &) {});
+        }
+
+        /**
+         * @brief Store methods under reserved ids and give back the ids left, with a single change of the slot list.
+         * @param pending Adapted methods.
+         * @param ids Id of each method.
+         * @param unused Reserved ids to give back.
+         */
+        void insertReserved(std::vector<Pending> && pending, std::vector<idType> ids, std::vector<idType> && unused)
+        {
+            if constexpr (instrumented)
+            {
+                for(std::size_t k = 0; k < pending.size(); ++k)
+                {
+                    pending[k].stats->id = ids[k];
+                    this->instrumentation.addSlot(pending[k].stats);
+                }
+            }
+            this->mutate([pending = std::move(pending), ids = std::move(ids), unused = std::move(unused)](SlotList & list) mutable {
+                list.reserveSlots(pending.size());
+                for(std::size_t k = 0; k < pending.size(); ++k)
+                {
+                    list.insertReserved(ids[k], std::move(pending[k].method), std::move(pending[k].tracker), pending[k].priority);
+                }
+                for(const idType id: unused)
+                {
+                    list.unreserve(id);
+                }
+            });
+        }
+
+        /**
+         * @brief Store methods with a single change of the slot list.
+         * @param pending Adapted methods.
+         * @return Id of each method, in order.
+         */
+        std::vector<idType> insertMany(std::vector<Pending> && pending)
+        {
+            std::vector<std::shared_ptr<SlotStats>> stats;
+            if constexpr (instrumented)
+            {
+                for(const Pending & p: pending)
+                {
+                    stats.push_back(p.stats);
+                }
+            }
+            const std::size_t count = pending.size();
+            std::vector<idType> ids = this->mutate([count](SlotList & list) {
+                std::vector<idType> reserved;
+                reserved.reserve(count);
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    reserved.push_back(list.reserve());
+                }
+                return reserved;
+            }, [pending = std::move(pending)](SlotList & list, const std::vector<idType> & reserved) mutable {
+                list.reserveSlots(pending.size());
+                for(std::size_t k = 0; k < pending.size(); ++k)
+                {
+                    list.insertReserved(reserved[k], std::move(pending[k].method), std::move(pending[k].tracker), pending[k].priority);
+                }
+            });
+            if constexpr (instrumented)
+            {
+                for(std::size_t k = 0; k < stats.size(); ++k)
+                {
+                    stats[k]->id = ids[k];
+                    this->instrumentation.addSlot(stats[k]);
+                }
+            }
+            return ids;
+        }
+
+        /**
+         * @brief Store an adapted method, see @ref BasicSignal::addMethod().
+         * @param pending The method.
+         * @return Its id.
+         */
+        idType insert(Pending && pending)
+        {
+            const idType id = this->mutate([](SlotList & list) { return list.reserve(); },
+                                           [method = std::move(pending.method), tracker = std::move(pending.tracker),
+                                            priority = pending.priority](SlotList & list, const idType id) mutable {
+                list.insertReserved(id, std::move(method), std::move(tracker), priority);
+            });
+            if constexpr (instrumented)
+            {
+                pending.stats->id = id;
+                this->instrumentation.addSlot(pending.stats);
+            }
+            return id;
+        }
+
+        /**
+         * @brief Call the methods of a snapshot, then disconnect those whose tracked object expired.
+         * The signal isn't touched after the methods if one of them destroyed it.
+         * @param section Emit running the methods.
+         * @param list Snapshot taken by the emit.
+         * @param pass How the methods get the arguments.
+         * @param argv Arguments of the emit, see @ref SignalDetail::ArgPointers.
+         */
+        void call(const EmitSection & section, const SlotList & list, const Pass pass, void * const * argv)
+        {
+            std::vector<idType> expired;
+            list.forEachLive([pass, argv](const MethodType & method) {
+                method(pass, argv);
+            }, expired);
+            if(!expired.empty() && section.alive())
+            {
+                this->purge(std::move(expired));
+            }
+        }
+
+        /**
+         * @brief Same as @ref SignalDetail::SignalCore::call(), the last method called gets the arguments as rvalues.
+         * Each method is called once the next live one is found, so the last is known even if tracked objects expired.
+         * Tracked objects are locked for the whole emit, a method running after the next one was checked.
+         */
+        void callMoving(const EmitSection & section, const SlotList & list, void * const * argv)
+        {
+            std::vector<idType> expired;
+            const typename SlotList::Pins pins = list.pin(expired);
+            const MethodType * previous = nullptr;
+            list.forEachLive(0, list.size(), pins, [&previous, argv](const MethodType & method) {
+                if(previous != nullptr)
+                {
+                    (*previous)(Pass::Copy, argv);
+                }
+                previous = &method;
+            });
+            if(previous != nullptr)
+            {
+                (*previous)(Pass::Move, argv);
+            }
+            if(!expired.empty() && section.alive())
+            {
+                this->purge(std::move(expired));
+            }
+        }
+
+        /**
+         * @brief Same as @ref SignalDetail::SignalCore::call(), the methods running on a pool, see @ref BasicSignal::emitParallel().
+         */
+        void callParallel(const EmitSection & section, const SlotList & list, ThreadPool & pool, const std::size_t chunk, void * const * argv)
+        {
+            //Tracked objects are locked once by this thread, whatever the SignalTracking mode.
+            std::vector<idType> expired;
+            const typename SlotList::Pins pins = list.pin(expired);
+            pool.parallelFor(list.size(), chunk, [&list, &pins, argv](const std::size_t begin, const std::size_t end) {
+                list.forEachLive(begin, end, pins, [argv](const MethodType & method) {
+                    method(Pass::Copy, argv);
+                });
+            });
+            if(!expired.empty() && section.alive())
+            {
+                this->purge(std::move(expired));
+            }
+        }
+
+        /**
+         * @brief Disconnect in one go the methods an emit found with an expired tracked object.
+         * @param expired Ids of the methods.
+         */
+        void purge(std::vector<idType> && expired)
+        {
+            if(!expired.empty())
+            {
+                this->mutate([expired = std::move(expired)](SlotList & list) { list.erase(expired); });
+            }
+        }
+
+        /**
+         * @brief Copy the current snapshot, apply a change to the copy and publish it.
+         * Emits already running keep their own snapshot, see @ref SignalPolicy for the policies changing it in place.
+         * Changes made on a thread while it emits the signal, by its methods for example, are queued instead and
+         * published with a single copy once the outermost emit returns, or before a nested emit of the signal starts.
+         * @param mutation Callable taking a SlotList& to modify. Must own its captures.
+         */
+        template <typename Mutation>
+        void mutate(Mutation&& mutation)
+        {
+            if constexpr (deferred)
+            {
+                if(EmitSection * section = EmitSection::find(this))
+                {
+                    section->root->pending.emplace_back(std::forward<Mutation>(mutation));
+                    return;
+                }
+            }
+            this->slots.mutate([this, mutation = std::forward<Mutation>(mutation)](SlotList & list) mutable {
+                mutation(list);
+                this->active.store(list.activeCount(), std::memory_order_release);
+            });
+        }
+
+        /**
+         * @brief Same as @ref SignalDetail::SignalCore::mutate(Mutation&& mutation), with a first step run right away.
+         * @param prepare Callable taking a SlotList&, only touching ids. Its result is returned.
+         * @param mutation Callable taking a SlotList& and the result of prepare. Must own its captures.
+         * @return Result of prepare.
+         */
+        template <typename Prepare, typename Mutation>
+        auto mutate(Prepare&& prepare, Mutation&& mutation)
+        {
+            if constexpr (deferred)
+            {
+                //prepare needs the list as changed so far: a connect publishes what was queued first.
+                if(EmitSection * section = EmitSection::find(this))
+                {
+                    section->root->publish();
+                }
+            }
+            return this->slots.mutate(std::forward<Prepare>(prepare), [this, mutation = std::forward<Mutation>(mutation)](SlotList & list, auto&& prepared) mutable {
+                mutation(list, std::forward<decltype(prepared)>(prepared));
+                this->active.store(list.activeCount(), std::memory_order_release);
+            });
+        }
+
+    private:
+        /**
+         * @brief Disconnect the method with the id key.
+         * @param id Id of the method.
+         */
+        void disconnect(const idType id) override
+        {
+            this->mutate([id](SlotList & list) { list.erase(id); });
+        }
+
+        /**
+         * @brief Disconnect several methods with a single change of the slot list.
+         * @param ids Ids of the methods.
+         */
+        void disconnect(std::span<const idType> ids) override
+        {
+            this->mutate([ids = std::vector<idType>(ids.begin(), ids.end())](SlotList & list) { list.erase(ids); });
+        }
+
+        /**
+         * @brief Change if a method is blocked by id. a blocked method won't be called by @ref BasicSignal::emit().
+         * @param id Id of the method.
+         * @param blocked true/false.
+         */
+        void setBlocked(const idType id, const bool blocked) override
+        {
+            this->mutate([id, blocked](SlotList & list) { list.setBlocked(id, blocked); });
+        }
+
+        /**
+         * @brief Change if several methods are blocked with a single change of the slot list.
+         * @param ids Ids of the methods.
+         * @param blocked true/false.
+         */
+        void setBlocked(std::span<const idType> ids, const bool blocked) override
+        {
+            this->mutate([ids = std::vector<idType>(ids.begin(), ids.end()), blocked](SlotList & list) { list.setBlocked(ids, blocked); });
+        }
+    };
+
+    //signals_core is built with the default storage of methods: other settings keep their core inline.
+#if defined(SIGNAL_COMPILED_CORE) && !defined(SIGNAL_INPLACE_METHODS) && SIGNAL_METHOD_CAPACITY == 48
+    extern template class SignalCore<SignalPolicy::Mutex>;
+    extern template class SignalCore<SignalPolicy::SharedMutex>;
+    extern template class SignalCore<SignalPolicy::LockFree>;
+    extern template class SignalCore<SignalPolicy::SingleThreaded>;
+#endif
+}
+
+/**
+ * @brief Implementation of @ref Signal for a given synchronization policy.
+ * @tparam Policy One of @ref SignalPolicy.
+ * @tparam Args All arguments that will be emited by the signal.
+ */
+template<typename Policy, typename... Args>
+class BasicSignal : public SignalDetail::SignalCore<typename SignalDetail::CoreOf<Policy>::type>
+{
+/**
+ * @brief Everything not depending on Args, shared by the signals of a policy.
+ */
+using Core = SignalDetail::SignalCore<typename SignalDetail::CoreOf<Policy>::type>;
+using typename Core::idType;
+using typename Core::MethodType;
+using typename Core::SlotList;
+using typename Core::Pending;
+using typename Core::EmitSection;
+using Core::instrumented;
+using Core::recorded;
+
+/**
+ * @brief Result type of the methods, void unless the signal is a Signal<R(Args...)>.
+ */
+using Result = typename SignalDetail::ResultOf<Policy>::type;
+
+/**
+ * @brief Adapter of methods connected with connect(), see @ref BasicSignal::addMethod().
+ */
+template<typename Method, typename... A>
+using MethodAdapter = typename SignalDetail::ResultDispatcher<Result>::template type<Method, A...>;
+
+public:
+    /**
+     * @brief Events given to @ref BasicSignal::emitBatch().
+     */
+    using BatchType = std::span<const std::tuple<Args...>>;
+
+    /**
+     * @brief Signal Default constructor.
+     */
+    BasicSignal() = default;
+
+    /**
+     * @brief Signal allocating its slot lists and big connected callables from a memory resource.
+     * @param resource Resource outliving the signal, thread safe, for example @ref SlotPool::shared().
+     * @code
+     * void main() {
+     *  SlotPool pool;
+     *  Signal<int> s(&pool);
+     * }
+     * @endcode
+     */
+    explicit BasicSignal(std::pmr::memory_resource * resource) : Core(resource) {}
+
+    /**
+     * @brief Signal with a name, under which an instrumented signal appears in @ref SignalRegistry.
+     * Other signals ignore the name.
+     * @param name Name of the signal.
+     * @param resource See @ref BasicSignal::BasicSignal(std::pmr::memory_resource *).
+     * @code
+     * void main() {
+     *  Signal<SignalPolicy::Instrumented<SignalPolicy::Mutex>, int> s("ticks");
+     * }
+     * @endcode
+     */
+    explicit BasicSignal(const std::string_view name, std::pmr::memory_resource * resource = std::pmr::get_default_resource())
+        : Core(name, resource) {}
+
+    /**
+     * @brief Deleted. Connections point to the signal.
+     */
+    BasicSignal(const BasicSignal &) = delete;
+
+    /**
+     * @brief Deleted. Connections point to the signal.
+     */
+    BasicSignal & operator=(const BasicSignal &) = delete;
+
+    /**
+     * @brief Connect a static method or a lambda to a signal.
+     * @param method Static method or lambda.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void f(int){ ... }
+     *
+     * void main() {
+     *  Signal<int> s;
+     *  Foo foo;
+     *  Connection c = s.connect(&f);
+     *  //or
+     *  Connection c = s.connect(f);
+     *  //or
+     *  Connection c = s.connect([](int){ ... });
+     * }
+     * @endcode
+     */
+    template<typename Method>
+    requires SignalConcepts::ValidMethod<Method, const Args&...>
+    Connection<Args...> connect(Method&& method) noexcept
+    {
+        return this->attach(this->makeMethod(std::forward<Method>(method)));
+    }
+
+    /**
+     * @brief Connect a class method to a signal.
+     * @param instance Class object.
+     * @param method Class method.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * class Foo {
+     *  void f(int){ ... }
+     * }
+     *
+     * void main() {
+     *  Signal<int> s;
+     *  Foo foo;
+     *  Connection c = s.connect(&foo, &Foo::f);
+     * }
+     * @endcode
+     */
+    template<typename T, typename Method>
+    requires SignalConcepts::ValidClassMethod<T, Method, const Args&...>
+    Connection<Args...> connect(T* instance, Method&& method) noexcept
+    {
+        return this->attach(this->makeMethod(instance, std::forward<Method>(method)));
+    }
+
+    /**
+     * @brief Connect a class method known at compile time to a signal.
+     * Fastest way to connect a class method: only the instance pointer is stored and the call
+     * is a single indirect call to a thunk generated for Method, which inlines the member call.
+     * @tparam Method Class method, as a template argument.
+     * @param instance Class object.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * class Foo {
+     *  void f(int){ ... }
+     * }
+     *
+     * void main() {
+     *  Signal<int> s;
+     *  Foo foo;
+     *  Connection c = s.connect<&Foo::f>(&foo);
+     * }
+     * @endcode
+     */
+    template<auto Method, typename T>
+    requires SignalConcepts::ValidClassMethod<T, decltype(Method), const Args&...>
+    Connection<Args...> connect(T* instance) noexcept
+    {
+        return this->attach(this->template makeMethod<Method>(instance));
+    }
+
+    /**
+     * @brief Connect a method receiving batches of events, see @ref BasicSignal::emitBatch().
+     * A plain @ref BasicSignal::emit() gives it a batch of one event, copied from the arguments.
+     * @param method Static method or lambda taking a BatchType.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void main() {
+     *  Signal<int> s;
+     *  Connection c = s.connectBatch([](std::span<const std::tuple<int>> events){ ... });
+     * }
+     * @endcode
+     */
+    template<typename Method>
+    requires std::is_void_v<Result> && std::is_invocable_v<std::remove_reference_t<Method>&, std::span<const std::tuple<Args...>>>
+    Connection<Args...> connectBatch(Method&& method) noexcept
+    {
+        idType id = this->template addMethod<SignalDetail::BatchDispatcher>(std::forward<Method>(method));
+        return Connection<Args...>(this, id);
+    }
+
+    /**
+     * @brief Connect a class method to a signal. Will auto disconnect if instance is not valid anymore.
+     * @param instance Shared pointer to the class object.
+     * @param method The class method.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * class Foo {
+     *  void f(int){ ... }
+     * }
+     *
+     * void main() {
+     *  Signal<int> s;
+     *  std::shared_ptr<Foo> foo = std::make_shared<Foo>();
+     *  Connection c = s.connect(foo, &Foo::f);
+     * }
+     * @endcode
+     */
+    template<typename T, typename Method>
+    requires SignalConcepts::ValidClassMethod<T, Method, const Args&...>
+    Connection<Args...> connect(std::shared_ptr<T>& instance, Method&& method) noexcept
+    {
+        return this->attach(this->makeMethod(instance, std::forward<Method>(method)));
+    }
+
+    /**
+     * @brief Connect a method and bound its aguments from left to right.
+     * @param method Static method or lambda. Must return void and have parameters to bind and then the same parameters as the signal.
+     * @param boundArgs Values to bound arguments to. Be aware that if you want to bound a ref you should cast it explicitly with std::ref().
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void f(string, int){ ... }
+     *
+     * void main() {
+     *  Signal<int> s;
+     *  Foo foo;
+     *  Connection c = s.connect(&f, "bar");
+     *  //or
+     *  Connection c = s.connect(f, "bar");
+     *  //or
+     *  Connection c = s.connect([](int){ ... }, "bar");
+     * }
+     * @endcode
+     */
+    template<typename Method, typename... BoundArgs>
+    requires SignalConcepts::ValidMethod<Method, BoundArgs..., const Args&...>
+    Connection<Args...> connect(Method&& method, BoundArgs&&... boundArgs) noexcept
+    {
+        return this->attach(this->makeMethod(std::forward<Method>(method), std::forward<BoundArgs>(boundArgs)...));
+    }
+
+    /**
+     * @brief Connect a class method and bound its aguments from left to right.
+     * @param instance Class instance.
+     * @param method Class method. Must return void and have parameters to bind and then the same parameters as the signal.
+     * @param boundArgs Values to bound arguments to. Be aware that if you want to bound a ref you should cast it explicitly with std::ref().
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * class Foo {
+     *  void f(string, int){ ... }
+     * }
+     *
+     * void main() {
+     *  Signal<int> s;
+     *  Foo foo;
+     *  Connection c = s.connect(&foo, &foo::f, "bar");
+     * }
+     * @endcode
+     */
+    template<typename T, typename Method, typename... BoundArgs>
+    requires SignalConcepts::ValidClassMethod<T, Method, BoundArgs..., const Args&...>
+    Connection<Args...> connect(T* instance, Method&& method, BoundArgs&&... boundArgs)
+    {
+        return this->attach(this->makeMethod(instance, std::forward<Method>(method), std::forward<BoundArgs>(boundArgs)...));
+    }
+
+    /**
+     * @brief Connect a class method and bound its aguments from left to right.
+     *  Will auto disconnect if instance is not valid anymore.
+     * @param instance Shared pointer to class instance.
+     * @param method Class method. Must return void and have parameters to bind and then the same parameters as the signal.
+     * @param boundArgs Values to bound arguments to. Be aware that if you want to bound a ref you should cast it explicitly with std::ref().
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * class Foo {
+     *  void f(string, int){ ... }
+     * }
+     *
+     * void main() {
+     *  Signal<int> s;
+     *  std::shared_ptr<Foo> foo = std::make_shared<Foo>();
+     *  Connection c = s.connect(foo, &foo::f, "bar");
+     * }
+     * @endcode
+     */
+    template<typename T, typename Method, typename... BoundArgs>
+    requires SignalConcepts::ValidClassMethod<T, Method, BoundArgs..., const Args&...>
+    Connection<Args...> connect(std::shared_ptr<T>& instance, Method&& method, BoundArgs&&... boundArgs)
+    {
+        return this->attach(this->makeMethod(instance, std::forward<Method>(method), std::forward<BoundArgs>(boundArgs)...));
+    }
+
+    /**
+     * @brief Queued connection: the method runs on the thread of an @ref Executor instead of the emitting one.
+     * Arguments are copied into a pooled event pushed to the executor queue, emit never waits for the method.
+     * Works with every other connect overload, give their parameters after the executor.
+     * Events still queued when the connection is removed are dropped.
+     * @param executor Executor that will call the method.
+     * @param connectArgs Parameters of another connect overload.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * class Foo {
+     *  void f(int){ ... }
+     * }
+     *
+     * void main() {
+     *  Signal<int> s;
+     *  Executor uiThread;
+     *  Foo foo;
+     *  Connection c = s.connect(uiThread, &foo, &Foo::f);
+     *  s.emit(1);
+     *  uiThread.poll(); //calls foo.f(1)
+     * }
+     * @endcode
+     */
+    template<typename... ConnectArgs>
+    requires requires(BasicSignal & s, ConnectArgs&&... connectArgs) { s.makeMethod(std::forward<ConnectArgs>(connectArgs)...); }
+    Connection<Args...> connect(Executor & executor, ConnectArgs&&... connectArgs)
+    {
+        return this->attach(this->makeMethod(std::forward<ConnectArgs>(connectArgs)...), [&executor](auto&& method) {
+            return SignalDetail::QueuedMethod<std::decay_t<decltype(method)>, Args...>(executor, std::forward<decltype(method)>(method));
+        });
+    }
+
+    /**
+     * @brief Coalesced connection: emits only keep the latest arguments, a @ref Coalescer delivers them.
+     * The emit copies the arguments and returns, however slow the method: made for consumers needing
+     * the current value of a fast signal, like a UI refreshing at 60 Hz from a 1 MHz price feed.
+     * Works with every other connect overload but the queued one, give their parameters after the mode.
+     * Arguments still coalesced when the connection is removed are dropped.
+     * @param coalescer Coalescer that will call the method, on the thread draining it.
+     * @param mode @ref SignalThrottle::Latest, @ref SignalThrottle::Every or @ref SignalThrottle::Debounce.
+     * @param connectArgs Parameters of another connect overload.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void main() {
+     *  Signal<double> price;
+     *  Coalescer ui;
+     *  Connection c = price.connect(ui, SignalThrottle::Every{std::chrono::milliseconds(16)}, &chart, &Chart::setPrice);
+     *  price.emit(1.5);
+     *  price.emit(1.6);
+     *  ui.drain(); //calls chart.setPrice(1.6)
+     * }
+     * @endcode
+     */
+    template<SignalConcepts::ThrottleMode Mode, typename... ConnectArgs>
+    requires requires(BasicSignal & s, ConnectArgs&&... connectArgs) { s.makeMethod(std::forward<ConnectArgs>(connectArgs)...); }
+    Connection<Args...> connect(Coalescer & coalescer, const Mode mode, ConnectArgs&&... connectArgs)
+    {
+        return this->attach(this->makeMethod(std::forward<ConnectArgs>(connectArgs)...), [&coalescer, mode](auto&& method) {
+            return SignalDetail::CoalescedMethod<std::decay_t<decltype(method)>, Mode, Args...>(coalescer, mode, std::forward<decltype(method)>(method));
+        });
+    }
+
+    /**
+     * @brief Queued connection keeping only the latest arguments, see @ref BasicSignal::connect(Executor&, ConnectArgs&&...).
+     * An emit posts an event only if none is waiting, the method gets the latest arguments when the executor runs it:
+     * the queue holds one event per connection at most, whatever the emit rate.
+     * @param executor Executor that will call the method.
+     * @param latest @ref SignalThrottle::Latest.
+     * @param connectArgs Parameters of another connect overload.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void main() {
+     *  Signal<double> price;
+     *  Executor writer;
+     *  Connection c = price.connect(writer, SignalThrottle::Latest{}, &snapshot, &Snapshot::store);
+     * }
+     * @endcode
+     */
+    template<typename... ConnectArgs>
+    requires requires(BasicSignal & s, ConnectArgs&&... connectArgs) { s.makeMethod(std::forward<ConnectArgs>(connectArgs)...); }
+    Connection<Args...> connect(Executor & executor, SignalThrottle::Latest, ConnectArgs&&... connectArgs)
+    {
+        return this->attach(this->makeMethod(std::forward<ConnectArgs>(connectArgs)...), [&executor](auto&& method) {
+            return SignalDetail::LatestMethod<std::decay_t<decltype(method)>, Args...>(executor, std::forward<decltype(method)>(method));
+        });
+    }
+
+    /**
+     * @brief Connect with a priority: emit calls methods by decreasing priority, then in connection order.
+     * The order is kept at connect time, emit walks the methods as stored. Other overloads use priority 0.
+     * Works with every other connect overload but the queued one, give their parameters after the priority.
+     * @param priority Higher is called first, negative values run after the default.
+     * @param connectArgs Parameters of another connect overload.
+     * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void main() {
+     *  Signal<const Order &> s;
+     *  Connection route = s.connect(&router, &Router::route);
+     *  Connection risk = s.connect(100, &risk, &Risk::check); //called before route
+     * }
+     * @endcode
+     */
+    template<typename... ConnectArgs>
+    requires requires(BasicSignal & s, ConnectArgs&&... connectArgs) { s.makeMethod(std::forward<ConnectArgs>(connectArgs)...); }
+    Connection<Args...> connect(const int priority, ConnectArgs&&... connectArgs)
+    {
+        return this->attach(this->makeMethod(std::forward<ConnectArgs>(connectArgs)...), std::identity{}, priority);
+    }
+
+    /**
+     * @brief Connect every method of a range with a single change of the slot list.
+     * @param methods Range of static methods or lambdas, each one connected like with @ref BasicSignal::connect(Method&&).
+     * @return A @ref Connection per method, in order. Must be kept or the signal might be automatically disconected.
+     *
+     * @code{.cpp}
+     * void main() {
+     *  Signal<int> s;
+     *  std::vector<std::function<void(int)>> handlers = ...;
+     *  std::vector<Connection<int>> connections = s.connectMany(handlers);
+     * }
+     * @endcode
+     */
+    template<std::ranges::input_range Methods>
+    requires SignalConcepts::ValidMethod<std::ranges::range_reference_t<Methods>, const Args&...>
+    std::vector<Connection<Args...>> connectMany(Methods&& methods)
+    {
+        std::vector<Pending> pending;
+        if constexpr (std::ranges::sized_range<Methods>)
+        {
+            pending.reserve(std::ranges::size(methods));
+        }
+        for(auto&& method: methods)
+        {
+            pending.push_back(this->pendMade(this->makeMethod(std::forward<decltype(method)>(method))));
+        }
+        std::vector<Connection<Args...>> connections;
+        connections.reserve(pending.size());
+        for(const idType id: this->insertMany(std::move(pending)))
+        {
+            connections.push_back(Connection<Args...>(this, id));
+        }
+        return connections;
+    }
+
+    /**
+     * @brief Batch of connections stored together, see @ref BasicSignal::transaction().
+     * Ids are reserved ahead by blocks: the signal changes once per block and once on commit, not once per connection.
+     * Not thread safe, keep it to the thread that opened it.
+     */
+    class Transaction
+    {
+    public:
+        /**
+         * @brief Deleted. Holds reserved ids of the signal.
+         */
+        Transaction(const Transaction &) = delete;
+
+        /**
+         * @brief Deleted. Holds reserved ids of the signal.
+         */
+        Transaction & operator=(const Transaction &) = delete;
+
+        /**
+         * @brief Commit what is left.
+         */
+        ~Transaction()
+        {
+            this->commit();
+        }
+
+        /**
+         * @brief Connect like @ref BasicSignal::connect(), the method is stored on @ref Transaction::commit().
+         * The connection may be disconnected before: the method is then never stored.
+         * @param connectArgs Parameters of a connect overload, priority and queued ones aside.
+         * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+         */
+        template<typename... ConnectArgs>
+        requires requires(BasicSignal & s, ConnectArgs&&... connectArgs) { s.makeMethod(std::forward<ConnectArgs>(connectArgs)...); }
+        Connection<Args...> connect(ConnectArgs&&... connectArgs)
+        {
+            return this->add(this->sig->pendMade(BasicSignal::makeMethod(std::forward<ConnectArgs>(connectArgs)...)));
+        }
+
+        /**
+         * @brief Connect with a priority, see @ref BasicSignal::connect(int, ConnectArgs&&...).
+         * @param priority Higher is called first.
+         * @param connectArgs Parameters of a connect overload, priority and queued ones aside.
+         * @return A @ref Connection. Must be kept or the signal might be automatically disconected.
+         */
+        template<typename... ConnectArgs>
+        requires requires(BasicSignal & s, ConnectArgs&&... connectArgs) { s.makeMethod(std::forward<ConnectArgs>(connectArgs)...); }
+        Connection<Args...> connect(const int priority, ConnectArgs&&... connectArgs)
+        {
+            return this->add(this->sig->pendMade(BasicSignal::makeMethod(std::forward<ConnectArgs>(connectArgs)...), priority));
+        }
+
+        /**
+         * @brief Store the methods connected so far with a single change of the slot list.
+         * The transaction stays usable for more connections.
+         */
+        void commit()
+        {
+            if(this->pending.empty() && this->used == this->reserved.size())
+            {
+                return;
+            }
+            std::vector<idType> unused(this->reserved.begin() + this->used, this->reserved.end());
+            this->sig->insertReserved(std::move(this->pending), std::move(this->ids), std::move(unused));
+            this->pending.clear();
+            this->ids.clear();
+            this->reserved.clear();
+            this->used = 0;
+        }
+
+    private:
+        friend class BasicSignal;
+
+        BasicSignal * sig;
+        /**
+         * @brief Size of the blocks of ids reserved ahead.
+         */
+        std::size_t block;
+        std::vector<idType> reserved;
+        std::size_t used = 0;
+        std::vector<Pending> pending;
+        /**
+         * @brief Id of each pending method.
+         */
+        std::vector<idType> ids;
+
+        Transaction(BasicSignal & sig, const std::size_t expected) : sig(&sig), block(expected == 0 ? 64 : expected)
+        {
+            this->pending.reserve(expected);
+            this->ids.reserve(expected);
+        }
+
+        Connection<Args...> add(Pending && method)
+        {
+            if(this->used == this->reserved.size())
+            {
+                this->reserved = this->sig->reserveIds(this->block);
+                this->used = 0;
+                this->block *= 2;
+            }
+            const idType id = this->reserved[this->used++];
+            this->pending.push_back(std::move(method));
+            this->ids.push_back(id);
+            return Connection<Args...>(this->sig, id);
+        }
+    };
+
+    /**
+     * @brief Open a batch of connections stored with a single change of the slot list, see @ref BasicSignal::Transaction.
+     * @param expected Number of connections expected, to reserve their ids at once.
+     * @return The transaction, committed when destroyed.
+     *
+     * @code{.cpp}
+     * void main() {
+     *  Signal<int> s;
+     *  std::vector<Connection<int>> connections;
+     *  {
+     *   auto batch = s.transaction(widgets.size());
+     *   for(Widget & w: widgets) {
+     *    connections.push_back(batch.connect(&w, &Widget::update));
+     *   }
+     *  } //methods stored here
+     * }
+     * @endcode
+     */
+    Transaction transaction(const std::size_t expected = 0)
+    {
+        return Transaction(*this, expected);
+    }
+
+    /**
+     * @brief Disconnect several connections with a single change of the slot list.
+     * Connections to other signals are disconnected one by one.
+     * @param connections Connections to disconnect.
+     */
+    void disconnectMany(std::span<Connection<Args...>> connections)
     {
-        std::lock_guard<std::mutex> lock(mtx);
-        this->methods.erase(id);
+        std::vector<idType> ids;
+        ids.reserve(connections.size());
+        for(Connection<Args...> & connection: connections)
+        {
+            if(connection.sig == this)
+            {
+                ids.push_back(connection.id);
+                connection.sig = nullptr;
+                connection.unlink();
+            }
+            else
+            {
+                connection.disconnect();
+            }
+        }
+        this->purge(std::move(ids));
     }
 
+    /**
+     * @brief emit Call all connected methods.
+     * Arguments are given by const reference to every method: only methods taking them by value copy them.
+     * @param args Signal parameters, same type as template.
+     * @code
+     * void main() {
+     *  Signal<int> s;
+     *  s.emit(1);
+     * }
+     * @endcode
+     */
+    void emit(const Args&... args)
+    {
+        this->instrumentation.onEmit();
+        this->record(args...);
+        //Changes made by the methods are published together once the outermost emit returns.
+        const EmitSection section(*this);
+        //Keeps the snapshot alive even if a method connects or disconnects during the emit.
+        auto snapshot = this->slots.read();
+        this->awaiters.resume(args...);
+        if(!snapshot)
+        {
+            return;
+        }
+        //Methods only get the arguments back as const, see SignalDetail::Dispatcher.
+        this->call(section, *snapshot, SignalDetail::Pass::Copy, SignalDetail::ArgPointers(args...));
+    }
 
     /**
-     * @brief Add a method to be called by next @ref Signal::emit().
-     * @param id Id of the method.
-     * @param method Static function or lambda.
+     * @brief emit Call the connected methods of a Signal<R(Args...)> and combine their results.
+     * Methods are called in order until the combiner has its answer, the others are skipped.
+     * Results only go through a std::optional<R> on the stack, never through a container.
+     * A plain @ref BasicSignal::emit() calls every method and discards the results.
+     * @param combiner See @ref SignalCombiner.
+     * @param args Signal parameters, same type as template.
+     * @return What the combiner made of the results.
+     * @code
+     * void main() {
+     *  Signal<bool(int)> validators;
+     *  bool valid = validators.emit(SignalCombiner::AllTrue{}, 1);
+     *  Signal<int(int)> scores;
+     *  int total = scores.emit(SignalCombiner::Sum<int>{}, 1);
+     * }
+     * @endcode
+     */
+    template<typename Combiner>
+    requires (!std::is_void_v<Result>) && SignalConcepts::Combiner<std::remove_reference_t<Combiner>, Result>
+    auto emit(Combiner&& combiner, const Args&... args)
+    {
+        this->instrumentation.onEmit();
+        this->record(args...);
+        const EmitSection section(*this);
+        auto snapshot = this->slots.read();
+        this->awaiters.resume(args...);
+        if(snapshot)
+        {
+            std::optional<Result> result;
+            const SignalDetail::ArgPointers argv(args..., result);
+            std::vector<idType> expired;
+            snapshot->forEachLive([&combiner, &argv, &result](const MethodType & method) -> bool {
+                method(SignalDetail::Pass::Collect, argv);
+                return combiner.add(std::move(*result));
+            }, expired);
+            if(!expired.empty() && section.alive())
+            {
+                this->purge(std::move(expired));
+            }
+        }
+        return combiner.result();
+    }
+
+    /**
+     * @brief Whether an emit would reach someone: an unblocked method, or a coroutine waiting in @ref BasicSignal::next().
+     * Lock-free, two atomic loads. Methods whose tracked object just expired count until an emit drops them.
+     * @return true if the signal has active listeners.
+     * @code
+     * void main() {
+     *  Signal<std::string> s;
+     *  if(s.hasActiveListeners()) {
+     *   s.emit(format(state));
+     *  }
+     * }
+     * @endcode
+     */
+    bool hasActiveListeners() const
+    {
+        return this->active.load(std::memory_order_acquire) != 0 || this->awaiters.waiting();
+    }
+
+    /**
+     * @brief emitLazy Build the arguments and emit them only if @ref BasicSignal::hasActiveListeners().
+     * The arguments are given as rvalues, see @ref BasicSignal::emitMove().
+     * @param factory Callable without parameter returning the argument of a single parameter signal,
+     * or a std::tuple of the arguments.
+     * @code
+     * void main() {
+     *  Signal<std::string> log;
+     *  log.emitLazy([&](){ return std::format("{} orders pending", book.size()); });
+     *  Signal<int, std::string> s;
+     *  s.emitLazy([](){ return std::tuple(1, std::string("...")); });
+     * }
+     * @endcode
+     */
+    template<typename Factory>
+    requires std::is_invocable_v<Factory&>
+    void emitLazy(Factory&& factory)
+    {
+        if(!this->hasActiveListeners())
+        {
+            return;
+        }
+        using Made = std::invoke_result_t<Factory&>;
+        if constexpr (sizeof...(Args) == 1 && (std::is_convertible_v<Made, Args&&> && ...))
+        {
+            this->emitMove(std::invoke(factory));
+        }
+        else
+        {
+            std::apply([this](auto&&... args) { this->emitMove(std::forward<decltype(args)>(args)...); }, std::invoke(factory));
+        }
+    }
+
+    /**
+     * @brief emitMove Call all connected methods, the last one called receives the arguments as rvalues.
+     * A last method taking a large payload by value moves it instead of copying it.
+     * The last one is the last called: methods whose tracked object expired are skipped.
+     * The other methods get const references like with @ref BasicSignal::emit().
+     * @param args Signal parameters, moved from afterward.
+     * @code
+     * void main() {
+     *  Signal<std::string> s;
+     *  std::string text = "...";
+     *  s.emitMove(std::move(text));
+     * }
+     * @endcode
+     */
+    void emitMove(Args&&... args)
+    {
+        this->instrumentation.onEmit();
+        this->record(args...);
+        const EmitSection section(*this);
+        auto snapshot = this->slots.read();
+        this->awaiters.resume(args...);
+        if(!snapshot)
+        {
+            return;
+        }
+        this->callMoving(section, *snapshot, SignalDetail::ArgPointers(args...));
+    }
+
+    /**
+     * @brief emitBatch Emit several times in a row, for example to replay a buffer.
+     * The snapshot is taken once and each method runs over the whole batch before the next one,
+     * so methods are called in order per event, but the events are not interleaved between methods.
+     * Methods connected with @ref BasicSignal::connectBatch() receive the whole batch in one call.
+     * @param events Arguments of every emit.
+     * @code
+     * void main() {
+     *  Signal<int, double> s;
+     *  std::vector<std::tuple<int, double>> trades = ...;
+     *  s.emitBatch(trades);
+     * }
+     * @endcode
+     */
+    void emitBatch(BatchType events)
+    {
+        if(events.empty())
+        {
+            return;
+        }
+        this->instrumentation.onEmit(events.size());
+        if constexpr (recorded)
+        {
+            for(const std::tuple<Args...> & event: events)
+            {
+                std::apply([this](const Args&... args) { this->record(args...); }, event);
+            }
+        }
+        const EmitSection section(*this);
+        auto snapshot = this->slots.read();
+        std::apply([this](const Args&... first) { this->awaiters.resume(first...); }, events.front());
+        if(!snapshot)
+        {
+            return;
+        }
+        this->call(section, *snapshot, SignalDetail::Pass::Batch, SignalDetail::ArgPointers(events));
+    }
+
+    /**
+     * @brief emitParallel Call all connected methods at once on a @ref ThreadPool, returns when all returned.
+     * For signals fanning out to many independent, CPU heavy methods. Methods run concurrently and in no
+     * particular order, so they must not share unsynchronized state. Arguments are shared by const reference.
+     * The snapshot is the one of @ref BasicSignal::emit(): connecting or disconnecting meanwhile is safe.
+     * @param pool Pool running the methods, with the calling thread.
+     * @param chunk Number of methods called in a row by one thread, raise it for cheap methods.
+     * @param args Signal parameters, same type as template.
+     * @throw The first exception thrown by a method, once all ran.
+     * @code
+     * void main() {
+     *  ThreadPool pool;
+     *  Signal<const Market &> s;
+     *  s.emitParallel(pool, 4, market);
+     * }
+     * @endcode
+     */
+    void emitParallel(ThreadPool & pool, const std::size_t chunk, const Args&... args)
+    {
+        this->instrumentation.onEmit();
+        this->record(args...);
+        const EmitSection section(*this);
+        auto snapshot = this->slots.read();
+        this->awaiters.resume(args...);
+        if(!snapshot)
+        {
+            return;
+        }
+        this->callParallel(section, *snapshot, pool, chunk, SignalDetail::ArgPointers(args...));
+    }
+
+    /**
+     * @brief emitParallel Call all connected methods at once on a @ref ThreadPool, one method per chunk.
+     * See @ref BasicSignal::emitParallel(ThreadPool & pool, const std::size_t chunk, const Args&... args).
+     * @param pool Pool running the methods, with the calling thread.
+     * @param args Signal parameters, same type as template.
+     */
+    void emitParallel(ThreadPool & pool, const Args&... args)
+    {
+        this->emitParallel(pool, 1, args...);
+    }
+
+    /**
+     * @brief next Wait for the next emit from a coroutine.
+     * The coroutine is resumed by the emitting thread, before the connected methods are called,
+     * with a copy of the arguments. Waiting costs no allocation: the awaiter lives in the coroutine frame.
+     * For @ref BasicSignal::emitBatch(), the coroutine gets the first event.
+     * Coroutines still waiting when the signal is destroyed are never resumed.
+     * @return Awaitable giving a std::tuple of the decayed signal parameters.
+     * @code
+     * SignalTask consume(Signal<int, std::string> & s) {
+     *  for(;;) {
+     *   auto [id, text] = co_await s.next();
+     *  }
+     * }
+     * @endcode
+     */
+    typename SignalDetail::AwaiterList<Args...>::Awaiter next()
+    {
+        return typename SignalDetail::AwaiterList<Args...>::Awaiter(this->awaiters);
+    }
+
+private:
+    /**
+     * @brief Coroutines waiting in @ref BasicSignal::next().
+     */
+    SignalDetail::AwaiterList<Args...> awaiters;
+
+    /**
+     * @brief Give the arguments of an emit to the recorder of a recorded signal, nothing otherwise.
+     */
+    void record(const Args&... args) const
+    {
+        if constexpr (recorded)
+        {
+            this->instrumentation.record(SignalDetail::ArgPointers(args...));
+        }
+    }
+
+    /**
+     * @brief Build what a connect overload stores, see the matching @ref BasicSignal::connect().
+     * @return The callable, or a @ref SignalDetail::Tracked callable.
+     */
+    template<typename Method>
+    requires SignalConcepts::ValidMethod<Method, const Args&...>
+    static auto makeMethod(Method&& method)
+    {
+        return std::forward<Method>(method);
+    }
+
+    template<typename T, typename Method>
+    requires SignalConcepts::ValidClassMethod<T, Method, const Args&...>
+    static auto makeMethod(T* instance, Method&& method)
+    {
+        return [instance, method](auto&&... args) -> decltype(auto) { return (instance->*method)(std::forward<decltype(args)>(args)...); };
+    }
+
+    template<auto Method, typename T>
+    requires SignalConcepts::ValidClassMethod<T, decltype(Method), const Args&...>
+    static auto makeMethod(T* instance)
+    {
+        return SignalDetail::MemberDelegate<Method, T>{instance};
+    }
+
+    template<typename T, typename Method>
+    requires SignalConcepts::ValidClassMethod<T, Method, const Args&...>
+    static auto makeMethod(std::shared_ptr<T>& instance, Method&& method)
+    {
+        //The object is checked by the emit, see SlotTable::forEachLive().
+        return SignalDetail::Tracked{makeMethod(instance.get(), std::forward<Method>(method)), std::weak_ptr<void>(instance)};
+    }
+
+    template<typename Method, typename... BoundArgs>
+    requires SignalConcepts::ValidMethod<Method, BoundArgs..., const Args&...>
+    static auto makeMethod(Method&& method, BoundArgs&&... boundArgs)
+    {
+        return [method = std::forward<Method>(method),
+                ... bound = std::forward<BoundArgs>(boundArgs)](auto&&... args) mutable -> decltype(auto) {
+            return std::invoke(method, bound..., std::forward<decltype(args)>(args)...);
+        };
+    }
+
+    template<typename T, typename Method, typename... BoundArgs>
+    requires SignalConcepts::ValidClassMethod<T, Method, BoundArgs..., const Args&...>
+    static auto makeMethod(T* instance, Method&& method, BoundArgs&&... boundArgs)
+    {
+        return [instance,
+                method = std::forward<Method>(method),
+                ... bound = std::forward<BoundArgs>(boundArgs)](auto&&... args) mutable -> decltype(auto) {
+            return std::invoke(method, instance, bound..., std::forward<decltype(args)>(args)...);
+        };
+    }
+
+    template<typename T, typename Method, typename... BoundArgs>
+    requires SignalConcepts::ValidClassMethod<T, Method, BoundArgs..., const Args&...>
+    static auto makeMethod(std::shared_ptr<T>& instance, Method&& method, BoundArgs&&... boundArgs)
+    {
+        return SignalDetail::Tracked{makeMethod(instance.get(), std::forward<Method>(method), std::forward<BoundArgs>(boundArgs)...),
+                                     std::weak_ptr<void>(instance)};
+    }
+
+    /**
+     * @brief Store what @ref BasicSignal::makeMethod() built and make its connection.
+     * @param made Callable or @ref SignalDetail::Tracked callable.
+     * @param wrap Applied to the callable before storing it, for example to queue its calls.
+     * @param priority See @ref BasicSignal::addMethod().
+     * @return A @ref Connection to the stored method.
      */
-    template <typename Method>
-    void addMethod(const idType id, Method&& method)
+    template<typename Made, typename Wrap = std::identity>
+    Connection<Args...> attach(Made&& made, Wrap&& wrap = {}, const int priority = 0)
     {
-        std::unique_lock<std::mutex> lock(mtx);
-        this->methods.emplace(id, MethodType(method));
+        const idType id = this->route(std::forward<Made>(made), std::forward<Wrap>(wrap), priority,
+                                      [this](auto&& method, std::weak_ptr<void> tracker, const int p) {
+            return this->addMethod(std::forward<decltype(method)>(method), std::move(tracker), p);
+        });
+        return Connection<Args...>(this, id);
     }
 
+    /**
+     * @brief Give what @ref BasicSignal::makeMethod() built to sink, as the callable to store and its tracker.
+     * @param made Callable or @ref SignalDetail::Tracked callable.
+     * @param wrap Applied to the callable before storing it, for example to queue its calls.
+     * @param priority See @ref BasicSignal::addMethod().
+     * @param sink Callable taking (method, std::weak_ptr<void> tracker, int priority), its result is returned.
+     */
+    template<typename Made, typename Wrap, typename Sink>
+    static decltype(auto) route(Made&& made, Wrap&& wrap, const int priority, Sink&& sink)
+    {
+        if constexpr (!SignalDetail::isTracked<std::decay_t<Made>>)
+        {
+            return sink(wrap(std::forward<Made>(made)), std::weak_ptr<void>(), priority);
+        }
+        else if constexpr (std::is_same_v<std::decay_t<Wrap>, std::identity>)
+        {
+            return sink(std::move(made.method), made.object, priority);
+        }
+        else
+        {
+            //Wrapped methods may run after the emit returned, e.g. queued: they lock on their own.
+            return sink(wrap([object = made.object, method = std::move(made.method)](auto&&... args) mutable -> void {
+                if(std::shared_ptr<void> pinned = object.lock())
+                {
+                    method(std::forward<decltype(args)>(args)...);
+                }
+            }), made.object, priority);
+        }
+    }
 
     /**
-     * @brief Change if a method is blocked by id. a blocked method won't be called by @ref Signal::emit().
-     * @param id Id of the method.
-     * @param blocked true/false.
+     * @brief Adapt a method like @ref BasicSignal::addMethod() does, without storing it.
      */
-    void setBlocked(const idType id, const bool blocked)
+    template <template<typename, typename...> class Adapter = MethodAdapter, typename Method>
+    Pending pend(Method&& method, std::weak_ptr<void> tracker = {}, const int priority = 0) const
     {
-        std::lock_guard<std::mutex> lock(mtx);
-        auto it = this->methods.find(id);
-        if(it != this->methods.end())
+        using Stored = Adapter<std::decay_t<Method>, Args...>;
+        const typename MethodType::allocator_type alloc(this->resource);
+        Pending pending{MethodType(), std::move(tracker), priority, {}};
+        if constexpr (instrumented)
+        {
+            pending.stats = std::make_shared<SlotStats>();
+            pending.method = MethodType(std::allocator_arg, alloc, SignalDetail::Timed<Stored>{Stored{std::forward<Method>(method)}, pending.stats});
+        }
+        else
         {
-            it.second.isBlocked = blocked;
+            pending.method = MethodType(std::allocator_arg, alloc, Stored{std::forward<Method>(method)});
         }
+        return pending;
+    }
+
+    /**
+     * @brief Adapt what @ref BasicSignal::makeMethod() built, see @ref BasicSignal::route().
+     */
+    template<typename Made>
+    Pending pendMade(Made&& made, const int priority = 0) const
+    {
+        return route(std::forward<Made>(made), std::identity{}, priority, [this](auto&& method, std::weak_ptr<void> tracker, const int p) {
+            return this->pend(std::forward<decltype(method)>(method), std::move(tracker), p);
+        });
     }
+
+
+    /**
+     * @brief Add a method to be called by next @ref BasicSignal::emit().
+     * The id is reserved right away, the policy may store the method once the running emits are done.
+     * @tparam Adapter How the method is called: @ref SignalDetail::Dispatcher, @ref SignalDetail::ResultDispatcher or @ref SignalDetail::BatchDispatcher.
+     * @param method Static function or lambda.
+     * @param tracker Object the method needs alive to be called, empty if none.
+     * @param priority Methods of higher priority are called first, see @ref BasicSignal::connect(int, ConnectArgs&&...).
+     * @return Id of the method.
+     */
+    template <template<typename, typename...> class Adapter = MethodAdapter, typename Method>
+    idType addMethod(Method&& method, std::weak_ptr<void> tracker = {}, const int priority = 0)
+    {
+        return this->insert(this->template pend<Adapter>(std::forward<Method>(method), std::move(tracker), priority));
+    }
+
+};
+
+/**
+ * @brief The Signal class. This is the Qt way to make the observer/observable pattern.
+ * Uses @ref SignalPolicy::Mutex, give another policy as first parameter to change it.
+ * @tparam Args All arguments that will be emited by the signal.
+ *
+ * @code{.cpp}
+ * Signal<int> s;
+ * Signal<SignalPolicy::LockFree, int> concurrent;
+ * @endcode
+ */
+template<typename... Args>
+class Signal : public BasicSignal<SignalPolicy::Mutex, Args...>
+{
+public:
+    using BasicSignal<SignalPolicy::Mutex, Args...>::BasicSignal;
+};
+
+/**
+ * @brief Signal with an explicit synchronization policy.
+ * @tparam Policy One of @ref SignalPolicy.
+ * @tparam Args All arguments that will be emited by the signal.
+ */
+template<SignalConcepts::SyncPolicy Policy, typename... Args>
+class Signal<Policy, Args...> : public BasicSignal<Policy, Args...>
+{
+public:
+    using BasicSignal<Policy, Args...>::BasicSignal;
+};
+
+/**
+ * @brief Signal whose methods return a result, combined by @ref BasicSignal::emit(Combiner&&, const Args&...).
+ * Signal<void(Args...)> is a plain signal.
+ * @tparam R Result of the methods.
+ * @tparam Args All arguments that will be emited by the signal.
+ *
+ * @code{.cpp}
+ * Signal<bool(const Order &)> validators;
+ * Signal<SignalPolicy::LockFree, double(int)> quotes;
+ * @endcode
+ */
+template<typename R, typename... Args>
+class Signal<R(Args...)> : public BasicSignal<SignalDetail::Returning<SignalPolicy::Mutex, R>, Args...>
+{
+public:
+    using BasicSignal<SignalDetail::Returning<SignalPolicy::Mutex, R>, Args...>::BasicSignal;
+};
+
+/**
+ * @brief Signal whose methods return a result, with an explicit synchronization policy.
+ * @tparam Policy One of @ref SignalPolicy.
+ * @tparam R Result of the methods.
+ * @tparam Args All arguments that will be emited by the signal.
+ */
+template<SignalConcepts::SyncPolicy Policy, typename R, typename... Args>
+class Signal<Policy, R(Args...)> : public BasicSignal<SignalDetail::Returning<Policy, R>, Args...>
+{
+public:
+    using BasicSignal<SignalDetail::Returning<Policy, R>, Args...>::BasicSignal;
 };
 
+/**
+ * @brief Signal for several emitting threads, see @ref SignalPolicy::LockFree.
+ * @tparam Args All arguments that will be emited by the signal.
+ */
+template<typename... Args>
+using ConcurrentSignal = Signal<SignalPolicy::LockFree, Args...>;
+
+/**
+ * @brief Signal used by a single thread, see @ref SignalPolicy::SingleThreaded.
+ * @tparam Args All arguments that will be emited by the signal.
+ */
+template<typename... Args>
+using LocalSignal = Signal<SignalPolicy::SingleThreaded, Args...>;
+
+#include "sharded_signal.h"
+#include "event_bus.h"
 #include "macros.h"
 
 #endif // SIGNAL_H
@@ -0,0 +1,332 @@
+#ifndef SIGNAL_SLOT_POOL_H
+#define SIGNAL_SLOT_POOL_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Thread safe pool of free lists, to keep connect and disconnect off the global allocator.
+ *
+ * Give it to signals with heavy connection churn: slot lists, their reference counts and callables
+ * too big for @ref SIGNAL_METHOD_CAPACITY are then recycled by size class, carved from big chunks.
+ * Each thread allocates from and frees to its own cache without locking. A cache holding too many
+ * blocks of a size gives them back to a shared stack, that a thread with an empty cache takes whole.
+ * Blocks above 2 KiB or over-aligned go to the upstream resource.
+ *
+ * @code{.cpp}
+ * Signal<int> s(&SlotPool::shared());
+ * @endcode
+ */
+class SlotPool : public std::pmr::memory_resource
+{
+    static constexpr std::size_t classCount = 8;
+    static constexpr std::size_t minBlock = 16;
+    static constexpr std::size_t maxBlock = minBlock << (classCount - 1);
+    static constexpr std::size_t chunkSize = 64 * 1024;
+    /**
+     * @brief Free blocks of a size a cache keeps before giving them back.
+     */
+    static constexpr std::size_t cacheLimit = 256;
+
+    struct Block
+    {
+        Block * next;
+    };
+
+    /**
+     * @brief Free blocks and chunk remainder owned by one thread.
+     */
+    struct Cache
+    {
+        std::array<Block *, classCount> heads{};
+        std::array<std::size_t, classCount> counts{};
+        char * bump = nullptr;
+        char * bumpEnd = nullptr;
+    };
+
+    /**
+     * @brief Cache of the current thread in a pool. Pools are told apart by serial, addresses get reused.
+     */
+    struct Binding
+    {
+        std::uint64_t serial = 0;
+        SlotPool * pool = nullptr;
+        Cache * cache = nullptr;
+    };
+
+    /**
+     * @brief Caches of the current thread, given back to their pools when it exits.
+     */
+    struct ThreadBindings
+    {
+        std::array<Binding, 4> entries{};
+        std::size_t next = 0;
+
+        ~ThreadBindings()
+        {
+            for(Binding & binding: this->entries)
+            {
+                unbind(binding);
+            }
+        }
+    };
+
+    /**
+     * @brief Serials of the pools alive, so exiting threads don't touch destroyed ones.
+     */
+    struct Registry
+    {
+        std::mutex mtx;
+        std::vector<std::uint64_t> alive;
+        std::uint64_t nextSerial = 1;
+    };
+
+public:
+    /**
+     * @brief Empty pool.
+     * @param upstream Where chunks and big blocks come from.
+     */
+    explicit SlotPool(std::pmr::memory_resource * upstream = std::pmr::get_default_resource()) : upstream(upstream)
+    {
+        Registry & r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        this->serial = r.nextSerial++;
+        r.alive.push_back(this->serial);
+    }
+
+    SlotPool(const SlotPool &) = delete;
+    SlotPool & operator=(const SlotPool &) = delete;
+
+    /**
+     * @brief Give every chunk back upstream. Blocks still allocated become invalid.
+     */
+    ~SlotPool() override
+    {
+        Registry & r = registry();
+        std::lock_guard<std::mutex> registryLock(r.mtx);
+        std::erase(r.alive, this->serial);
+        std::lock_guard<std::mutex> lock(this->mtx);
+        for(void * chunk: this->chunks)
+        {
+            this->upstream->deallocate(chunk, chunkSize, alignof(std::max_align_t));
+        }
+        for(Cache * cache: this->caches)
+        {
+            delete cache;
+        }
+    }
+
+    /**
+     * @brief Pool shared by the whole program. It outlives the signals built with it, even static ones.
+     * @return The pool.
+     */
+    static SlotPool & shared()
+    {
+        static SlotPool pool;
+        return pool;
+    }
+
+private:
+    std::pmr::memory_resource * upstream;
+    std::uint64_t serial;
+    /**
+     * @brief Blocks given back by caches, per size class. Only pushed to or taken whole, so no ABA.
+     */
+    struct alignas(64) Returned
+    {
+        std::atomic<Block *> head{nullptr};
+    };
+    std::array<Returned, classCount> returned;
+    /**
+     * @brief mtx Protects chunks and caches, taken to grow or when a thread binds or exits.
+     */
+    std::mutex mtx;
+    std::vector<void *> chunks;
+    std::vector<Cache *> caches;
+    /**
+     * @brief Caches of exited threads, empty, to reuse.
+     */
+    std::vector<Cache *> spareCaches;
+
+    static Registry & registry()
+    {
+        static Registry r;
+        return r;
+    }
+
+    static std::size_t classOf(const std::size_t bytes)
+    {
+        std::size_t c = 0;
+        while((minBlock << c) < bytes)
+        {
+            ++c;
+        }
+        return c;
+    }
+
+    void * do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+        if(bytes > maxBlock || alignment > alignof(std::max_align_t))
+        {
+            return this->upstream->allocate(bytes, alignment);
+        }
+        const std::size_t c = classOf(bytes);
+        Cache & cache = this->local();
+        Block * block = cache.heads[c];
+        if(block == nullptr)
+        {
+            block = this->returned[c].head.exchange(nullptr, std::memory_order_acquire);
+            cache.counts[c] = 0;
+        }
+        if(block != nullptr)
+        {
+            cache.heads[c] = block->next;
+            cache.counts[c] -= cache.counts[c] != 0;
+            return block;
+        }
+        const std::size_t size = minBlock << c;
+        if(static_cast<std::size_t>(cache.bumpEnd - cache.bump) < size)
+        {
+            this->grow(cache);
+        }
+        void * p = cache.bump;
+        cache.bump += size;
+        return p;
+    }
+
+    void do_deallocate(void * p, const std::size_t bytes, const std::size_t alignment) override
+    {
+        if(bytes > maxBlock || alignment > alignof(std::max_align_t))
+        {
+            this->upstream->deallocate(p, bytes, alignment);
+            return;
+        }
+        const std::size_t c = classOf(bytes);
+        Cache & cache = this->local();
+        Block * block = static_cast<Block *>(p);
+        block->next = cache.heads[c];
+        cache.heads[c] = block;
+        if(++cache.counts[c] > cacheLimit)
+        {
+            this->giveBack(cache, c);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    /**
+     * @brief Cache of the calling thread, bound on first use.
+     */
+    Cache & local()
+    {
+        thread_local ThreadBindings bindings;
+        for(const Binding & binding: bindings.entries)
+        {
+            if(binding.serial == this->serial)
+            {
+                return *binding.cache;
+            }
+        }
+        Cache * cache;
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            if(this->spareCaches.empty())
+            {
+                cache = new Cache();
+                this->caches.push_back(cache);
+            }
+            else
+            {
+                cache = this->spareCaches.back();
+                this->spareCaches.pop_back();
+            }
+        }
+        Binding & binding = bindings.entries[bindings.next++ % bindings.entries.size()];
+        unbind(binding);
+        binding = Binding{this->serial, this, cache};
+        return *cache;
+    }
+
+    /**
+     * @brief Give a cache back to its pool, if the pool still exists.
+     */
+    static void unbind(Binding & binding)
+    {
+        if(binding.cache == nullptr)
+        {
+            return;
+        }
+        Registry & r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        if(std::find(r.alive.begin(), r.alive.end(), binding.serial) != r.alive.end())
+        {
+            binding.pool->retire(*binding.cache);
+        }
+        binding = Binding{};
+    }
+
+    /**
+     * @brief Empty a cache whose thread is gone and keep it for another thread.
+     */
+    void retire(Cache & cache)
+    {
+        for(std::size_t c = 0; c < classCount; ++c)
+        {
+            this->giveBack(cache, c);
+        }
+        cache.bump = nullptr;
+        cache.bumpEnd = nullptr;
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->spareCaches.push_back(&cache);
+    }
+
+    /**
+     * @brief Move every free block of a size class from a cache to the shared stack.
+     */
+    void giveBack(Cache & cache, const std::size_t c)
+    {
+        Block * first = cache.heads[c];
+        if(first == nullptr)
+        {
+            return;
+        }
+        Block * last = first;
+        while(last->next != nullptr)
+        {
+            last = last->next;
+        }
+        cache.heads[c] = nullptr;
+        cache.counts[c] = 0;
+        Block * head = this->returned[c].head.load(std::memory_order_relaxed);
+        do
+        {
+            last->next = head;
+        }
+        while(!this->returned[c].head.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Give a cache a new chunk to carve blocks from. The rest of the previous one is lost.
+     */
+    void grow(Cache & cache)
+    {
+        void * chunk = this->upstream->allocate(chunkSize, alignof(std::max_align_t));
+        {
+            std::lock_guard<std::mutex> lock(this->mtx);
+            this->chunks.push_back(chunk);
+        }
+        cache.bump = static_cast<char *>(chunk);
+        cache.bumpEnd = cache.bump + chunkSize;
+    }
+};
+
+#endif //SIGNAL_SLOT_POOL_H
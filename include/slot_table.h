@@ -0,0 +1,743 @@
+#ifndef SIGNAL_SLOT_TABLE_H
+#define SIGNAL_SLOT_TABLE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief How emit keeps alive the objects of methods connected through a std::shared_ptr.
+ */
+enum class SignalTracking
+{
+    /**
+     * @brief Lock each object right before calling its method, release it right after.
+     */
+    PerCall,
+    /**
+     * @brief Lock every object once before calling any method and release them after the last one.
+     * Consecutive methods of the same object share one lock, and a batch locks once for all its events.
+     */
+    PerEmit
+};
+
+namespace SignalDetail {
+
+    /**
+     * @brief Alias for signal id type. High half is a generation, low half an index in the handle table.
+     */
+    using idType = std::uint64_t;
+
+    /**
+     * @brief Dense storage of the methods of a signal, structure of arrays.
+     *
+     * Methods are packed by decreasing priority, then in connection order, next to a bitmap of blocked flags,
+     * so emitting walks memory linearly and skips blocked methods 64 at a time.
+     * Ids are stable handles: a generation checked table maps them to the current dense index.
+     * Every array comes from one memory resource, given to the copies too and to Func if it is allocator aware.
+     * @tparam Func Stored callable type.
+     */
+    template<typename Func>
+    class SlotTable
+    {
+        /**
+         * @brief Entry of the handle table.
+         */
+        struct Handle
+        {
+            /**
+             * @brief Bumped every time the handle is freed, so old ids stop matching.
+             */
+            std::uint32_t generation = 1;
+            /**
+             * @brief Dense index of the method, npos when the handle is free.
+             */
+            std::uint32_t index = npos;
+        };
+
+        static constexpr std::uint32_t npos = UINT32_MAX;
+        static constexpr std::size_t wordBits = 64;
+
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        /**
+         * @brief Empty table.
+         * @param alloc Where the arrays are allocated.
+         */
+        explicit SlotTable(const allocator_type & alloc = {})
+            : funcs(alloc), blockedBits(alloc), owners(alloc), trackers(alloc), priorities(alloc), handles(alloc), freeHandles(alloc) {}
+
+        /**
+         * @brief Copy a table, keeping its memory resource.
+         * @param other Table to copy.
+         */
+        SlotTable(const SlotTable & other) : SlotTable(other, other.get_allocator()) {}
+
+        /**
+         * @brief Copy a table into another memory resource.
+         * @param other Table to copy.
+         * @param alloc Where the copy is allocated.
+         */
+        SlotTable(const SlotTable & other, const allocator_type & alloc)
+            : funcs(other.funcs, alloc),
+              blockedBits(other.blockedBits, alloc),
+              blockedCount(other.blockedCount),
+              owners(other.owners, alloc),
+              trackers(other.trackers, alloc),
+              trackedCount(other.trackedCount),
+              tracking(other.tracking),
+              priorities(other.priorities, alloc),
+              handles(other.handles, alloc),
+              freeHandles(other.freeHandles, alloc) {}
+
+        SlotTable & operator=(const SlotTable &) = default;
+
+        /**
+         * @brief Allocator of the arrays.
+         * @return The allocator given at construction.
+         */
+        allocator_type get_allocator() const
+        {
+            return this->funcs.get_allocator();
+        }
+
+        /**
+         * @brief Number of connected methods, blocked or not.
+         * @return Methods count.
+         */
+        std::size_t size() const
+        {
+            return this->funcs.size();
+        }
+
+        /**
+         * @brief Number of connected methods that are not blocked.
+         * @return Active methods count.
+         */
+        std::size_t activeCount() const
+        {
+            return this->funcs.size() - this->blockedCount;
+        }
+
+        /**
+         * @brief Whether no method is connected.
+         * @return true if empty.
+         */
+        bool empty() const
+        {
+            return this->funcs.empty();
+        }
+
+        /**
+         * @brief Call visitor on every method that is not blocked, in connection order.
+         * @param visitor Callable taking a const Func&. If it returns a bool, false stops the walk.
+         * @return false if the visitor stopped the walk.
+         */
+        template<typename Visitor>
+        bool forEachActive(Visitor&& visitor) const
+        {
+            if(this->blockedCount == 0)
+            {
+                for(const Func & func: this->funcs)
+                {
+                    if(!visit(visitor, func))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            const std::size_t count = this->funcs.size();
+            for(std::size_t w = 0; w < this->blockedBits.size(); ++w)
+            {
+                const std::size_t base = w * wordBits;
+                std::uint64_t active = ~this->blockedBits[w];
+                if(count - base < wordBits)
+                {
+                    active &= (std::uint64_t(1) << (count - base)) - 1;
+                }
+                while(active != 0)
+                {
+                    if(!visit(visitor, this->funcs[base + std::countr_zero(active)]))
+                    {
+                        return false;
+                    }
+                    active &= active - 1;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Call visitor on the methods of dense indices [begin, end) that are not blocked, in connection order.
+         * Lets several threads share the methods of one snapshot, see @ref size().
+         * @param begin First index.
+         * @param end Past the last index, at most size().
+         * @param visitor Callable taking a const Func&. If it returns a bool, false stops the walk.
+         * @return false if the visitor stopped the walk.
+         */
+        template<typename Visitor>
+        bool forEachActive(const std::size_t begin, const std::size_t end, Visitor&& visitor) const
+        {
+            for(std::size_t k = begin; k < end; ++k)
+            {
+                if((this->blockedCount == 0 || !this->isBlocked(k)) && !visit(visitor, this->funcs[k]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Objects locked by @ref pin().
+         */
+        struct Pins
+        {
+            /**
+             * @brief One reference per distinct run of methods sharing an object.
+             */
+            std::vector<std::shared_ptr<void>> objects;
+            /**
+             * @brief Whether the method at each dense index may run. Empty when nothing is tracked.
+             */
+            std::vector<bool> alive;
+        };
+
+        /**
+         * @brief Like @ref forEachActive(), skipping methods whose tracked object expired.
+         * Tracked objects are kept alive during their call, see @ref SignalTracking.
+         * @param visitor Callable taking a const Func&. If it returns a bool, false stops the walk.
+         * @param expired Receives the ids of the methods skipped because their object expired.
+         * @return false if the visitor stopped the walk.
+         */
+        template<typename Visitor>
+        bool forEachLive(Visitor&& visitor, std::vector<idType> & expired) const
+        {
+            if(this->trackedCount == 0)
+            {
+                return this->forEachActive(visitor);
+            }
+            if(this->tracking == SignalTracking::PerEmit)
+            {
+                const Pins pins = this->pin(expired);
+                return this->forEachLive(0, this->funcs.size(), pins, visitor);
+            }
+            return this->forEachActive(0, this->funcs.size(), [&](const Func & func) {
+                const std::size_t k = &func - this->funcs.data();
+                if(!isTracked(this->trackers[k]))
+                {
+                    return visit(visitor, func);
+                }
+                if(std::shared_ptr<void> object = this->trackers[k].lock())
+                {
+                    return visit(visitor, func);
+                }
+                expired.push_back(this->idAt(k));
+                return true;
+            });
+        }
+
+        /**
+         * @brief Like @ref forEachActive(std::size_t, std::size_t, Visitor&&) const, skipping methods @ref pin() found expired.
+         * @param begin First index.
+         * @param end Past the last index, at most size().
+         * @param pins Result of pin() on this table.
+         * @param visitor Callable taking a const Func&. If it returns a bool, false stops the walk.
+         * @return false if the visitor stopped the walk.
+         */
+        template<typename Visitor>
+        bool forEachLive(const std::size_t begin, const std::size_t end, const Pins & pins, Visitor&& visitor) const
+        {
+            if(pins.alive.empty())
+            {
+                return this->forEachActive(begin, end, visitor);
+            }
+            return this->forEachActive(begin, end, [&](const Func & func) {
+                return !pins.alive[&func - this->funcs.data()] || visit(visitor, func);
+            });
+        }
+
+        /**
+         * @brief Lock every tracked object once, whatever the @ref SignalTracking mode.
+         * @param expired Receives the ids of the methods whose object expired.
+         * @return The locked objects, to keep while calling methods.
+         */
+        Pins pin(std::vector<idType> & expired) const
+        {
+            Pins pins;
+            if(this->trackedCount == 0)
+            {
+                return pins;
+            }
+            pins.alive.assign(this->funcs.size(), true);
+            const std::weak_ptr<void> * previous = nullptr;
+            bool previousAlive = false;
+            for(std::size_t k = 0; k < this->funcs.size(); ++k)
+            {
+                const std::weak_ptr<void> & tracker = this->trackers[k];
+                if(!isTracked(tracker))
+                {
+                    continue;
+                }
+                if(previous == nullptr || !sameObject(*previous, tracker))
+                {
+                    std::shared_ptr<void> object = tracker.lock();
+                    previousAlive = object != nullptr;
+                    if(previousAlive)
+                    {
+                        pins.objects.push_back(std::move(object));
+                    }
+                    previous = &tracker;
+                }
+                pins.alive[k] = previousAlive;
+                if(!previousAlive)
+                {
+                    expired.push_back(this->idAt(k));
+                }
+            }
+            return pins;
+        }
+
+        /**
+         * @brief Change how tracked objects are kept alive during an emit.
+         * @param mode See @ref SignalTracking.
+         */
+        void setTracking(const SignalTracking mode)
+        {
+            this->tracking = mode;
+        }
+
+        /**
+         * @brief Take the id of a method stored later by @ref insertReserved().
+         * Only touches the handle table, so it is safe while the methods are being visited.
+         * Until then the id matches no method: blocking it does nothing, erasing it cancels the reservation.
+         * @return Id of the future method.
+         */
+        idType reserve()
+        {
+            std::uint32_t handle;
+            if(this->freeHandles.empty())
+            {
+                handle = static_cast<std::uint32_t>(this->handles.size());
+                this->handles.emplace_back();
+            }
+            else
+            {
+                handle = this->freeHandles.back();
+                this->freeHandles.pop_back();
+            }
+            return makeId(this->handles[handle].generation, handle);
+        }
+
+        /**
+         * @brief Store a method under an id given by @ref reserve(), after the methods of the same or higher priority.
+         * @param id Reserved id, not used yet. Ignored if erased since.
+         * @param func Method to store.
+         * @param tracker Object the method needs alive to be called, empty if none.
+         * @param priority Methods of higher priority are called first.
+         */
+        template<typename F>
+        void insertReserved(const idType id, F&& func, std::weak_ptr<void> tracker = {}, const int priority = 0)
+        {
+            const std::uint32_t handle = handleOf(id);
+            if(!this->isReserved(id))
+            {
+                //Erased before being stored.
+                return;
+            }
+            const bool tracked = isTracked(tracker);
+            //Most methods share a priority: they only append.
+            const std::size_t index = this->priorities.empty() || this->priorities.back() >= priority
+                ? this->funcs.size()
+                : std::upper_bound(this->priorities.begin(), this->priorities.end(), priority, std::greater<int>()) - this->priorities.begin();
+            this->funcs.emplace(this->funcs.begin() + index, std::forward<F>(func));
+            this->owners.insert(this->owners.begin() + index, handle);
+            this->trackers.insert(this->trackers.begin() + index, std::move(tracker));
+            this->priorities.insert(this->priorities.begin() + index, priority);
+            if(tracked)
+            {
+                ++this->trackedCount;
+            }
+            if(this->blockedBits.size() * wordBits < this->funcs.size())
+            {
+                this->blockedBits.push_back(0);
+            }
+            for(std::size_t k = this->funcs.size() - 1; k > index; --k)
+            {
+                this->setBit(k, this->isBlocked(k - 1));
+                this->handles[this->owners[k]].index = static_cast<std::uint32_t>(k);
+            }
+            this->setBit(index, false);
+            this->handles[handle].index = static_cast<std::uint32_t>(index);
+        }
+
+        /**
+         * @brief Give back an id of @ref reserve() that won't be used.
+         * @param id Reserved id. Ignored if stored or erased since.
+         */
+        void unreserve(const idType id)
+        {
+            if(this->isReserved(id))
+            {
+                this->release(handleOf(id));
+            }
+        }
+
+        /**
+         * @brief Make room for methods about to be stored, so a batch grows each array once.
+         * @param additional Number of methods.
+         */
+        void reserveSlots(const std::size_t additional)
+        {
+            const std::size_t count = this->funcs.size() + additional;
+            this->funcs.reserve(count);
+            this->owners.reserve(count);
+            this->trackers.reserve(count);
+            this->priorities.reserve(count);
+            this->blockedBits.reserve((count + wordBits - 1) / wordBits);
+        }
+
+        /**
+         * @brief Append a method built from its future id.
+         * @param make Callable taking the idType of the method and returning something convertible to Func.
+         * @param tracker Object the method needs alive to be called, empty if none.
+         * @return Id of the method.
+         */
+        template<typename Factory>
+        idType insertWith(Factory&& make, std::weak_ptr<void> tracker = {})
+        {
+            const idType id = this->reserve();
+            this->insertReserved(id, make(id), std::move(tracker));
+            return id;
+        }
+
+        /**
+         * @brief Append a method.
+         * @param func Method to store.
+         * @param tracker Object the method needs alive to be called, empty if none.
+         * @return Id of the method.
+         */
+        template<typename F>
+        idType insert(F&& func, std::weak_ptr<void> tracker = {})
+        {
+            return this->insertWith([&func](idType) -> F&& { return std::forward<F>(func); }, std::move(tracker));
+        }
+
+        /**
+         * @brief Remove a method, keeping the order of the others.
+         * @param id Id of the method. Ignored if not connected anymore.
+         * @return true if a method was removed.
+         */
+        bool erase(const idType id)
+        {
+            const std::uint32_t index = this->find(id);
+            if(index == npos)
+            {
+                this->unreserve(id);
+                return false;
+            }
+            const std::size_t last = this->funcs.size() - 1;
+            if(this->isBlocked(index))
+            {
+                --this->blockedCount;
+            }
+            for(std::size_t k = index; k < last; ++k)
+            {
+                this->setBit(k, this->isBlocked(k + 1));
+                this->handles[this->owners[k + 1]].index = static_cast<std::uint32_t>(k);
+            }
+            this->setBit(last, false);
+            if(isTracked(this->trackers[index]))
+            {
+                --this->trackedCount;
+            }
+            this->funcs.erase(this->funcs.begin() + index);
+            this->owners.erase(this->owners.begin() + index);
+            this->trackers.erase(this->trackers.begin() + index);
+            this->priorities.erase(this->priorities.begin() + index);
+            if(this->blockedBits.size() * wordBits >= this->funcs.size() + wordBits)
+            {
+                this->blockedBits.pop_back();
+            }
+            this->release(handleOf(id));
+            return true;
+        }
+
+        /**
+         * @brief Remove several methods at once, see @ref erase(const idType id).
+         * The others are compacted in a single pass, whatever the number removed.
+         * @param ids Ids of the methods. Those not connected anymore are ignored.
+         * @return Number of methods removed.
+         */
+        std::size_t erase(std::span<const idType> ids)
+        {
+            if(ids.size() < 2)
+            {
+                return ids.empty() ? 0 : this->erase(ids.front());
+            }
+            std::pmr::vector<std::uint64_t> removed((this->funcs.size() + wordBits - 1) / wordBits, 0, this->funcs.get_allocator());
+            std::size_t count = 0;
+            for(const idType id: ids)
+            {
+                const std::uint32_t index = this->find(id);
+                if(index == npos)
+                {
+                    this->unreserve(id);
+                    continue;
+                }
+                std::uint64_t & word = removed[index / wordBits];
+                const std::uint64_t mask = std::uint64_t(1) << (index % wordBits);
+                if((word & mask) == 0)
+                {
+                    word |= mask;
+                    ++count;
+                }
+            }
+            if(count == 0)
+            {
+                return 0;
+            }
+            std::size_t kept = 0;
+            for(std::size_t k = 0; k < this->funcs.size(); ++k)
+            {
+                const bool blocked = this->isBlocked(k);
+                if((removed[k / wordBits] >> (k % wordBits)) & 1)
+                {
+                    this->blockedCount -= blocked;
+                    this->trackedCount -= isTracked(this->trackers[k]);
+                    this->release(this->owners[k]);
+                    continue;
+                }
+                if(kept != k)
+                {
+                    this->funcs[kept] = std::move(this->funcs[k]);
+                    this->owners[kept] = this->owners[k];
+                    this->trackers[kept] = std::move(this->trackers[k]);
+                    this->priorities[kept] = this->priorities[k];
+                    this->setBit(kept, blocked);
+                    this->handles[this->owners[kept]].index = static_cast<std::uint32_t>(kept);
+                }
+                ++kept;
+            }
+            for(std::size_t k = kept; k < this->funcs.size(); ++k)
+            {
+                this->setBit(k, false);
+            }
+            this->funcs.erase(this->funcs.begin() + kept, this->funcs.end());
+            this->owners.resize(kept);
+            this->trackers.resize(kept);
+            this->priorities.resize(kept);
+            this->blockedBits.resize((kept + wordBits - 1) / wordBits);
+            return count;
+        }
+
+        /**
+         * @brief Change if a method is blocked.
+         * @param id Id of the method. Ignored if not connected anymore.
+         * @param blocked true/false.
+         */
+        void setBlocked(const idType id, const bool blocked)
+        {
+            const std::uint32_t index = this->find(id);
+            if(index == npos || this->isBlocked(index) == blocked)
+            {
+                return;
+            }
+            this->setBit(index, blocked);
+            blocked ? ++this->blockedCount : --this->blockedCount;
+        }
+
+        /**
+         * @brief Change if several methods are blocked.
+         * @param ids Ids of the methods. Those not connected anymore are ignored.
+         * @param blocked true/false.
+         */
+        void setBlocked(std::span<const idType> ids, const bool blocked)
+        {
+            for(const idType id: ids)
+            {
+                this->setBlocked(id, blocked);
+            }
+        }
+
+        /**
+         * @brief Block or unblock every method.
+         * @param blocked true/false.
+         */
+        void setAllBlocked(const bool blocked)
+        {
+            std::fill(this->blockedBits.begin(), this->blockedBits.end(), blocked ? ~std::uint64_t(0) : 0);
+            if(blocked && this->funcs.size() % wordBits != 0)
+            {
+                this->blockedBits.back() = (std::uint64_t(1) << (this->funcs.size() % wordBits)) - 1;
+            }
+            this->blockedCount = blocked ? this->funcs.size() : 0;
+        }
+
+        /**
+         * @brief Remove all methods. Their ids won't match anything afterward.
+         */
+        void clear()
+        {
+            for(const std::uint32_t handle: this->owners)
+            {
+                this->release(handle);
+            }
+            this->funcs.clear();
+            this->owners.clear();
+            this->trackers.clear();
+            this->priorities.clear();
+            this->blockedBits.clear();
+            this->blockedCount = 0;
+            this->trackedCount = 0;
+        }
+
+    private:
+        /**
+         * @brief Packed methods, in connection order.
+         */
+        std::pmr::vector<Func> funcs;
+        /**
+         * @brief Bit k set when funcs[k] is blocked.
+         */
+        std::pmr::vector<std::uint64_t> blockedBits;
+        /**
+         * @brief Number of bits set in blockedBits, lets emit skip the bitmap.
+         */
+        std::size_t blockedCount = 0;
+        /**
+         * @brief Handle of funcs[k], to fix the handle table when methods move.
+         */
+        std::pmr::vector<std::uint32_t> owners;
+        /**
+         * @brief Object funcs[k] needs alive, empty when it tracks nothing.
+         */
+        std::pmr::vector<std::weak_ptr<void>> trackers;
+        /**
+         * @brief Number of non empty trackers, lets emit skip tracking.
+         */
+        std::size_t trackedCount = 0;
+        SignalTracking tracking = SignalTracking::PerCall;
+        /**
+         * @brief Priority of funcs[k], never increasing.
+         */
+        std::pmr::vector<int> priorities;
+        /**
+         * @brief Id to dense index table.
+         */
+        std::pmr::vector<Handle> handles;
+        /**
+         * @brief Free entries of handles.
+         */
+        std::pmr::vector<std::uint32_t> freeHandles;
+
+        /**
+         * @brief Call a visitor on a method.
+         * @return What the visitor returned if it is a bool, true otherwise.
+         */
+        template<typename Visitor>
+        static bool visit(Visitor & visitor, const Func & func)
+        {
+            if constexpr (std::is_same_v<decltype(visitor(func)), bool>)
+            {
+                return visitor(func);
+            }
+            else
+            {
+                visitor(func);
+                return true;
+            }
+        }
+
+        static idType makeId(const std::uint32_t generation, const std::uint32_t handle)
+        {
+            return (idType(generation) << 32) | handle;
+        }
+
+        static std::uint32_t handleOf(const idType id)
+        {
+            return static_cast<std::uint32_t>(id);
+        }
+
+        idType idAt(const std::size_t index) const
+        {
+            return makeId(this->handles[this->owners[index]].generation, this->owners[index]);
+        }
+
+        /**
+         * @brief Whether two trackers share their object, without locking them.
+         */
+        static bool sameObject(const std::weak_ptr<void> & a, const std::weak_ptr<void> & b)
+        {
+            return !a.owner_before(b) && !b.owner_before(a);
+        }
+
+        /**
+         * @brief Whether a tracker was given an object, even one that expired since.
+         */
+        static bool isTracked(const std::weak_ptr<void> & tracker)
+        {
+            return !sameObject(tracker, std::weak_ptr<void>());
+        }
+
+        /**
+         * @brief Dense index of a method.
+         * @param id Id of the method.
+         * @return Its index, npos if the id is stale.
+         */
+        std::uint32_t find(const idType id) const
+        {
+            const std::uint32_t handle = handleOf(id);
+            if(handle >= this->handles.size() || this->handles[handle].generation != static_cast<std::uint32_t>(id >> 32))
+            {
+                return npos;
+            }
+            return this->handles[handle].index;
+        }
+
+        /**
+         * @brief Whether an id was given by @ref reserve() and is neither stored nor erased yet.
+         */
+        bool isReserved(const idType id) const
+        {
+            const std::uint32_t handle = handleOf(id);
+            return handle < this->handles.size()
+                && this->handles[handle].generation == static_cast<std::uint32_t>(id >> 32)
+                && this->handles[handle].index == npos;
+        }
+
+        void release(const std::uint32_t handle)
+        {
+            Handle & h = this->handles[handle];
+            h.index = npos;
+            if(++h.generation == 0)
+            {
+                h.generation = 1;
+            }
+            this->freeHandles.push_back(handle);
+        }
+
+        bool isBlocked(const std::size_t index) const
+        {
+            return (this->blockedBits[index / wordBits] >> (index % wordBits)) & 1;
+        }
+
+        void setBit(const std::size_t index, const bool value)
+        {
+            const std::uint64_t mask = std::uint64_t(1) << (index % wordBits);
+            value ? this->blockedBits[index / wordBits] |= mask : this->blockedBits[index / wordBits] &= ~mask;
+        }
+    };
+}
+
+#endif //SIGNAL_SLOT_TABLE_H
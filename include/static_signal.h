@@ -0,0 +1,116 @@
+#ifndef SIGNAL_STATIC_SIGNAL_H
+#define SIGNAL_STATIC_SIGNAL_H
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature, auto... Slots>
+class StaticSignal;
+
+/**
+ * @brief Signal whose methods are fixed at compile time. Emit is a sequence of direct calls
+ * the compiler can inline: no storage, no lock, no indirection.
+ *
+ * Methods are functions, lambdas without capture, or class methods taking the object as first signal parameter.
+ * @tparam Args Signal parameters.
+ * @tparam Slots Methods, called in order.
+ *
+ * @code{.cpp}
+ * void log(int);
+ * void store(int);
+ * using Saved = StaticSignal<void(int), &log, &store, [](int v){ ... }>;
+ * Saved::emit(1);
+ * @endcode
+ */
+template<typename... Args, auto... Slots>
+class StaticSignal<void(Args...), Slots...>
+{
+    static_assert((std::is_invocable_v<decltype(Slots), const Args&...> && ...),
+                  "Every method of a StaticSignal must be invocable with the signal parameters");
+
+public:
+    /**
+     * @brief Number of methods.
+     */
+    static constexpr std::size_t size = sizeof...(Slots);
+
+    /**
+     * @brief emit Call all methods in order. Arguments are given by const reference.
+     * @param args Signal parameters.
+     */
+    static constexpr void emit(const Args&... args)
+    {
+        (std::invoke(Slots, args...), ...);
+    }
+
+    /**
+     * @brief Same as @ref StaticSignal::emit(), so the signal can itself be connected as a method.
+     * @param args Signal parameters.
+     */
+    constexpr void operator()(const Args&... args) const
+    {
+        emit(args...);
+    }
+};
+
+/**
+ * @brief Fixed set of callables built by @ref make_static_signal(). Holds them by value, emits with direct calls.
+ * @tparam Fs Callables, called in order.
+ */
+template<typename... Fs>
+class StaticSlots
+{
+public:
+    constexpr explicit StaticSlots(Fs... fs) : slots(std::move(fs)...) {}
+
+    /**
+     * @brief Number of callables.
+     */
+    static constexpr std::size_t size = sizeof...(Fs);
+
+    /**
+     * @brief emit Call all callables in order. Arguments are given by const reference.
+     * @param args Arguments, every callable must accept them.
+     */
+    template<typename... A>
+    requires (std::is_invocable_v<const Fs&, const A&...> && ...)
+    constexpr void emit(const A&... args) const
+    {
+        std::apply([&args...](const Fs&... fs) { (std::invoke(fs, args...), ...); }, this->slots);
+    }
+
+    /**
+     * @brief Same as @ref StaticSlots::emit().
+     */
+    template<typename... A>
+    requires (std::is_invocable_v<const Fs&, const A&...> && ...)
+    constexpr void operator()(const A&... args) const
+    {
+        this->emit(args...);
+    }
+
+private:
+    [[no_unique_address]] std::tuple<Fs...> slots;
+};
+
+/**
+ * @brief Build a signal with a fixed set of callables. Captures are allowed, they are stored in the result.
+ * @param fs Callables, called in order.
+ * @return A @ref StaticSlots.
+ * @code
+ * void main() {
+ *  constexpr auto s = make_static_signal(&log, [](int v){ ... });
+ *  s.emit(1);
+ * }
+ * @endcode
+ */
+template<typename... Fs>
+constexpr StaticSlots<std::decay_t<Fs>...> make_static_signal(Fs&&... fs)
+{
+    return StaticSlots<std::decay_t<Fs>...>(std::forward<Fs>(fs)...);
+}
+
+#endif //SIGNAL_STATIC_SIGNAL_H
@@ -0,0 +1,301 @@
+#ifndef SIGNAL_THREAD_POOL_H
+#define SIGNAL_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing pool running the methods of @ref BasicSignal::emitParallel().
+ *
+ * Each worker owns a deque of index ranges. A worker splits its range in halves, keeps the lower one
+ * and pushes the upper one on its deque, until the range is no bigger than the chunk size.
+ * Idle workers steal the oldest, so biggest, ranges from the others.
+ * The thread calling @ref ThreadPool::parallelFor() helps until every chunk is done.
+ *
+ * @code{.cpp}
+ * ThreadPool pool(8);
+ * signal.emitParallel(pool, strategies);
+ * @endcode
+ */
+class ThreadPool
+{
+    /**
+     * @brief One call to @ref ThreadPool::parallelFor(), lives on the stack of its caller.
+     */
+    struct Batch
+    {
+        void (*run)(const void * body, std::size_t begin, std::size_t end);
+        const void * body;
+        std::size_t grain;
+        /**
+         * @brief Indices not run yet, the caller returns when it reaches 0.
+         */
+        std::atomic<std::size_t> remaining;
+        std::mutex errorMtx;
+        std::exception_ptr error;
+    };
+
+    /**
+     * @brief Indices [begin, end) of a batch.
+     */
+    struct Range
+    {
+        Batch * batch;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /**
+     * @brief Ranges of a thread. The owner works at the back, thieves take the front.
+     */
+    struct alignas(64) Queue
+    {
+        std::mutex mtx;
+        std::deque<Range> ranges;
+    };
+
+    /**
+     * @brief Pool and queue of the calling thread, if it is a worker.
+     */
+    struct Worker
+    {
+        const ThreadPool * pool = nullptr;
+        std::size_t index = 0;
+    };
+
+public:
+    /**
+     * @brief Start the workers.
+     * @param threads Number of workers. The default leaves a core to the emitting thread, which also runs methods.
+     */
+    explicit ThreadPool(const std::size_t threads = std::max(std::thread::hardware_concurrency(), 2u) - 1)
+        : queues(threads + 1)
+    {
+        this->workers.reserve(threads);
+        for(std::size_t i = 0; i < threads; ++i)
+        {
+            this->workers.emplace_back([this, i](){ this->work(i); });
+        }
+    }
+
+    /**
+     * @brief Deleted. Workers point to the pool.
+     */
+    ThreadPool(const ThreadPool &) = delete;
+
+    /**
+     * @brief Deleted. Workers point to the pool.
+     */
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Join the workers. No @ref ThreadPool::parallelFor() may be running.
+     */
+    ~ThreadPool()
+    {
+        this->stopping.store(true, std::memory_order_release);
+        this->wake(true);
+        for(std::thread & worker: this->workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Number of workers, without the calling thread.
+     * @return Workers count.
+     */
+    std::size_t size() const
+    {
+        return this->workers.size();
+    }
+
+    /**
+     * @brief Call body over [0, count) split in chunks, on the workers and the calling thread. Returns once all ran.
+     * Can be nested: a body may itself call parallelFor() on any pool.
+     * @param count Number of indices.
+     * @param grain Maximum chunk size given to a single call of body, at least 1.
+     * @param body Callable taking (std::size_t begin, std::size_t end), called concurrently.
+     * @throw The first exception thrown by body, after every chunk ran.
+     */
+    template<typename Body>
+    void parallelFor(const std::size_t count, const std::size_t grain, const Body & body)
+    {
+        const std::size_t chunk = std::max<std::size_t>(grain, 1);
+        if(count <= chunk || this->workers.empty())
+        {
+            body(std::size_t(0), count);
+            return;
+        }
+        Batch batch{[](const void * b, std::size_t begin, std::size_t end) {
+            (*static_cast<const Body *>(b))(begin, end);
+        }, &body, chunk, count, {}, {}};
+
+        const std::size_t self = this->queueOfCaller();
+        this->execute(self, Range{&batch, 0, count});
+        while(batch.remaining.load(std::memory_order_acquire) != 0)
+        {
+            //Other chunks of the batch are still running: help with whatever is left, ours or not.
+            if(!this->runOne(self))
+            {
+                std::this_thread::yield();
+            }
+        }
+        if(batch.error)
+        {
+            std::rethrow_exception(batch.error);
+        }
+    }
+
+private:
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+    /**
+     * @brief Bumped on every push, waited on by idle workers.
+     */
+    std::atomic<std::uint32_t> sequence{0};
+    std::atomic<std::uint32_t> sleepers{0};
+    std::atomic<bool> stopping{false};
+
+    static Worker & current()
+    {
+        thread_local Worker worker;
+        return worker;
+    }
+
+    /**
+     * @brief Queue used by the calling thread: its own for a worker, the shared last one otherwise.
+     */
+    std::size_t queueOfCaller() const
+    {
+        const Worker & worker = current();
+        return worker.pool == this ? worker.index : this->queues.size() - 1;
+    }
+
+    void work(const std::size_t index)
+    {
+        current() = Worker{this, index};
+        while(!this->stopping.load(std::memory_order_acquire))
+        {
+            //Read before looking for work, so a push made after the search wakes us up.
+            const std::uint32_t seen = this->sequence.load(std::memory_order_seq_cst);
+            if(this->runOne(index))
+            {
+                continue;
+            }
+            this->sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if(!this->stopping.load(std::memory_order_acquire))
+            {
+                this->sequence.wait(seen, std::memory_order_seq_cst);
+            }
+            this->sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void wake(const bool all)
+    {
+        this->sequence.fetch_add(1, std::memory_order_seq_cst);
+        if(all)
+        {
+            this->sequence.notify_all();
+        }
+        else if(this->sleepers.load(std::memory_order_seq_cst) != 0)
+        {
+            this->sequence.notify_one();
+        }
+    }
+
+    void push(const std::size_t self, const Range range)
+    {
+        {
+            Queue & queue = this->queues[self];
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            queue.ranges.push_back(range);
+        }
+        this->wake(false);
+    }
+
+    /**
+     * @brief Run one range if there is any.
+     * @param self Queue of the calling thread.
+     * @return true if a range was run.
+     */
+    bool runOne(const std::size_t self)
+    {
+        Range range;
+        if(!this->take(self, range))
+        {
+            return false;
+        }
+        this->execute(self, range);
+        return true;
+    }
+
+    /**
+     * @brief Pop our newest range, or steal the oldest one of another queue.
+     * @param self Queue of the calling thread.
+     * @param range Set to the range taken.
+     * @return false if every queue is empty.
+     */
+    bool take(const std::size_t self, Range & range)
+    {
+        for(std::size_t k = 0; k < this->queues.size(); ++k)
+        {
+            Queue & queue = this->queues[(self + k) % this->queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mtx);
+            if(queue.ranges.empty())
+            {
+                continue;
+            }
+            if(k == 0)
+            {
+                range = queue.ranges.back();
+                queue.ranges.pop_back();
+            }
+            else
+            {
+                range = queue.ranges.front();
+                queue.ranges.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Split a range down to the chunk size, publishing the upper halves, then run the rest.
+     */
+    void execute(const std::size_t self, Range range)
+    {
+        Batch & batch = *range.batch;
+        while(range.end - range.begin > batch.grain)
+        {
+            const std::size_t middle = range.begin + (range.end - range.begin) / 2;
+            this->push(self, Range{range.batch, middle, range.end});
+            range.end = middle;
+        }
+        try
+        {
+            batch.run(batch.body, range.begin, range.end);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(batch.errorMtx);
+            if(!batch.error)
+            {
+                batch.error = std::current_exception();
+            }
+        }
+        //Last access to the batch: once remaining reaches 0 its caller may return.
+        batch.remaining.fetch_sub(range.end - range.begin, std::memory_order_acq_rel);
+    }
+};
+
+#endif //SIGNAL_THREAD_POOL_H
@@ -0,0 +1,151 @@
+#ifndef SIGNAL_TOPOLOGY_H
+#define SIGNAL_TOPOLOGY_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace SignalDetail {
+
+    /**
+     * @brief CPUs of the machine and the NUMA node of each, read once from /sys on Linux.
+     * Elsewhere, or if /sys can't be read, every CPU is on node 0.
+     */
+    class CpuTopology
+    {
+    public:
+        /**
+         * @brief Topology of the machine, read on first use.
+         * @return The topology.
+         */
+        static const CpuTopology & instance()
+        {
+            static const CpuTopology topology;
+            return topology;
+        }
+
+        /**
+         * @brief Number of CPUs, online or not: ids returned by @ref CpuTopology::currentCpu() are below it.
+         */
+        std::size_t cpuCount() const
+        {
+            return this->nodeOfCpu.size();
+        }
+
+        /**
+         * @brief Number of online NUMA nodes, at least 1.
+         */
+        std::size_t nodeCount() const
+        {
+            return this->nodes;
+        }
+
+        /**
+         * @brief NUMA node of a CPU, below @ref CpuTopology::nodeCount(): sparse node ids are numbered from 0 in order.
+         * @param cpu Id of the CPU, 0 if out of range.
+         */
+        std::size_t nodeOf(const std::size_t cpu) const
+        {
+            return cpu < this->nodeOfCpu.size() ? this->nodeOfCpu[cpu] : 0;
+        }
+
+        /**
+         * @brief CPU running the calling thread. Only a hint unless the thread is pinned.
+         * @return Id of the CPU, 0 if unknown.
+         */
+        static std::size_t currentCpu()
+        {
+#if defined(__linux__)
+            const int cpu = sched_getcpu();
+            return cpu < 0 ? 0 : static_cast<std::size_t>(cpu);
+#else
+            return 0;
+#endif
+        }
+
+    private:
+        std::vector<std::size_t> nodeOfCpu;
+        std::size_t nodes = 1;
+
+        CpuTopology()
+        {
+            std::size_t cpus = 1;
+#if defined(__linux__)
+            const long configured = sysconf(_SC_NPROCESSORS_CONF);
+            cpus = configured > 0 ? static_cast<std::size_t>(configured) : 1;
+#endif
+            this->nodeOfCpu.assign(cpus, 0);
+#if defined(__linux__)
+            //Node ids may have holes (node0, node2): the online list names them, counting the directories would stop early.
+            std::ifstream online("/sys/devices/system/node/online");
+            std::string nodeList;
+            if(!std::getline(online, nodeList))
+            {
+                return;
+            }
+            std::size_t index = 0;
+            forEach(nodeList, maxNodes, [this, &index](const std::size_t node) {
+                std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                std::string cpuList;
+                if(std::getline(file, cpuList))
+                {
+                    forEach(cpuList, this->nodeOfCpu.size(), [this, index](const std::size_t cpu) {
+                        this->nodeOfCpu[cpu] = index;
+                    });
+                }
+                ++index;
+            });
+            this->nodes = std::max<std::size_t>(index, 1);
+#endif
+        }
+
+        /**
+         * @brief Bound on node ids, so that a malformed list can't run for long.
+         */
+        static constexpr std::size_t maxNodes = 1 << 16;
+
+        /**
+         * @brief Call a function with each id below limit of a list like "0-3,8-11", up to the first malformed entry.
+         */
+        template<typename F>
+        static void forEach(const std::string & list, const std::size_t limit, F && f)
+        {
+            const char * p = list.data();
+            const char * const end = p + list.size();
+            while(p < end)
+            {
+                std::size_t first = 0;
+                std::from_chars_result r = std::from_chars(p, end, first);
+                if(r.ec != std::errc())
+                {
+                    break;
+                }
+                std::size_t last = first;
+                if(r.ptr < end && *r.ptr == '-')
+                {
+                    r = std::from_chars(r.ptr + 1, end, last);
+                    if(r.ec != std::errc())
+                    {
+                        break;
+                    }
+                }
+                for(std::size_t id = first; id <= last && id < limit; ++id)
+                {
+                    f(id);
+                }
+                p = r.ptr + 1;
+            }
+        }
+    };
+}
+
+#endif //SIGNAL_TOPOLOGY_H
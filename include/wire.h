@@ -0,0 +1,461 @@
+#ifndef SIGNAL_WIRE_H
+#define SIGNAL_WIRE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Compact binary encoding of signal arguments, used by @ref RemoteLink and @ref SignalRecorder.
+ *
+ * Integers are varints, zigzag encoded when signed, so small values take a byte whatever their type.
+ * Floating point values are copied as is: both peers need the same byte order.
+ * Strings, vectors, arrays, pairs, tuples, optionals and aggregates of up to 8 fields are encoded
+ * field by field, with code generated at compile time. Specialize @ref SignalWire::Codec for other types.
+ */
+namespace SignalWire {
+
+    /**
+     * @brief Appends encoded values to a buffer.
+     */
+    class Writer
+    {
+    public:
+        explicit Writer(std::vector<std::byte> & out) : out(out) {}
+
+        void varint(std::uint64_t value)
+        {
+            while(value >= 0x80)
+            {
+                this->out.push_back(static_cast<std::byte>(value | 0x80));
+                value >>= 7;
+            }
+            this->out.push_back(static_cast<std::byte>(value));
+        }
+
+        void raw(const void * data, const std::size_t size)
+        {
+            const std::byte * bytes = static_cast<const std::byte *>(data);
+            this->out.insert(this->out.end(), bytes, bytes + size);
+        }
+
+    private:
+        std::vector<std::byte> & out;
+    };
+
+    /**
+     * @brief Reads encoded values from a buffer. Every read returns false once the input is too short or malformed.
+     */
+    class Reader
+    {
+    public:
+        explicit Reader(std::span<const std::byte> in) : in(in) {}
+
+        bool varint(std::uint64_t & value)
+        {
+            value = 0;
+            for(unsigned shift = 0; shift < 64; shift += 7)
+            {
+                if(this->pos >= this->in.size())
+                {
+                    return false;
+                }
+                const std::uint8_t byte = std::to_integer<std::uint8_t>(this->in[this->pos++]);
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool raw(void * data, const std::size_t size)
+        {
+            if(this->remaining() < size)
+            {
+                return false;
+            }
+            std::memcpy(data, this->in.data() + this->pos, size);
+            this->pos += size;
+            return true;
+        }
+
+        /**
+         * @brief Take the next bytes to read them apart.
+         */
+        bool take(const std::size_t size, std::span<const std::byte> & out)
+        {
+            if(this->remaining() < size)
+            {
+                return false;
+            }
+            out = this->in.subspan(this->pos, size);
+            this->pos += size;
+            return true;
+        }
+
+        std::size_t remaining() const
+        {
+            return this->in.size() - this->pos;
+        }
+
+        std::size_t position() const
+        {
+            return this->pos;
+        }
+
+    private:
+        std::span<const std::byte> in;
+        std::size_t pos = 0;
+    };
+
+    template<typename T>
+    struct Codec;
+}
+
+namespace SignalDetail {
+
+    template<typename>
+    inline constexpr bool dependentFalse = false;
+
+    /**
+     * @brief Converts to anything, to count the fields of an aggregate.
+     */
+    struct AnyField
+    {
+        template<typename T>
+        operator T() const;
+    };
+
+    template<typename T, typename... Fields>
+    constexpr std::size_t fieldCount()
+    {
+        if constexpr (sizeof...(Fields) < 8 && requires { T{Fields{}..., AnyField{}}; })
+        {
+            return fieldCount<T, Fields..., AnyField>();
+        }
+        else
+        {
+            return sizeof...(Fields);
+        }
+    }
+
+    /**
+     * @brief References to the fields of an aggregate, in order.
+     */
+    template<typename T>
+    auto fieldsOf(T & value)
+    {
+        constexpr std::size_t count = fieldCount<std::remove_const_t<T>>();
+        if constexpr (count == 0)
+        {
+            return std::tuple<>();
+        }
+        else if constexpr (count == 1)
+        {
+            auto & [a] = value;
+            return std::tie(a);
+        }
+        else if constexpr (count == 2)
+        {
+            auto & [a, b] = value;
+            return std::tie(a, b);
+        }
+        else if constexpr (count == 3)
+        {
+            auto & [a, b, c] = value;
+            return std::tie(a, b, c);
+        }
+        else if constexpr (count == 4)
+        {
+            auto & [a, b, c, d] = value;
+            return std::tie(a, b, c, d);
+        }
+        else if constexpr (count == 5)
+        {
+            auto & [a, b, c, d, e] = value;
+            return std::tie(a, b, c, d, e);
+        }
+        else if constexpr (count == 6)
+        {
+            auto & [a, b, c, d, e, f] = value;
+            return std::tie(a, b, c, d, e, f);
+        }
+        else if constexpr (count == 7)
+        {
+            auto & [a, b, c, d, e, f, g] = value;
+            return std::tie(a, b, c, d, e, f, g);
+        }
+        else
+        {
+            auto & [a, b, c, d, e, f, g, h] = value;
+            return std::tie(a, b, c, d, e, f, g, h);
+        }
+    }
+
+    template<typename Tuple>
+    void writeAll(SignalWire::Writer & w, const Tuple & values)
+    {
+        std::apply([&w](const auto &... v) { (SignalWire::Codec<std::remove_cvref_t<decltype(v)>>::write(w, v), ...); }, values);
+    }
+
+    template<typename Tuple>
+    bool readAll(SignalWire::Reader & r, Tuple && values)
+    {
+        return std::apply([&r](auto &... v) { return (SignalWire::Codec<std::remove_cvref_t<decltype(v)>>::read(r, v) && ...); }, values);
+    }
+}
+
+namespace SignalWire {
+
+    /**
+     * @brief Encoding of a type: arithmetic, enum or aggregate. Specialize it for other types.
+     * @tparam T Type to encode.
+     */
+    template<typename T>
+    struct Codec
+    {
+        static void write(Writer & w, const T & value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                w.varint(value ? 1 : 0);
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                Codec<std::underlying_type_t<T>>::write(w, static_cast<std::underlying_type_t<T>>(value));
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>)
+            {
+                w.varint(value);
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                const std::int64_t v = value;
+                w.varint(static_cast<std::uint64_t>(v) << 1 ^ static_cast<std::uint64_t>(v >> 63));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                w.raw(&value, sizeof(T));
+            }
+            else if constexpr (std::is_aggregate_v<T>)
+            {
+                SignalDetail::writeAll(w, SignalDetail::fieldsOf(value));
+            }
+            else
+            {
+                static_assert(SignalDetail::dependentFalse<T>, "No SignalWire::Codec for this type, specialize it");
+            }
+        }
+
+        static bool read(Reader & r, T & value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                std::uint64_t v = 0;
+                if(!r.varint(v) || v > 1)
+                {
+                    return false;
+                }
+                value = v == 1;
+                return true;
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                std::underlying_type_t<T> v{};
+                if(!Codec<std::underlying_type_t<T>>::read(r, v))
+                {
+                    return false;
+                }
+                value = static_cast<T>(v);
+                return true;
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>)
+            {
+                std::uint64_t v = 0;
+                if(!r.varint(v) || v > std::numeric_limits<T>::max())
+                {
+                    return false;
+                }
+                value = static_cast<T>(v);
+                return true;
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                std::uint64_t v = 0;
+                if(!r.varint(v))
+                {
+                    return false;
+                }
+                const std::int64_t s = static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+                if(s < std::numeric_limits<T>::min() || s > std::numeric_limits<T>::max())
+                {
+                    return false;
+                }
+                value = static_cast<T>(s);
+                return true;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                return r.raw(&value, sizeof(T));
+            }
+            else if constexpr (std::is_aggregate_v<T>)
+            {
+                return SignalDetail::readAll(r, SignalDetail::fieldsOf(value));
+            }
+            else
+            {
+                static_assert(SignalDetail::dependentFalse<T>, "No SignalWire::Codec for this type, specialize it");
+            }
+        }
+    };
+
+    template<>
+    struct Codec<std::string>
+    {
+        static void write(Writer & w, const std::string & value)
+        {
+            w.varint(value.size());
+            w.raw(value.data(), value.size());
+        }
+
+        static bool read(Reader & r, std::string & value)
+        {
+            std::uint64_t size = 0;
+            if(!r.varint(size) || size > r.remaining())
+            {
+                return false;
+            }
+            value.resize(size);
+            return r.raw(value.data(), size);
+        }
+    };
+
+    template<typename T, typename Allocator>
+    struct Codec<std::vector<T, Allocator>>
+    {
+        static void write(Writer & w, const std::vector<T, Allocator> & value)
+        {
+            w.varint(value.size());
+            for(const T & v: value)
+            {
+                Codec<T>::write(w, v);
+            }
+        }
+
+        static bool read(Reader & r, std::vector<T, Allocator> & value)
+        {
+            std::uint64_t size = 0;
+            //Every element takes a byte at least: bounds what a malformed size allocates.
+            if(!r.varint(size) || size > r.remaining())
+            {
+                return false;
+            }
+            value.clear();
+            value.reserve(size);
+            for(std::uint64_t k = 0; k < size; ++k)
+            {
+                T v{};
+                if(!Codec<T>::read(r, v))
+                {
+                    return false;
+                }
+                value.push_back(std::move(v));
+            }
+            return true;
+        }
+    };
+
+    template<typename T, std::size_t N>
+    struct Codec<std::array<T, N>>
+    {
+        static void write(Writer & w, const std::array<T, N> & value)
+        {
+            for(const T & v: value)
+            {
+                Codec<T>::write(w, v);
+            }
+        }
+
+        static bool read(Reader & r, std::array<T, N> & value)
+        {
+            for(T & v: value)
+            {
+                if(!Codec<T>::read(r, v))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    template<typename A, typename B>
+    struct Codec<std::pair<A, B>>
+    {
+        static void write(Writer & w, const std::pair<A, B> & value)
+        {
+            Codec<A>::write(w, value.first);
+            Codec<B>::write(w, value.second);
+        }
+
+        static bool read(Reader & r, std::pair<A, B> & value)
+        {
+            return Codec<A>::read(r, value.first) && Codec<B>::read(r, value.second);
+        }
+    };
+
+    template<typename... T>
+    struct Codec<std::tuple<T...>>
+    {
+        static void write(Writer & w, const std::tuple<T...> & value)
+        {
+            SignalDetail::writeAll(w, value);
+        }
+
+        static bool read(Reader & r, std::tuple<T...> & value)
+        {
+            return SignalDetail::readAll(r, value);
+        }
+    };
+
+    template<typename T>
+    struct Codec<std::optional<T>>
+    {
+        static void write(Writer & w, const std::optional<T> & value)
+        {
+            w.varint(value.has_value());
+            if(value)
+            {
+                Codec<T>::write(w, *value);
+            }
+        }
+
+        static bool read(Reader & r, std::optional<T> & value)
+        {
+            bool present = false;
+            if(!Codec<bool>::read(r, present))
+            {
+                return false;
+            }
+            if(!present)
+            {
+                value.reset();
+                return true;
+            }
+            return Codec<T>::read(r, value.emplace());
+        }
+    };
+}
+
+#endif //SIGNAL_WIRE_H
@@ -0,0 +1,7 @@
+#include "signals.h"
+
+//The core of every plain policy, built once: translation units defining SIGNAL_COMPILED_CORE only declare them.
+template class SignalDetail::SignalCore<SignalPolicy::Mutex>;
+template class SignalDetail::SignalCore<SignalPolicy::SharedMutex>;
+template class SignalDetail::SignalCore<SignalPolicy::LockFree>;
+template class SignalDetail::SignalCore<SignalPolicy::SingleThreaded>;
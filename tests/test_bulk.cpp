@@ -0,0 +1,149 @@
+#include <signals.h>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+class Widget
+{
+public:
+    void update(int v) { this->total += v; }
+    int total = 0;
+};
+
+int main()
+{
+    //Many methods at once, called in order.
+    Signal<int> s;
+    std::vector<int> order;
+    std::vector<std::function<void(int)>> handlers;
+    for(int i = 0; i < 100; ++i)
+    {
+        handlers.push_back([&order, i](int){ order.push_back(i); });
+    }
+    std::vector<Connection<int>> many = s.connectMany(handlers);
+    assert(many.size() == 100);
+    s.emit(0);
+    assert(order.size() == 100 && order.front() == 0 && order.back() == 99);
+
+    //Disconnect a subset at once: the others keep their order and their ids.
+    std::vector<Connection<int>> odd;
+    for(std::size_t k = 1; k < many.size(); k += 2)
+    {
+        odd.push_back(std::move(many[k]));
+    }
+    s.disconnectMany(odd);
+    order.clear();
+    s.emit(0);
+    assert(order.size() == 50 && order[1] == 2 && order.back() == 98);
+    many[2].block();
+    order.clear();
+    s.emit(0);
+    assert(order.size() == 49 && order[1] == 4);
+    many[2].unblock();
+
+    //Block and unblock everything.
+    s.blockAll();
+    assert(!s.hasActiveListeners());
+    order.clear();
+    s.emit(0);
+    assert(order.empty());
+    s.unblockAll();
+    s.emit(0);
+    assert(order.size() == 50);
+    s.disconnectMany(many);
+    assert(!s.hasActiveListeners());
+
+    //Transactions reserve ids ahead and store everything on commit.
+    std::vector<Widget> widgets(300);
+    std::vector<Connection<int>> connections;
+    {
+        auto batch = s.transaction(16);
+        for(Widget & w: widgets)
+        {
+            connections.push_back(batch.connect(&w, &Widget::update));
+        }
+        s.emit(1);
+        assert(widgets[0].total == 0);
+        //Disconnected before the commit: never stored.
+        connections[10].disconnect();
+    }
+    s.emit(1);
+    assert(widgets[0].total == 1 && widgets[299].total == 1 && widgets[10].total == 0);
+
+    //Other connect overloads and priorities.
+    int first = 0;
+    int sum = 0;
+    std::shared_ptr<Widget> shared = std::make_shared<Widget>();
+    {
+        auto batch = s.transaction();
+        Connection c1 = batch.connect([&sum](int offset, int v){ sum += offset + v; }, 10);
+        Connection c2 = batch.connect(100, [&first, &widgets](int){ first = widgets[0].total; });
+        Connection c3 = batch.connect(shared, &Widget::update);
+        batch.commit();
+        s.emit(1);
+        assert(sum == 11 && first == 1 && widgets[0].total == 2 && shared->total == 1);
+        shared.reset();
+        s.emit(1);
+        assert(sum == 22);
+    }
+
+    //Groups block and unblock each signal at once.
+    Signal<int> other;
+    Widget a;
+    Widget b;
+    Connection ca = s.connect(&a, &Widget::update);
+    Connection cb = other.connect(&b, &Widget::update);
+    ConnectionGroup group;
+    group.add(ca);
+    group.add(cb);
+    group.add(connections[0]);
+    group.blockAll();
+    s.emit(1);
+    other.emit(1);
+    assert(a.total == 0 && b.total == 0 && widgets[0].total == 3);
+    assert(widgets[1].total == 4);
+    group.unblockAll();
+    s.emit(1);
+    other.emit(1);
+    assert(a.total == 1 && b.total == 1 && widgets[0].total == 4);
+
+    //Connections of other signals given to disconnectMany are disconnected too.
+    std::vector<Connection<int>> mixed;
+    mixed.push_back(std::move(ca));
+    mixed.push_back(std::move(cb));
+    s.disconnectMany(mixed);
+    s.emit(1);
+    other.emit(1);
+    assert(a.total == 1 && b.total == 1);
+    s.disconnectMany(connections);
+    assert(!s.hasActiveListeners());
+
+    //Bulk changes made during an emit apply after it.
+    LocalSignal<int> local;
+    std::optional<std::vector<Connection<int>>> added;
+    int calls = 0;
+    Connection trigger = local.connect([&](int){
+        if(!added)
+        {
+            added.emplace(local.connectMany(std::vector<std::function<void(int)>>(5, [&calls](int){ ++calls; })));
+        }
+    });
+    local.emit(0);
+    assert(calls == 0);
+    local.emit(0);
+    assert(calls == 5);
+    local.disconnectMany(*added);
+    local.emit(0);
+    assert(calls == 5);
+
+    //Instrumented batches still get their counters.
+    Signal<SignalPolicy::Instrumented<SignalPolicy::Mutex>, int> counted;
+    std::vector<Connection<int>> tracked = counted.connectMany(std::vector<std::function<void(int)>>(3, [](int){}));
+    counted.emit(0);
+    SignalReport report = counted.stats().report();
+    assert(report.slots.size() == 3 && report.slots[2].calls == 1);
+
+    return 0;
+}
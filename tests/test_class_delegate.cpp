@@ -0,0 +1,39 @@
+#include <signals.h>
+#include <cassert>
+
+class Foo
+{
+    public_signal(sPub, int)
+
+public:
+    int value = 0;
+
+    void emitSig(int i)
+    {
+        sPub.emit(i);
+    }
+
+    void member(int i)
+    {
+        this->value += i;
+    }
+};
+
+int main()
+{
+    Signal<int> s;
+    Foo f;
+
+    Connection c = s.connect<&Foo::member>(&f);
+    s.emit(2);
+    assert(f.value == 2);
+
+    Foo g;
+    Connection c2 = g.connect_sPub<&Foo::member>(&f);
+    g.emitSig(3);
+    assert(f.value == 5);
+
+    using Delegate = SignalDetail::MemberDelegate<&Foo::member, Foo>;
+    static_assert(std::is_trivially_copyable_v<Delegate> && sizeof(Delegate) == sizeof(Foo *));
+    return EXIT_SUCCESS;
+}
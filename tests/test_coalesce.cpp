@@ -0,0 +1,115 @@
+#include <signals.h>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+class Chart
+{
+public:
+    void set(const std::string & s, int v)
+    {
+        this->label = s;
+        this->value = v;
+        ++this->calls;
+    }
+
+    std::string label;
+    std::atomic<int> value{0};
+    std::atomic<int> calls{0};
+};
+
+int main()
+{
+    using namespace std::chrono_literals;
+    Signal<std::string, int> s;
+    Coalescer coalescer;
+
+    //Only the latest arguments are delivered, once per drain.
+    Chart latest;
+    Connection c1 = s.connect(coalescer, SignalThrottle::Latest{}, &latest, &Chart::set);
+    [[maybe_unused]] std::size_t drained = coalescer.drain();
+    assert(drained == 0);
+    s.emit("a", 1);
+    s.emit("b", 2);
+    s.emit("c", 3);
+    assert(latest.calls == 0);
+    drained = coalescer.drain();
+    assert(drained == 1);
+    assert(latest.label == "c" && latest.value == 3 && latest.calls == 1);
+    drained = coalescer.drain();
+    assert(drained == 0);
+
+    //Rate limited: the first drain delivers, the next ones wait for the period and keep the latest value.
+    Chart hourly;
+    Connection c2 = s.connect(coalescer, SignalThrottle::Every{1h}, &hourly, &Chart::set);
+    s.emit("d", 4);
+    drained = coalescer.drain();
+    assert(drained == 2);
+    s.emit("e", 5);
+    drained = coalescer.drain();
+    assert(drained == 1);
+    assert(hourly.value == 4 && latest.value == 5);
+
+    //Debounced: delivered once the emits paused long enough.
+    Chart quiet;
+    Chart instant;
+    Connection c3 = s.connect(coalescer, SignalThrottle::Debounce{1h}, &quiet, &Chart::set);
+    Connection c4 = s.connect(coalescer, SignalThrottle::Debounce{0ns}, &instant, &Chart::set);
+    s.emit("f", 6);
+    coalescer.drain();
+    assert(quiet.calls == 0 && instant.value == 6);
+
+    //Other overloads, and disconnected methods get nothing more.
+    c1.disconnect();
+    c2.disconnect();
+    c3.disconnect();
+    c4.disconnect();
+    std::shared_ptr<Chart> shared = std::make_shared<Chart>();
+    int bound = 0;
+    Connection c5 = s.connect(coalescer, SignalThrottle::Latest{}, shared, &Chart::set);
+    Connection c6 = s.connect(coalescer, SignalThrottle::Latest{}, [&bound](int offset, const std::string &, int v){ bound = offset + v; }, 100);
+    s.emit("g", 7);
+    drained = coalescer.drain();
+    assert(drained == 2);
+    assert(shared->value == 7 && bound == 107 && latest.value == 6);
+    s.emit("h", 8);
+    shared.reset();
+    coalescer.drain();
+    assert(bound == 108);
+
+    //Latest through an executor: one event queued whatever the number of emits.
+    Executor executor;
+    Chart queued;
+    Connection c7 = s.connect(executor, SignalThrottle::Latest{}, &queued, &Chart::set);
+    for(int i = 0; i < 100; ++i)
+    {
+        s.emit("i", i);
+    }
+    [[maybe_unused]] std::size_t polled = executor.poll();
+    assert(polled == 1);
+    assert(queued.value == 99 && queued.calls == 1);
+    s.emit("j", 100);
+    polled = executor.poll();
+    assert(polled == 1 && queued.value == 100);
+
+    //Drained by another thread.
+    Chart threaded;
+    Connection c8 = s.connect(coalescer, SignalThrottle::Latest{}, &threaded, &Chart::set);
+    std::thread t([&coalescer](){ coalescer.run(1ms); });
+    for(int i = 1; i <= 10000; ++i)
+    {
+        s.emit("k", i);
+    }
+    while(threaded.value != 10000)
+    {
+        std::this_thread::yield();
+    }
+    coalescer.stop();
+    t.join();
+    assert(threaded.calls <= 10000);
+
+    return 0;
+}
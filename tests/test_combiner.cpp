@@ -0,0 +1,88 @@
+#include <signals.h>
+#include <array>
+#include <cassert>
+#include <optional>
+#include <string>
+
+class Limit
+{
+public:
+    bool check(int v) { ++this->calls; return v <= this->max; }
+    int max;
+    int calls = 0;
+};
+
+int main()
+{
+    //Stops at the first rejection.
+    Signal<bool(int)> validators;
+    int calls = 0;
+    Limit limit{10};
+    Connection a = validators.connect([&calls](int v){ ++calls; return v > 0; });
+    Connection b = validators.connect(&limit, &Limit::check);
+    Connection c = validators.connect([&calls](int){ ++calls; return true; });
+    [[maybe_unused]] const bool valid = validators.emit(SignalCombiner::AllTrue{}, 5);
+    assert(valid && calls == 2 && limit.calls == 1);
+    [[maybe_unused]] const bool negative = validators.emit(SignalCombiner::AllTrue{}, -1);
+    assert(!negative && calls == 3 && limit.calls == 1);
+    [[maybe_unused]] const bool any = validators.emit(SignalCombiner::AnyTrue{}, 50);
+    assert(any && calls == 4 && limit.calls == 1);
+
+    //A plain emit calls every method and discards the results.
+    validators.emit(50);
+    assert(calls == 6 && limit.calls == 2);
+
+    //No method: the combiner's own answer.
+    Signal<int(int)> empty;
+    [[maybe_unused]] const int emptySum = empty.emit(SignalCombiner::Sum<int>{}, 1);
+    [[maybe_unused]] const std::optional<int> emptyMax = empty.emit(SignalCombiner::Max<int>{}, 1);
+    assert(emptySum == 0 && !emptyMax);
+
+    //Reductions, bound arguments and blocked methods.
+    Signal<int(int)> values;
+    Connection d = values.connect([](int v){ return v; });
+    Connection e = values.connect([](int k, int v){ return k * v; }, 3);
+    Connection f = values.connect([](int v){ return -v; });
+    [[maybe_unused]] const int sum = values.emit(SignalCombiner::Sum<int>{}, 2);
+    [[maybe_unused]] const std::optional<int> min = values.emit(SignalCombiner::Min<int>{}, 2);
+    [[maybe_unused]] const std::optional<int> max = values.emit(SignalCombiner::Max<int>{}, 2);
+    assert(sum == 6 && *min == -2 && *max == 6);
+    f.block();
+    [[maybe_unused]] const std::optional<int> unblockedMin = values.emit(SignalCombiner::Min<int>{}, 2);
+    assert(*unblockedMin == 2);
+
+    //Results go to the caller's buffer, the emit stops once it is full.
+    f.unblock();
+    std::array<int, 2> buffer{};
+    std::span<int> got = values.emit(SignalCombiner::Collect(std::span<int>(buffer)), 1);
+    assert(got.size() == 2 && got[0] == 1 && got[1] == 3);
+
+    //First answer wins, priorities give the order.
+    Signal<SignalPolicy::LockFree, std::optional<std::string>(int)> lookup;
+    Connection g = lookup.connect([](int) -> std::optional<std::string> { return std::nullopt; });
+    Connection h = lookup.connect([](int v) -> std::optional<std::string> { return std::to_string(v); });
+    Connection i = lookup.connect(10, [](int v) -> std::optional<std::string> {
+        return v == 0 ? std::optional<std::string>("zero") : std::nullopt;
+    });
+    [[maybe_unused]] const std::optional<std::string> zero = lookup.emit(SignalCombiner::FirstNonEmpty<std::optional<std::string>>{}, 0);
+    [[maybe_unused]] const std::optional<std::string> seven = lookup.emit(SignalCombiner::FirstNonEmpty<std::optional<std::string>>{}, 7);
+    assert(*zero == "zero" && *seven == "7");
+
+    //Tracked objects and class methods known at compile time.
+    std::shared_ptr<Limit> tracked = std::make_shared<Limit>(Limit{0});
+    Signal<bool(int)> owned;
+    Connection j = owned.connect(tracked, &Limit::check);
+    Connection k = owned.connect<&Limit::check>(&limit);
+    [[maybe_unused]] const bool limited = owned.emit(SignalCombiner::AllTrue{}, 1);
+    assert(!limited);
+    tracked.reset();
+    [[maybe_unused]] const bool released = owned.emit(SignalCombiner::AllTrue{}, 1);
+    assert(released);
+
+    //void result: a plain signal.
+    Signal<void(int)> plain;
+    Connection l = plain.connect([&calls](int v){ calls += v; });
+    plain.emit(100);
+    assert(calls == 106);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+#include <signals.h>
+#include <cassert>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main()
+{
+    Signal<int> s1;
+    Signal<std::string> s2;
+    int calls = 0;
+
+    std::vector<Connection<int>> ints;
+    for(int i = 0; i < 40; ++i)
+    {
+        ints.push_back(s1.connect([&calls](int v){ calls += v; }));
+    }
+    Connection<std::string> text = s2.connect([&calls](const std::string &){ ++calls; });
+    Connection<int> kept = s1.connect([&calls](int){ calls += 100; });
+    {
+        ConnectionGroup group;
+        assert(group.empty());
+        for(Connection<int> & c: ints)
+        {
+            group.add(c);
+        }
+        group.add(text);
+        group.add(kept);
+        group.remove(kept);
+
+        //Moving keeps the group membership, disconnecting leaves it.
+        Connection<int> moved = std::move(ints[0]);
+        ints[0] = std::move(moved);
+        ints[1].disconnect();
+        s1.emit(1);
+        s2.emit("a");
+        assert(calls == 39 + 100 + 1);
+    }
+    //Destroying the group disconnected its members only.
+    calls = 0;
+    s1.emit(1);
+    s2.emit("a");
+    assert(calls == 100);
+
+    //Explicit teardown, then the connections are reusable.
+    ConnectionGroup group;
+    ints[2] = s1.connect([&calls](int){ ++calls; });
+    group.add(ints[2]);
+    group.add(kept);
+    group.disconnectAll();
+    assert(group.empty());
+    calls = 0;
+    s1.emit(1);
+    assert(calls == 0);
+    ints[2] = s1.connect([&calls](int){ ++calls; });
+    s1.emit(1);
+    assert(calls == 1);
+
+    //A connection can only be in one group at a time.
+    ConnectionGroup other;
+    group.add(ints[2]);
+    other.add(ints[2]);
+    assert(group.empty() && !other.empty());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+#include <signals.h>
+#include <cassert>
+#include <coroutine>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Coroutine type keeping its frame, to destroy it while it waits.
+ */
+struct Held
+{
+    struct promise_type
+    {
+        Held get_return_object() { return Held{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    ~Held()
+    {
+        this->handle.destroy();
+    }
+};
+
+SignalTask collect(Signal<int, std::string> & s, std::vector<std::string> & out, const int count)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        auto [id, text] = co_await s.next();
+        out.push_back(std::to_string(id) + text);
+    }
+}
+
+Held waitOnce(Signal<int> & s, int & out)
+{
+    auto [v] = co_await s.next();
+    out = v;
+}
+
+int main()
+{
+    //A coroutine resumes on each emit until it is done.
+    Signal<int, std::string> s;
+    std::vector<std::string> out;
+    collect(s, out, 2);
+    assert(out.empty());
+    s.emit(1, "a");
+    s.emit(2, "b");
+    s.emit(3, "c");
+    assert((out == std::vector<std::string>{"1a", "2b"}));
+
+    //Several waiters resume in order, batches give their first event.
+    std::vector<std::string> first;
+    std::vector<std::string> second;
+    collect(s, first, 1);
+    collect(s, second, 2);
+    std::vector<std::tuple<int, std::string>> events{{4, "d"}, {5, "e"}};
+    s.emitBatch(events);
+    assert((first == std::vector<std::string>{"4d"}));
+    assert((second == std::vector<std::string>{"4d"}));
+    std::string moved = "f";
+    s.emitMove(6, std::move(moved));
+    assert((second == std::vector<std::string>{"4d", "6f"}));
+
+    //Coroutine slots start on emit and wait for another signal without blocking it.
+    Signal<int> orders;
+    Signal<int> fills;
+    int done = 0;
+    Connection c = orders.connect([&fills, &done](int order) -> SignalTask {
+        auto [fill] = co_await fills.next();
+        done += order * fill;
+    });
+    orders.emit(2);
+    orders.emit(3);
+    assert(done == 0);
+    fills.emit(10);
+    assert(done == 50);
+    fills.emit(10);
+    assert(done == 50);
+
+    //A coroutine destroyed while waiting leaves the list.
+    int value = 0;
+    {
+        Held held = waitOnce(fills, value);
+        Held other = waitOnce(fills, value);
+    }
+    fills.emit(7);
+    assert(value == 0);
+    {
+        Held held = waitOnce(fills, value);
+        fills.emit(8);
+    }
+    assert(value == 8);
+    return EXIT_SUCCESS;
+}
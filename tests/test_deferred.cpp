@@ -0,0 +1,263 @@
+#include <signals.h>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Counts what goes through it, forwards to new/delete.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations = 0;
+
+private:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++this->allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief Forwards to new/delete, or throws std::bad_alloc while failing is set.
+ */
+class FailingResource : public std::pmr::memory_resource
+{
+public:
+    bool failing = false;
+
+private:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if(this->failing)
+        {
+            throw std::bad_alloc();
+        }
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+template<typename Policy>
+void oneShots()
+{
+    //Methods disconnecting themselves during an emit: one copy of the list for all of them.
+    CountingResource counting;
+    Signal<Policy, int> s(&counting);
+    std::vector<std::optional<Connection<int>>> shots(200);
+    int calls = 0;
+    for(std::optional<Connection<int>> & shot: shots)
+    {
+        shot.emplace(s.connect([&calls, &shot](int) {
+            ++calls;
+            shot->disconnect();
+        }));
+    }
+    [[maybe_unused]] const std::size_t before = counting.allocations;
+    s.emit(1);
+    assert(calls == 200 && !s.hasActiveListeners());
+    //The list and its arrays, not 200 times over.
+    assert(counting.allocations - before < 32);
+    s.emit(1);
+    assert(calls == 200);
+}
+
+template<typename Policy>
+void semantics()
+{
+    Signal<Policy, int> s;
+    std::vector<int> order;
+
+    //Changes wait for the outermost emit, or for a nested one to start.
+    std::optional<Connection<int>> second;
+    Connection<int> first = s.connect([&](int depth) {
+        order.push_back(1);
+        if(depth == 0)
+        {
+            second->disconnect();
+            //Still counted until the emit returns.
+            assert(s.hasActiveListeners());
+            //Another thread sees the signal as it was.
+            bool seen = false;
+            std::thread other([&s, &seen]() { seen = s.hasActiveListeners(); });
+            other.join();
+            assert(seen);
+            s.emit(1);
+        }
+    });
+    second.emplace(s.connect([&order](int) { order.push_back(2); }));
+    s.emit(0);
+    if constexpr (std::is_same_v<Policy, SignalPolicy::SingleThreaded>)
+    {
+        //The live list is only changed once no emit visits it.
+        assert((order == std::vector<int>{1, 1, 2, 2}));
+    }
+    else
+    {
+        assert((order == std::vector<int>{1, 1, 2}));
+    }
+    order.clear();
+    s.emit(1);
+    assert((order == std::vector<int>{1}));
+
+    //A connect after a queued change sees it, instead of being undone by it.
+    //The method connected isn't called by the emit connecting it.
+    order.clear();
+    Signal<Policy, int> t;
+    std::optional<Connection<int>> added;
+    Connection<int> resets = t.connect([&](int) {
+        t.disconnectAll();
+        added.emplace(t.connect([&order](int) { order.push_back(4); }));
+    });
+    t.emit(0);
+    assert(t.hasActiveListeners() && order.empty());
+    t.emit(0);
+    assert((order == std::vector<int>{4}));
+
+    //A method throwing doesn't lose the changes made before.
+    Signal<Policy, int> u;
+    std::optional<Connection<int>> thrower;
+    thrower.emplace(u.connect([&thrower](int) {
+        thrower->disconnect();
+        throw std::runtime_error("failed");
+    }));
+    [[maybe_unused]] bool thrown = false;
+    try
+    {
+        u.emit(0);
+    }
+    catch(const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown && !u.hasActiveListeners());
+
+    //Outside of an emit, changes are published right away.
+    Connection<int> plain = u.connect([](int) {});
+    assert(u.hasActiveListeners());
+    plain.disconnect();
+    assert(!u.hasActiveListeners());
+}
+
+template<typename Policy>
+void nestedAfterDisconnect()
+{
+    //A nested emit doesn't call a method disconnected before it started: its object may be gone.
+    struct Counter
+    {
+        int calls = 0;
+    };
+    Signal<Policy, int> s;
+    std::unique_ptr<Counter> target = std::make_unique<Counter>();
+    Counter * raw = target.get();
+    Connection<int> counted = s.connect([raw](int) { ++raw->calls; });
+    int nested = 0;
+    Connection<int> killer = s.connect([&](int depth) {
+        if(depth == 0)
+        {
+            assert(target->calls == 1);
+            counted.disconnect();
+            target.reset();
+            s.emit(1);
+        }
+        else
+        {
+            ++nested;
+        }
+    });
+    s.emit(0);
+    assert(nested == 1 && !target);
+}
+
+template<typename Policy>
+void destroyedByMethod()
+{
+    //A method destroying the object owning the signal: its connections queue disconnects, then the signal goes.
+    struct Owner
+    {
+        Signal<Policy, int> s;
+        Connection<int> a;
+        Connection<int> b;
+    };
+    std::unique_ptr<Owner> owner = std::make_unique<Owner>();
+    int calls = 0;
+    owner->a = owner->s.connect([&owner, &calls](int) {
+        ++calls;
+        owner.reset();
+    });
+    owner->b = owner->s.connect([&calls](int) { ++calls; });
+    owner->s.emit(0);
+    //The emit keeps its snapshot: the second method is still called.
+    assert(calls == 2 && !owner);
+}
+
+template<typename Policy>
+void unwinding()
+{
+    //Publishing the changes fails while a method's exception unwinds the emit: the exception goes through.
+    FailingResource failing;
+    Signal<Policy, int> s(&failing);
+    std::optional<Connection<int>> doomed;
+    doomed.emplace(s.connect([&doomed, &failing](int) {
+        doomed->disconnect();
+        failing.failing = true;
+        throw std::runtime_error("failed");
+    }));
+    [[maybe_unused]] bool thrown = false;
+    try
+    {
+        s.emit(0);
+    }
+    catch(const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    failing.failing = false;
+    assert(thrown);
+}
+
+int main()
+{
+    oneShots<SignalPolicy::Mutex>();
+    oneShots<SignalPolicy::SharedMutex>();
+    oneShots<SignalPolicy::LockFree>();
+    oneShots<SignalPolicy::SingleThreaded>();
+    semantics<SignalPolicy::Mutex>();
+    semantics<SignalPolicy::LockFree>();
+    semantics<SignalPolicy::SingleThreaded>();
+    nestedAfterDisconnect<SignalPolicy::Mutex>();
+    nestedAfterDisconnect<SignalPolicy::SharedMutex>();
+    nestedAfterDisconnect<SignalPolicy::LockFree>();
+    unwinding<SignalPolicy::Mutex>();
+    unwinding<SignalPolicy::SharedMutex>();
+    destroyedByMethod<SignalPolicy::Mutex>();
+    destroyedByMethod<SignalPolicy::SharedMutex>();
+    return 0;
+}
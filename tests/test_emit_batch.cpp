@@ -0,0 +1,32 @@
+#include <signals.h>
+#include <cassert>
+#include <tuple>
+#include <vector>
+
+int main()
+{
+    Signal<int, int> s;
+    int sum = 0;
+    std::vector<std::size_t> batchSizes;
+
+    Connection c1 = s.connect([&sum](int a, int b){ sum += a * b; });
+    Connection c2 = s.connectBatch([&batchSizes](std::span<const std::tuple<int, int>> events){
+        batchSizes.push_back(events.size());
+    });
+
+    std::vector<std::tuple<int, int>> events{{1, 2}, {3, 4}, {5, 6}};
+    s.emitBatch(events);
+    assert(sum == 2 + 12 + 30);
+    assert(batchSizes == std::vector<std::size_t>{3});
+
+    //A single emit reaches batch methods as a batch of one.
+    s.emit(1, 1);
+    assert(sum == 45);
+    assert((batchSizes == std::vector<std::size_t>{3, 1}));
+
+    c1.block();
+    s.emitBatch(events);
+    assert(sum == 45);
+    assert(batchSizes.size() == 3);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+#include <signals.h>
+#include <cassert>
+#include <memory>
+
+struct Payload
+{
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    Payload() = default;
+    Payload(const Payload &) { ++copies; }
+    Payload(Payload &&) noexcept { ++moves; }
+};
+
+class Foo
+{
+public:
+    int calls = 0;
+
+    void byRef(const Payload &)
+    {
+        ++this->calls;
+    }
+
+    void byValue(Payload)
+    {
+        ++this->calls;
+    }
+};
+
+int main()
+{
+    Signal<Payload> s;
+    Foo foo;
+
+    //Methods taking const references never copy.
+    Connection c1 = s.connect(&foo, &Foo::byRef);
+    Connection c2 = s.connect<&Foo::byRef>(&foo);
+    Connection c3 = s.connect([](const Payload &){});
+
+    Payload p;
+    s.emit(p);
+    assert(Payload::copies == 0 && Payload::moves == 0);
+    assert(foo.calls == 2);
+
+    //Methods taking values copy once each, except the last one with emitMove.
+    Connection c4 = s.connect([](Payload){});
+    Connection c5 = s.connect([](Payload){});
+    s.emit(p);
+    assert(Payload::copies == 2 && Payload::moves == 0);
+
+    Payload::copies = 0;
+    s.emitMove(std::move(p));
+    assert(Payload::copies == 1 && Payload::moves == 1);
+
+    //A tracked method connected last whose object expired doesn't take the move.
+    std::shared_ptr<Foo> gone = std::make_shared<Foo>();
+    Connection c7 = s.connect(gone, &Foo::byValue);
+    gone.reset();
+    Payload::copies = 0;
+    Payload::moves = 0;
+    Payload q;
+    s.emitMove(std::move(q));
+    assert(Payload::copies == 1 && Payload::moves == 1);
+
+    //References still reach the methods untouched.
+    Signal<int&> ref;
+    Connection c6 = ref.connect([](int& i){ ++i; });
+    int i = 0;
+    ref.emit(i);
+    ref.emitMove(i);
+    assert(i == 2);
+    return EXIT_SUCCESS;
+}
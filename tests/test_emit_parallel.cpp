@@ -0,0 +1,94 @@
+#include <signals.h>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    ThreadPool pool(3);
+    assert(pool.size() == 3);
+
+    Signal<int> s;
+    std::atomic<int> sum{0};
+    std::mutex mtx;
+    std::set<std::thread::id> threads;
+    std::vector<Connection<int>> connections;
+    for(int i = 0; i < 64; ++i)
+    {
+        connections.push_back(s.connect([&, i](int v){
+            //Busy enough for the other threads to steal.
+            volatile int spin = 0;
+            for(int k = 0; k < 20000; ++k)
+            {
+                spin = spin + k;
+            }
+            sum += v * i;
+            std::lock_guard<std::mutex> lock(mtx);
+            threads.insert(std::this_thread::get_id());
+        }));
+    }
+
+    //Every method runs exactly once, and emitParallel returns after all of them.
+    s.emitParallel(pool, 2);
+    assert(sum == 2 * (63 * 64 / 2));
+
+    //Blocked methods are skipped, whatever the chunk size.
+    connections[0].block();
+    connections[63].block();
+    sum = 0;
+    s.emitParallel(pool, 5, 1);
+    assert(sum == 63 * 64 / 2 - 63);
+    connections[0].unblock();
+    connections[63].unblock();
+
+    //Disconnecting during a parallel emit acts on the next one.
+    Signal<> s2;
+    std::atomic<int> calls{0};
+    std::vector<Connection<>> connections2(16);
+    for(Connection<> & c: connections2)
+    {
+        c = s2.connect([&calls, &connections2](){
+            ++calls;
+            for(Connection<> & other: connections2)
+            {
+                other.disconnect();
+            }
+        });
+    }
+    s2.emitParallel(pool);
+    assert(calls == 16);
+    s2.emitParallel(pool);
+    assert(calls == 16);
+
+    //Nested calls, and the first exception reaches the caller once every method ran.
+    Signal<int> s3;
+    std::atomic<int> nested{0};
+    Connection c1 = s3.connect([&](int v){
+        s.emitParallel(pool, v);
+        ++nested;
+    });
+    Connection c2 = s3.connect([](int){ throw std::runtime_error("slot"); });
+    Connection c3 = s3.connect([&nested](int){ ++nested; });
+    [[maybe_unused]] bool thrown = false;
+    try
+    {
+        s3.emitParallel(pool, 1);
+    }
+    catch(const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(nested == 2);
+
+    //Without workers everything runs on the calling thread.
+    ThreadPool inlinePool(0);
+    threads.clear();
+    s.emitParallel(inlinePool, 3);
+    assert(threads.size() == 1 && *threads.begin() == std::this_thread::get_id());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include <signals.h>
+#include <cassert>
+#include <string>
+#include <vector>
+
+struct OrderFilled
+{
+    long id;
+    double price;
+};
+
+struct OrderCancelled
+{
+    long id;
+};
+
+class Heartbeat
+{
+public:
+    explicit Heartbeat(std::string from) : from(std::move(from)) {}
+    std::string from;
+};
+
+class Book
+{
+public:
+    void onFill(const OrderFilled & f) { this->filled += f.price; }
+    double filled = 0;
+};
+
+class Exchange
+{
+    public_bus(events, OrderFilled, OrderCancelled)
+
+public:
+    void fill(long id, double price)
+    {
+        this->events.emit<OrderFilled>(id, price);
+    }
+};
+
+int main()
+{
+    using Bus = EventBus<OrderFilled, OrderCancelled, Heartbeat>;
+    Bus bus;
+    assert(!bus.hasActiveListeners<OrderFilled>());
+
+    //Each event reaches the methods of its type only.
+    Book book;
+    std::vector<long> cancelled;
+    Connection c1 = bus.connect<OrderFilled>(&book, &Book::onFill);
+    Connection c2 = bus.connect<OrderCancelled>([&cancelled](const OrderCancelled & c){ cancelled.push_back(c.id); });
+    assert(bus.hasActiveListeners<OrderFilled>() && !bus.hasActiveListeners<Heartbeat>());
+    bus.emit(OrderFilled{1, 2.5});
+    bus.emit<OrderFilled>(2, 1.5);
+    bus.emit<OrderCancelled>(3);
+    bus.emit<Heartbeat>("gateway");
+    assert(book.filled == 4.0 && cancelled == std::vector<long>{3});
+
+    //Methods for every event, called after those of the type.
+    std::vector<std::size_t> seen;
+    std::string from;
+    Connection c3 = bus.connectAll([&](const Bus::Any & e){
+        seen.push_back(e.index());
+        if([[maybe_unused]] const OrderFilled * f = e.get<OrderFilled>())
+        {
+            assert(book.filled == 4.0 + f->price);
+        }
+        e.visit([&from](const auto & event){
+            if constexpr (std::is_same_v<std::decay_t<decltype(event)>, Heartbeat>)
+            {
+                from = event.from;
+            }
+        });
+    });
+    assert(bus.hasActiveListeners<Heartbeat>());
+    bus.emit(OrderFilled{4, 1.0});
+    const Heartbeat beat("risk");
+    bus.emit(beat);
+    assert((seen == std::vector<std::size_t>{0, 2}) && from == "risk");
+    c3.disconnect();
+    bus.emit<Heartbeat>("none");
+    assert(seen.size() == 2 && !bus.hasActiveListeners<Heartbeat>());
+
+    //The signal of a type keeps all its features.
+    int batched = 0;
+    Connection c4 = bus.signal<OrderCancelled>().connect([&batched](const OrderCancelled &){ ++batched; });
+    bus.signal<OrderCancelled>().emitLazy([](){ return OrderCancelled{5}; });
+    assert(batched == 1 && cancelled.size() == 2);
+
+    //Other policies.
+    EventBus<SignalPolicy::SingleThreaded, OrderFilled, Heartbeat> local;
+    double last = 0;
+    Connection c5 = local.connect<OrderFilled>([&last](const OrderFilled & f){ last = f.price; });
+    local.emit<OrderFilled>(1, 9.0);
+    assert(last == 9.0);
+
+    //Declared with the macros.
+    Exchange exchange;
+    double sum = 0;
+    int all = 0;
+    Connection c6 = exchange.connect_events<OrderFilled>([&sum](const OrderFilled & f){ sum += f.price; });
+    Connection c7 = exchange.connectAll_events([&all](const EventRef<OrderFilled, OrderCancelled> &){ ++all; });
+    exchange.fill(1, 3.0);
+    assert(sum == 3.0 && all == 1);
+
+    return 0;
+}
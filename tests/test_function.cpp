@@ -0,0 +1,56 @@
+#include <function.h>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <string>
+
+static int twice(int i)
+{
+    return 2 * i;
+}
+
+int main()
+{
+    //Function pointers and small lambdas are stored inline.
+    SmallFunction<int(int)> f = &twice;
+    assert(f(2) == 4);
+    static_assert(SmallFunction<int(int)>::isStoredInline<decltype(&twice)>);
+
+    int base = 10;
+    SmallFunction<int(int)> g = [&base](int i){ return base + i; };
+    SmallFunction<int(int)> copy = g;
+    assert(copy(1) == 11);
+
+    //Bigger callables fall back to the heap.
+    std::string big(100, 'x');
+    auto heavy = [big, pad = std::array<char, 64>{}](int i){ return static_cast<int>(big.size()) + i; };
+    static_assert(!SmallFunction<int(int)>::isStoredInline<decltype(heavy)>);
+    SmallFunction<int(int)> h = heavy;
+    SmallFunction<int(int)> moved = std::move(h);
+    assert(!h);
+    assert(moved(1) == 101);
+
+    //A capacity big enough keeps it inline.
+    InplaceFunction<int(int), 128> inplace = heavy;
+    assert(inplace(0) == 100);
+
+    //Move only callables.
+    auto owned = std::make_unique<int>(5);
+    MoveOnlyFunction<int()> m = [p = std::move(owned)](){ return *p; };
+    MoveOnlyFunction<int()> m2 = std::move(m);
+    assert(m2() == 5);
+
+    //Calling an empty function throws like std::function.
+    SmallFunction<void()> empty;
+    [[maybe_unused]] bool thrown = false;
+    try
+    {
+        empty();
+    }
+    catch(const std::bad_function_call &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+#include <signals.h>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <string>
+
+class Sensor
+{
+    public_signal(readings, SignalPolicy::Instrumented<SignalPolicy::Mutex>, int)
+
+public:
+    void read(int v)
+    {
+        this->readings.emit(v);
+    }
+};
+
+class Plain
+{
+    public_signal(values, int)
+};
+
+std::uint64_t histogramTotal(const SignalReport::Slot & slot)
+{
+    return std::accumulate(slot.histogram.begin(), slot.histogram.end(), std::uint64_t{0});
+}
+
+int main()
+{
+    //Emits and calls are counted, every call lands in a bucket. A batch is one call per method.
+    Signal<SignalPolicy::Instrumented<SignalPolicy::LockFree>, int> s;
+    int sum = 0;
+    Connection a = s.connect([&sum](int v){ sum += v; });
+    Connection b = s.connect([&sum](int v){ sum -= 2 * v; });
+    s.emit(1);
+    s.emit(2);
+    s.emitBatch(std::vector<std::tuple<int>>{{3}, {4}});
+    assert(sum == -10);
+    SignalReport report = s.stats().report();
+    assert(report.emits == 4);
+    assert(report.slots.size() == 2);
+    assert(report.slots[0].id != report.slots[1].id);
+    for([[maybe_unused]] const SignalReport::Slot & slot: report.slots)
+    {
+        assert(slot.calls == 3);
+        assert(histogramTotal(slot) == slot.calls);
+    }
+
+    //Disconnected methods leave the report.
+    b.disconnect();
+    s.emit(5);
+    report = s.stats().report();
+    assert(report.emits == 5);
+    assert(report.slots.size() == 1 && report.slots[0].calls == 4);
+
+    //Signals declared with the macros register under their name while they live.
+    [[maybe_unused]] const std::size_t before = SignalRegistry::instance().size();
+    {
+        Sensor sensor;
+        Plain plain;
+        assert(SignalRegistry::instance().size() == before + 1);
+        Connection c = sensor.connect_readings([](int){});
+        sensor.read(1);
+        sensor.read(2);
+        std::optional<std::uint64_t> emits;
+        std::uint64_t calls = 0;
+        SignalRegistry::instance().forEach([&](std::string_view name, const SignalReport & r) {
+            if(name == "readings")
+            {
+                emits = r.emits;
+                calls = r.slots.at(0).calls;
+            }
+        });
+        assert(emits == 2u && calls == 2);
+    }
+    assert(SignalRegistry::instance().size() == before);
+
+    //Signals with results, named by hand.
+    Signal<SignalPolicy::Instrumented<SignalPolicy::Mutex>, int(int)> doubled("doubled");
+    assert(SignalRegistry::instance().size() == before + 1);
+    Connection d = doubled.connect([](int v){ return 2 * v; });
+    [[maybe_unused]] const int doubledSum = doubled.emit(SignalCombiner::Sum<int>{}, 21);
+    assert(doubledSum == 42);
+    report = doubled.stats().report();
+    assert(report.emits == 1 && report.slots.at(0).calls == 1);
+
+    //Without the policy the counters are compiled away.
+    static_assert(sizeof(Signal<SignalPolicy::Mutex, int>) < sizeof(Signal<SignalPolicy::Instrumented<SignalPolicy::Mutex>, int>));
+
+    return 0;
+}
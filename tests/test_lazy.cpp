@@ -0,0 +1,100 @@
+#include <signals.h>
+#include <cassert>
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+
+struct Sink
+{
+    void on(const std::string &) {}
+};
+
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+
+Task waitOne(Signal<std::string> & s, std::string & got)
+{
+    std::tuple<std::string> event = co_await s.next();
+    got = std::get<0>(event);
+}
+
+int main()
+{
+    Signal<std::string> s;
+    int built = 0;
+    std::string last;
+    auto format = [&built](){ ++built; return std::string("expensive"); };
+
+    //Nobody listens: the arguments are never built.
+    assert(!s.hasActiveListeners());
+    s.emitLazy(format);
+    assert(built == 0);
+
+    Connection c = s.connect([&last](const std::string & v){ last = v; });
+    assert(s.hasActiveListeners());
+    s.emitLazy(format);
+    assert(built == 1 && last == "expensive");
+
+    //Blocked methods don't count.
+    c.block();
+    assert(!s.hasActiveListeners());
+    s.emitLazy(format);
+    assert(built == 1);
+    c.unblock();
+    assert(s.hasActiveListeners());
+    c.disconnect();
+    assert(!s.hasActiveListeners());
+
+    //A waiting coroutine listens too.
+    std::string got;
+    waitOne(s, got);
+    assert(s.hasActiveListeners());
+    s.emitLazy(format);
+    assert(built == 2 && got == "expensive");
+    assert(!s.hasActiveListeners());
+
+    //Several arguments come as a tuple.
+    Signal<int, std::string> pair;
+    int sum = 0;
+    Connection p = pair.connect([&sum](int v, const std::string & text){ sum += v + static_cast<int>(text.size()); });
+    pair.emitLazy([](){ return std::tuple(1, std::string("abc")); });
+    assert(sum == 4);
+
+    //Expired tracked objects count until an emit drops them.
+    Signal<std::string> tracked;
+    std::shared_ptr<Sink> object = std::make_shared<Sink>();
+    Connection t = tracked.connect(object, &Sink::on);
+    object.reset();
+    assert(tracked.hasActiveListeners());
+    tracked.emit("x");
+    assert(!tracked.hasActiveListeners());
+
+    //With deferred mutations, the count follows once they apply.
+    LocalSignal<int> local;
+    std::optional<Connection<int>> added;
+    Connection first = local.connect([&local, &added](int){
+        if(!added)
+        {
+            added.emplace(local.connect([](int){}));
+        }
+    });
+    local.emit(0);
+    assert(local.hasActiveListeners());
+    first.disconnect();
+    assert(local.hasActiveListeners());
+    added.reset();
+    assert(!local.hasActiveListeners());
+
+    return 0;
+}
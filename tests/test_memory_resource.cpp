@@ -0,0 +1,112 @@
+#include <signals.h>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Counts what goes through it, forwards to new/delete.
+ */
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations = 0;
+    std::size_t live = 0;
+
+private:
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++this->allocations;
+        ++this->live;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override
+    {
+        --this->live;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+template<typename S>
+void churn(CountingResource & counting)
+{
+    //Anything using the default resource around the signal would throw.
+    std::pmr::memory_resource * previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        S s(&counting);
+        long sum = 0;
+        std::array<long, 16> big{};
+        big[3] = 2;
+        std::vector<Connection<int>> connections;
+        connections.reserve(64);
+        for(int i = 0; i < 64; ++i)
+        {
+            //Too big to be stored inline, allocated from the resource as well.
+            connections.push_back(s.connect([&sum, big](int v){ sum += v * big[3]; }));
+        }
+        s.emit(1);
+        assert(sum == 128);
+        for(int i = 0; i < 64; i += 2)
+        {
+            connections[i].disconnect();
+        }
+        s.emit(1);
+        assert(sum == 192);
+        connections.clear();
+        assert(counting.allocations > 64);
+    }
+    SignalDetail::EpochDomain::instance().collect();
+    std::pmr::set_default_resource(previous);
+    assert(counting.live == 0);
+}
+
+int main()
+{
+    CountingResource mutex;
+    churn<Signal<int>>(mutex);
+    CountingResource lockFree;
+    churn<ConcurrentSignal<int>>(lockFree);
+
+    //The shared pool recycles blocks across signals.
+    Signal<int> pooled(&SlotPool::shared());
+    int calls = 0;
+    for(int i = 0; i < 100; ++i)
+    {
+        Connection c = pooled.connect([&calls](int){ ++calls; });
+        pooled.emit(0);
+    }
+    assert(calls == 100);
+
+    //Blocks freed by other threads, and caches of exited threads, are reused.
+    {
+        SlotPool pool;
+        ConcurrentSignal<int> shared(&pool);
+        std::atomic<int> hits{0};
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&shared, &hits](){
+                for(int i = 0; i < 200; ++i)
+                {
+                    Connection c = shared.connect([&hits](int v){ hits += v; });
+                    shared.emit(1);
+                }
+            });
+        }
+        for(std::thread & t: threads)
+        {
+            t.join();
+        }
+        assert(hits >= 800);
+    }
+    return EXIT_SUCCESS;
+}
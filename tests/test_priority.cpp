@@ -0,0 +1,70 @@
+#include <signals.h>
+#include <cassert>
+#include <vector>
+
+std::vector<int> order;
+
+void low(int) { order.push_back(-1); }
+
+class Foo
+{
+public:
+    void f(int) { order.push_back(this->tag); }
+    int tag = 0;
+};
+
+int main()
+{
+    Signal<int> s;
+    Foo risk{50};
+    std::shared_ptr<Foo> audit = std::make_shared<Foo>(Foo{20});
+
+    //Same priority: connection order. Higher priority: called first.
+    Connection a = s.connect([](int){ order.push_back(1); });
+    Connection b = s.connect([](int){ order.push_back(2); });
+    Connection c = s.connect(100, [](int){ order.push_back(100); });
+    Connection d = s.connect(-5, &low);
+    Connection e = s.connect(50, &risk, &Foo::f);
+    Connection f = s.connect(100, [](int v, int){ order.push_back(v); }, 101);
+    Connection g = s.connect(20, audit, &Foo::f);
+    s.emit(0);
+    assert((order == std::vector<int>{100, 101, 50, 20, 1, 2, -1}));
+
+    //Blocked flags and ids follow the methods shifted by an insertion.
+    order.clear();
+    b.block();
+    Connection h = s.connect(10, [](int){ order.push_back(10); });
+    s.emit(0);
+    assert((order == std::vector<int>{100, 101, 50, 20, 10, 1, -1}));
+
+    order.clear();
+    b.unblock();
+    c.disconnect();
+    s.emit(0);
+    assert((order == std::vector<int>{101, 50, 20, 10, 1, 2, -1}));
+
+    //Inserting in front shifts blocked flags across words.
+    Signal<int> many;
+    std::vector<Connection<int>> connections;
+    for(int i = 0; i < 130; ++i)
+    {
+        connections.push_back(many.connect([i](int){ order.push_back(i); }));
+        if(i % 3 == 0)
+        {
+            connections.back().block();
+        }
+    }
+    connections.push_back(many.connect(1, [](int){ order.push_back(-2); }));
+    order.clear();
+    many.emit(0);
+    std::vector<int> expected{-2};
+    for(int i = 0; i < 130; ++i)
+    {
+        if(i % 3 != 0)
+        {
+            expected.push_back(i);
+        }
+    }
+    assert(order == expected);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+#include <signals.h>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <thread>
+
+class Foo
+{
+    public_signal(sPub, std::string)
+
+public:
+    std::string last;
+    std::thread::id caller;
+    std::atomic<int> calls{0};
+
+    void emitSig(const std::string & s)
+    {
+        sPub.emit(s);
+    }
+
+    void member(const std::string & s)
+    {
+        this->last = s;
+        this->caller = std::this_thread::get_id();
+        ++this->calls;
+    }
+};
+
+int main()
+{
+    Executor executor;
+    Signal<std::string> s;
+    Foo foo;
+
+    //Nothing runs until the executor drains its queue.
+    Connection c1 = s.connect(executor, &foo, &Foo::member);
+    Connection c2 = s.connect(executor, [&foo](const std::string & s){ foo.last += s; });
+    s.emit("a");
+    assert(foo.calls == 0);
+    [[maybe_unused]] const std::size_t polled = executor.poll();
+    assert(polled == 2);
+    assert(foo.last == "aa" && foo.calls == 1);
+
+    //Calls made after a disconnection are dropped.
+    s.emit("b");
+    c2.disconnect();
+    executor.poll();
+    assert(foo.last == "b" && foo.calls == 2);
+
+    //Other overloads and the macros.
+    std::shared_ptr<Foo> shared = std::make_shared<Foo>();
+    Connection c3 = s.connect(executor, shared, &Foo::member);
+    Connection c4 = foo.connect_sPub(executor, &foo, &Foo::member);
+    s.emit("c");
+    foo.emitSig("d");
+    executor.poll();
+    assert(shared->last == "c");
+    assert(foo.last == "d");
+
+    //Drained by another thread.
+    std::thread worker([&executor](){ executor.run(); });
+    c1.disconnect();
+    c4.disconnect();
+    s.emit("e");
+    while(shared->calls != 2)
+    {
+        std::this_thread::yield();
+    }
+    [[maybe_unused]] const std::thread::id workerId = worker.get_id();
+    executor.stop();
+    worker.join();
+    assert(shared->last == "e");
+    assert(shared->caller == workerId);
+    return EXIT_SUCCESS;
+}
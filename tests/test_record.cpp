@@ -0,0 +1,196 @@
+#include <signals.h>
+#include <recorder.h>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+struct Fill
+{
+    int id;
+    double price;
+    std::string venue;
+};
+
+int main()
+{
+    const std::string path = "/tmp/signals_record_" + std::to_string(getpid()) + ".log";
+    using Recorded = SignalPolicy::Recorded<SignalPolicy::Mutex>;
+
+    //Nothing attached: a recorded signal behaves like any other.
+    Signal<Recorded, Fill> fills;
+    Signal<SignalPolicy::Recorded<SignalPolicy::LockFree>, int, long> counts;
+    Signal<SignalPolicy::Recorded<SignalPolicy::Instrumented<SignalPolicy::Mutex>>, int> measured;
+    int delivered = 0;
+    Connection c1 = fills.connect([&delivered](const Fill &) { ++delivered; });
+    Connection c2 = measured.connect([](int) {});
+    fills.emit(Fill{0, 0.0, "off"});
+    assert(delivered == 1);
+
+    {
+        SignalRecorder recorder(path, 1 << 20, 256);
+        recorder.record(fills, "fills");
+        recorder.record(counts, "counts");
+        recorder.record(measured, "measured");
+        for(int i = 1; i <= 100; ++i)
+        {
+            fills.emit(Fill{i, i * 0.5, "XPAR"});
+        }
+        //Every kind of emit is recorded, from every thread.
+        std::vector<std::tuple<int, long>> batch = {{1, 10}, {2, 20}, {3, 30}};
+        counts.emitBatch(batch);
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&counts, t]() {
+                for(long i = 0; i < 1000; ++i)
+                {
+                    counts.emit(100 + t, i);
+                }
+            });
+        }
+        for(std::thread & thread: threads)
+        {
+            thread.join();
+        }
+        measured.emit(7);
+        assert(measured.stats().report().emits == 1);
+        recorder.stop(measured);
+        measured.emit(8);
+        assert(delivered == 101 && recorder.dropped() == 0);
+        recorder.flush();
+        assert(recorder.size() > sizeof(SignalDetail::RecordHeader));
+    }
+    //Detached on destruction.
+    fills.emit(Fill{-1, 0.0, "off"});
+
+    {
+        SignalReplayer replayer(path);
+        assert(replayer.size() == 100 + 3 + 4000 + 1);
+        assert(replayer.started() <= std::chrono::system_clock::now());
+        LocalSignal<Fill> replayedFills;
+        std::vector<Fill> got;
+        Connection r1 = replayedFills.connect([&got](const Fill & f) { got.push_back(f); });
+        Signal<int, long> replayedCounts;
+        std::vector<long> next(4, 0);
+        long total = 0;
+        bool ordered = true;
+        Connection r2 = replayedCounts.connect([&](int who, long i) {
+            if(who >= 100)
+            {
+                ordered = ordered && next[who - 100] == i;
+                next[who - 100] = i + 1;
+            }
+            total += i;
+        });
+        replayer.bind("fills", replayedFills);
+        replayer.bind("counts", replayedCounts);
+        //measured is not bound: skipped.
+        [[maybe_unused]] const std::size_t replayed = replayer.replay();
+        assert(replayed == 100 + 3 + 4000);
+        assert(got.size() == 100 && got[41].id == 42 && got[41].price == 21.0 && got[41].venue == "XPAR");
+        assert(ordered && total == 60 + 4 * 999 * 1000 / 2);
+
+        //Other arguments don't decode.
+        LocalSignal<std::string> wrong;
+        replayer.bind("measured", wrong);
+        replayer.replay();
+        assert(replayer.skipped() == 1);
+    }
+
+    //Real time keeps the gaps.
+    {
+        SignalRecorder recorder(path);
+        recorder.record(counts, "counts");
+        counts.emit(1, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        counts.emit(2, 2);
+        recorder.stop(counts);
+    }
+    {
+        SignalReplayer replayer(path);
+        LocalSignal<int, long> replayed;
+        replayer.bind("counts", replayed);
+        [[maybe_unused]] const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        [[maybe_unused]] const std::size_t replayedCounts = replayer.replay(ReplayPace::RealTime);
+        assert(replayedCounts == 2);
+        assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(30));
+    }
+
+    //A full log drops whole buffers and counts them.
+    {
+        SignalRecorder recorder(path, 4096, 512);
+        recorder.record(counts, "counts");
+        for(int i = 0; i < 10000; ++i)
+        {
+            counts.emit(i, i);
+        }
+        recorder.flush();
+        assert(recorder.dropped() > 0 && recorder.size() <= 4096);
+        recorder.stop(counts);
+    }
+    {
+        SignalReplayer replayer(path);
+        assert(replayer.size() > 0 && replayer.size() < 10000);
+    }
+
+    //A signal recorded by another recorder moves to it, whatever becomes of the first one.
+    const std::string other = path + ".other";
+    {
+        SignalRecorder second(other);
+        {
+            SignalRecorder first(path);
+            first.record(counts, "counts");
+            second.record(counts, "counts");
+            first.stop(counts);
+        }
+        for(int i = 0; i < 10; ++i)
+        {
+            counts.emit(i, i);
+        }
+        second.stop(counts);
+        counts.emit(10, 10);
+    }
+    {
+        SignalReplayer replayer(other);
+        assert(replayer.size() == 10);
+    }
+    std::remove(other.c_str());
+
+    //A recorded signal destroyed before the recorder leaves it, with what it recorded.
+    {
+        SignalRecorder recorder(other);
+        std::unique_ptr<Signal<Recorded, int>> ticks = std::make_unique<Signal<Recorded, int>>();
+        recorder.record(*ticks, "ticks");
+        ticks->emit(1);
+        ticks.reset();
+    }
+    {
+        SignalReplayer replayer(other);
+        assert(replayer.size() == 1);
+    }
+    std::remove(other.c_str());
+
+    //Not a log.
+    [[maybe_unused]] bool refused = false;
+    try
+    {
+        std::FILE * f = std::fopen(path.c_str(), "w");
+        std::fputs("this is not a signal log, only some text long enough for a header", f);
+        std::fclose(f);
+        SignalReplayer replayer(path);
+    }
+    catch(const std::runtime_error &)
+    {
+        refused = true;
+    }
+    assert(refused);
+    std::remove(path.c_str());
+
+    return 0;
+}
@@ -0,0 +1,299 @@
+#include <signals.h>
+#include <remote_signal.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+enum class Side : std::uint8_t
+{
+    Buy,
+    Sell
+};
+
+struct Order
+{
+    long id;
+    std::string symbol;
+    double price;
+    Side side;
+    std::vector<int> fills;
+    std::optional<std::pair<int, bool>> parent;
+};
+
+/**
+ * @brief Gives recorded bytes to receive and accepts nothing, as a peer that stopped reading.
+ */
+class Replay : public SignalTransport
+{
+public:
+    explicit Replay(std::vector<std::byte> bytes) : bytes(std::move(bytes)) {}
+
+    std::size_t send(std::span<const std::byte>) override { return 0; }
+
+    std::size_t receive(std::span<std::byte> out) override
+    {
+        const std::size_t n = std::min(out.size(), this->bytes.size());
+        std::copy_n(this->bytes.begin(), n, out.begin());
+        this->bytes.erase(this->bytes.begin(), this->bytes.begin() + static_cast<std::ptrdiff_t>(n));
+        return n;
+    }
+
+private:
+    std::vector<std::byte> bytes;
+};
+
+/**
+ * @brief Accepts nothing until opened, as a peer slow to read, or closed for good once shut.
+ * Gives recorded bytes to receive.
+ */
+class Gate : public SignalTransport
+{
+public:
+    std::atomic<bool> open{false};
+    std::atomic<bool> shut{false};
+    std::size_t taken = 0;
+
+    explicit Gate(std::vector<std::byte> bytes = {}) : bytes(std::move(bytes)) {}
+
+    std::size_t send(std::span<const std::byte> out) override
+    {
+        if(!this->open.load(std::memory_order_acquire) || this->shut.load(std::memory_order_acquire))
+        {
+            return 0;
+        }
+        this->taken += out.size();
+        return out.size();
+    }
+
+    std::size_t receive(std::span<std::byte> in) override
+    {
+        const std::size_t n = std::min(in.size(), this->bytes.size());
+        std::copy_n(this->bytes.begin(), n, in.begin());
+        this->bytes.erase(this->bytes.begin(), this->bytes.begin() + static_cast<std::ptrdiff_t>(n));
+        return n;
+    }
+
+    bool closed() const override
+    {
+        return this->shut.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<std::byte> bytes;
+};
+
+static void pump(RemoteLink & a, RemoteLink & b)
+{
+    for(int i = 0; i < 4; ++i)
+    {
+        a.poll();
+        b.poll();
+    }
+}
+
+int main()
+{
+    //Compact encoding: small integers take a byte whatever their type, and aggregates round trip.
+    std::vector<std::byte> bytes;
+    SignalWire::Writer w(bytes);
+    SignalWire::Codec<long>::write(w, -1);
+    SignalWire::Codec<unsigned>::write(w, 127);
+    assert(bytes.size() == 2);
+    SignalWire::Codec<unsigned>::write(w, 300);
+    assert(bytes.size() == 4);
+    const Order sent{42, "EURUSD", 1.0825, Side::Sell, {1, -2, 300}, std::pair<int, bool>{7, true}};
+    SignalWire::Codec<Order>::write(w, sent);
+    SignalWire::Reader r(bytes);
+    long small = 0;
+    unsigned u1 = 0;
+    unsigned u2 = 0;
+    Order received{};
+    [[maybe_unused]] const bool readSmall = SignalWire::Codec<long>::read(r, small);
+    [[maybe_unused]] const bool readU1 = SignalWire::Codec<unsigned>::read(r, u1);
+    [[maybe_unused]] const bool readU2 = SignalWire::Codec<unsigned>::read(r, u2);
+    [[maybe_unused]] const bool readOrder = SignalWire::Codec<Order>::read(r, received);
+    assert(readSmall && small == -1);
+    assert(readU1 && u1 == 127);
+    assert(readU2 && u2 == 300);
+    assert(readOrder && r.remaining() == 0);
+    assert(received.id == 42 && received.symbol == "EURUSD" && received.price == 1.0825 && received.side == Side::Sell);
+    assert((received.fills == std::vector<int>{1, -2, 300}) && received.parent->first == 7 && received.parent->second);
+    //Truncated input is refused.
+    SignalWire::Reader truncated(std::span<const std::byte>(bytes).first(bytes.size() - 1));
+    std::uint64_t skipped = 0;
+    for(int k = 0; k < 3; ++k)
+    {
+        truncated.varint(skipped);
+    }
+    [[maybe_unused]] const bool readTruncated = SignalWire::Codec<Order>::read(truncated, received);
+    assert(!readTruncated);
+
+    //Published signals outlive the links.
+    Signal<Order> orders;
+    Signal<int, std::string> log;
+    Signal<double> late;
+    int fds[2];
+    [[maybe_unused]] const int paired = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(paired == 0);
+    SocketTransport ta(fds[0]);
+    SocketTransport tb(fds[1]);
+    RemoteLink a(ta, RemoteOptions{.maxFrame = 4096, .flushWindow = std::chrono::hours(1)});
+    RemoteLink b(tb);
+
+    //Nothing is sent before the peer subscribes.
+    a.publish("orders", orders);
+    orders.emit(sent);
+    a.flush();
+    assert(a.frames() == 0 && !orders.hasActiveListeners());
+
+    //Subscribing connects remotely, emits are batched in frames.
+    std::vector<Order> got;
+    Connection c1 = b.subscribe<Order>("orders", [&got](const Order & o){ got.push_back(o); });
+    pump(a, b);
+    assert(orders.hasActiveListeners());
+    for(long i = 0; i < 100; ++i)
+    {
+        Order o = sent;
+        o.id = i;
+        orders.emit(o);
+    }
+    [[maybe_unused]] const std::size_t early = b.poll();
+    assert(a.frames() == 0 && early == 0);
+    a.flush();
+    assert(a.frames() == 1);
+    [[maybe_unused]] const std::size_t delivered = b.poll();
+    assert(delivered == 100);
+    assert(got.size() == 100 && got[99].id == 99 && got[99].symbol == "EURUSD");
+
+    //Full frames go without waiting for the window.
+    got.clear();
+    for(long i = 0; i < 1000; ++i)
+    {
+        orders.emit(sent);
+    }
+    assert(a.frames() > 1);
+    b.poll();
+    assert(!got.empty());
+    a.flush();
+    b.poll();
+    assert(got.size() == 1000);
+
+    //Both sides publish, several methods share a subscription, blocking stays local.
+    b.publish("log", log);
+    int count = 0;
+    std::string last;
+    Connection c2 = a.subscribe<int, std::string>("log", [&count](int n, const std::string &){ count += n; });
+    Connection c3 = a.subscribe<int, std::string>("log", [&last](int, const std::string & s){ last = s; });
+    pump(a, b);
+    log.emit(2, "started");
+    b.flush();
+    a.poll();
+    assert(count == 2 && last == "started");
+    c3.block();
+    log.emit(3, "running");
+    b.flush();
+    a.poll();
+    assert(count == 5 && last == "started");
+
+    //Dropping the last connection unsubscribes remotely.
+    c2.disconnect();
+    pump(a, b);
+    assert(log.hasActiveListeners());
+    c3.disconnect();
+    pump(a, b);
+    assert(!log.hasActiveListeners());
+    c1 = Connection<Order>();
+    pump(a, b);
+    assert(!orders.hasActiveListeners());
+
+    //Subscribed before published.
+    double price = 0;
+    Connection c4 = b.subscribe<double>("late", [&price](double p){ price = p; });
+    pump(a, b);
+    a.publish("late", late);
+    late.emit(3.5);
+    a.flush();
+    b.poll();
+    assert(price == 3.5);
+
+    //A peer that stopped reading: events are dropped once too many bytes wait.
+    Signal<long> ticks;
+    std::vector<std::byte> subscribe;
+    {
+        //Hand-made subscription frame: kind, channel, size then name.
+        std::vector<std::byte> message;
+        SignalWire::Writer m(message);
+        m.varint(1);
+        m.varint(0);
+        m.varint(5);
+        m.raw("ticks", 5);
+        SignalWire::Writer frame(subscribe);
+        frame.varint(message.size());
+        frame.raw(message.data(), message.size());
+    }
+    Replay once(subscribe);
+    RemoteLink dropper(once, RemoteOptions{.maxFrame = 64, .maxPending = 256, .overflow = RemoteOverflow::Drop});
+    dropper.publish("ticks", ticks);
+    dropper.poll();
+    assert(ticks.hasActiveListeners());
+    for(long i = 0; i < 1000; ++i)
+    {
+        ticks.emit(i);
+    }
+    assert(dropper.dropped() > 0 && dropper.dropped() < 1000);
+
+    //A name is published once: the peer may already be subscribed to the first signal.
+    Signal<double> other;
+    [[maybe_unused]] bool refused = false;
+    try
+    {
+        a.publish("late", other);
+    }
+    catch(const std::logic_error &)
+    {
+        refused = true;
+    }
+    assert(refused);
+    late.emit(4.5);
+    a.flush();
+    b.poll();
+    assert(price == 4.5);
+
+    //Subscribing and disconnecting don't wait for a peer slow to read: poll() sends their messages later.
+    Gate gate;
+    RemoteLink slow(gate);
+    std::optional<Connection<int>> waiting;
+    waiting.emplace(slow.subscribe<int>("slow", [](int){}));
+    waiting.reset();
+    assert(gate.taken == 0);
+    gate.open.store(true, std::memory_order_release);
+    slow.poll();
+    assert(gate.taken > 0);
+
+    //Nothing waits for a closed transport: blocking emits and flushes give up, the queued bytes are dropped.
+    Signal<long> more;
+    Gate closing(subscribe);
+    RemoteLink blocked(closing, RemoteOptions{.maxFrame = 64, .maxPending = 256});
+    blocked.publish("ticks", more);
+    blocked.poll();
+    assert(more.hasActiveListeners());
+    closing.shut.store(true, std::memory_order_release);
+    for(long i = 0; i < 1000; ++i)
+    {
+        more.emit(i);
+    }
+    blocked.flush();
+    assert(closing.taken == 0);
+
+    c4.disconnect();
+    close(fds[0]);
+    close(fds[1]);
+    return 0;
+}
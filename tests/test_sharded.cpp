@@ -0,0 +1,94 @@
+#include <signals.h>
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class Counter
+{
+public:
+    void add(int v) { this->total += v; }
+    std::atomic<int> total{0};
+};
+
+int main()
+{
+    [[maybe_unused]] const SignalDetail::CpuTopology & topology = SignalDetail::CpuTopology::instance();
+    assert(topology.cpuCount() >= 1 && topology.nodeCount() >= 1);
+    assert(topology.nodeOf(SignalDetail::CpuTopology::currentCpu()) < topology.nodeCount());
+
+    ShardedSignal<int> s(4);
+    assert(s.size() == 4 && s.localShard() < 4);
+
+    //Methods connected to every shard are reached from any shard, the others only from theirs.
+    int every = 0;
+    int second = 0;
+    Counter counter;
+    Connection a = s.connect([&every](int v){ every += v; });
+    Connection b = s.connectShard(2, [&second](int v){ second += v; });
+    Connection c = s.connectShard(3, &counter, &Counter::add);
+    s.emitOn(0, ShardDelivery::Local, 1);
+    assert(every == 1 && second == 0 && counter.total == 0);
+    s.emitOn(2, ShardDelivery::Local, 1);
+    assert(every == 2 && second == 1 && counter.total == 0);
+    s.emitOn(0, ShardDelivery::All, 1);
+    assert(every == 3 && second == 2 && counter.total == 1);
+
+    //Blocking and disconnecting apply to every copy.
+    a.block();
+    s.emitOn(1, ShardDelivery::All, 1);
+    assert(every == 3 && second == 3 && counter.total == 2);
+    a.unblock();
+    a.disconnect();
+    b.disconnect();
+    s.emitOn(2, ShardDelivery::All, 1);
+    assert(every == 3 && second == 3 && counter.total == 3);
+
+    //Groups and priorities go through.
+    std::vector<int> order;
+    {
+        ConnectionGroup group;
+        Connection low = s.connect([&order](int){ order.push_back(1); });
+        Connection high = s.connect(5, [&order](int){ order.push_back(2); });
+        group.add(low);
+        group.add(high);
+        s.emit(0);
+        assert((order == std::vector<int>{2, 1}));
+    }
+    s.emit(0);
+    assert(order.size() == 2);
+
+    //Threads emit on their own shard.
+    ShardedSignal<int> byNode(ShardBy::Node);
+    assert(byNode.size() == topology.nodeCount());
+    std::atomic<int> calls{0};
+    Connection d = byNode.connect([&calls](int v){ calls += v; });
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&byNode]() {
+            for(int i = 0; i < 1000; ++i)
+            {
+                byNode.emit(1);
+            }
+        });
+    }
+    for(std::thread & thread: threads)
+    {
+        thread.join();
+    }
+    assert(calls == 4000);
+
+    //Other policies, and a local method of the calling thread.
+    ShardedSignal<SignalPolicy::Mutex, int> byCore(ShardBy::Core);
+    assert(byCore.size() == topology.cpuCount());
+    int local = 0;
+    Connection e = byCore.connectLocal([&local](int v){ local += v; });
+    byCore.emit(ShardDelivery::All, 1);
+    assert(local == 1);
+    byCore.disconnectAll();
+    byCore.emit(ShardDelivery::All, 1);
+    assert(local == 1);
+
+    return 0;
+}
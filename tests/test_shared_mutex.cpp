@@ -0,0 +1,43 @@
+#include <signals.h>
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    Signal<SignalPolicy::SharedMutex, int> s;
+    std::atomic<long> total = 0;
+
+    Connection c = s.connect([&total](int i){ total += i; });
+
+    //Emitters share the lock while the slot list is replaced over and over.
+    std::atomic<bool> stop = false;
+    std::thread writer([&s, &stop](){
+        while(!stop)
+        {
+            Connection churn = s.connect([](int){});
+            churn.block();
+        }
+    });
+
+    std::vector<std::thread> emitters;
+    for(int t = 0; t < 4; ++t)
+    {
+        emitters.emplace_back([&s](){
+            for(int i = 0; i < 10000; ++i)
+            {
+                s.emit(1);
+            }
+        });
+    }
+    for(std::thread & t: emitters)
+    {
+        t.join();
+    }
+    stop = true;
+    writer.join();
+
+    assert(total == 40000);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+#include <signals.h>
+#include <shm_signal.h>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct Tick
+{
+    int id;
+    double price;
+};
+
+int main()
+{
+    const std::string name = "/signals_test_" + std::to_string(getpid());
+    ShmSignal<Tick, long> producer(name, 64);
+    assert(producer.receivers() == 0);
+    //Nobody listens: emits go nowhere and never wait.
+    for(int i = 0; i < 1000; ++i)
+    {
+        producer.emit(Tick{i, 0.0}, i);
+    }
+
+    //Events are emitted on the local signal, from the ring memory.
+    {
+        LocalSignal<Tick, long> local;
+        Tick last{};
+        long total = 0;
+        Connection c = local.connect([&last, &total](const Tick & t, long n){ last = t; total += n; });
+        ShmReceiver<Tick, long> receiver(name, local);
+        assert(producer.receivers() == 1);
+        [[maybe_unused]] const std::size_t none = receiver.poll();
+        [[maybe_unused]] const bool woken = receiver.wait(std::chrono::nanoseconds(0));
+        assert(none == 0 && !woken);
+        producer.emit(Tick{1, 2.5}, 10);
+        producer.emit(Tick{2, 3.5}, 20);
+        [[maybe_unused]] const bool ready = receiver.wait();
+        assert(ready);
+        [[maybe_unused]] const std::size_t two = receiver.poll();
+        assert(two == 2);
+        assert(last.id == 2 && last.price == 3.5 && total == 30);
+
+        //A full ring refuses more until the receiver reads.
+        bool accepted = true;
+        for(int i = 0; i < 64; ++i)
+        {
+            accepted = producer.tryEmit(Tick{i, 0.0}, 1) && accepted;
+        }
+        assert(accepted);
+        [[maybe_unused]] const bool overflowed = !producer.tryEmit(Tick{64, 0.0}, 1);
+        assert(overflowed);
+        [[maybe_unused]] const std::size_t full = receiver.poll();
+        assert(full == 64 && total == 94);
+        [[maybe_unused]] const bool again = producer.tryEmit(Tick{64, 0.0}, 1);
+        assert(again);
+        [[maybe_unused]] const std::size_t one = receiver.poll();
+        assert(one == 1);
+
+        //Other arguments are refused.
+        [[maybe_unused]] bool refused = false;
+        try
+        {
+            LocalSignal<int> other;
+            ShmReceiver<int> wrong(name, other);
+        }
+        catch(const std::runtime_error &)
+        {
+            refused = true;
+        }
+        assert(refused);
+    }
+    assert(producer.receivers() == 0);
+
+    //Another process receives everything, in order, through a ring much smaller than the stream.
+    const pid_t child = fork();
+    if(child == 0)
+    {
+        bool ordered = true;
+        {
+            Signal<Tick, long> local;
+            long expected = 0;
+            Connection c = local.connect([&](const Tick & t, long n){
+                ordered = ordered && t.id == expected && n == expected;
+                ++expected;
+            });
+            ShmReceiver<Tick, long> receiver(name, local);
+            while(expected < 100000)
+            {
+                receiver.wait(std::chrono::milliseconds(10));
+                receiver.poll();
+            }
+        }
+        _exit(ordered ? 0 : 1);
+    }
+    while(producer.receivers() == 0)
+    {
+        usleep(100);
+    }
+    for(long i = 0; i < 100000; ++i)
+    {
+        producer.emit(Tick{static_cast<int>(i), 1.0}, i);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    //A receiver whose process died doesn't block the producer.
+    const pid_t dead = fork();
+    if(dead == 0)
+    {
+        LocalSignal<Tick, long> local;
+        ShmReceiver<Tick, long> * receiver = new ShmReceiver<Tick, long>(name, local);
+        (void)receiver;
+        _exit(0);
+    }
+    waitpid(dead, &status, 0);
+    assert(producer.receivers() == 1);
+    for(int i = 0; i < 1000; ++i)
+    {
+        producer.emit(Tick{i, 0.0}, i);
+    }
+    assert(producer.receivers() == 0);
+
+    //A receiver thread stopped from another.
+    LocalSignal<Tick, long> local;
+    ShmReceiver<Tick, long> receiver(name, local);
+    std::thread t([&receiver](){ receiver.run(); });
+    receiver.stop();
+    t.join();
+
+    return 0;
+}
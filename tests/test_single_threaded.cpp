@@ -0,0 +1,84 @@
+#include <signals.h>
+#include <cassert>
+#include <optional>
+#include <vector>
+
+int main()
+{
+    LocalSignal<int&> s;
+    int calls = 0;
+
+    //Connected during an emit: the id is valid at once, the method runs from the next emit.
+    std::optional<Connection<int&>> late;
+    Connection c = s.connect([&s, &late](int& calls){
+        ++calls;
+        if(!late)
+        {
+            late.emplace(s.connect([](int& calls){ calls += 10; }));
+            late->block();
+        }
+    });
+    s.emit(calls);
+    assert(calls == 1);
+    s.emit(calls);
+    assert(calls == 2);
+    late->unblock();
+    s.emit(calls);
+    assert(calls == 13);
+
+    //Disconnected during an emit: the methods the emit started with still run.
+    std::vector<int> order;
+    Signal<SignalPolicy::SingleThreaded, int> t;
+    std::optional<Connection<int>> second;
+    Connection first = t.connect([&second, &order](int){
+        order.push_back(1);
+        second->disconnect();
+    });
+    second.emplace(t.connect([&order](int){ order.push_back(2); }));
+    t.emit(0);
+    assert((order == std::vector<int>{1, 2}));
+    t.emit(0);
+    assert((order == std::vector<int>{1, 2, 1}));
+
+    //Changes made by a nested emit wait for the outermost one.
+    int nested = 0;
+    std::optional<Connection<int>> added;
+    Connection outer = t.connect([&t, &added, &nested](int depth){
+        if(depth == 0)
+        {
+            t.emit(1);
+            return;
+        }
+        if(!added)
+        {
+            added.emplace(t.connect([&nested](int){ ++nested; }));
+        }
+    });
+    t.emit(0);
+    assert(nested == 0);
+    t.emit(1);
+    assert(nested == 1);
+
+    //disconnectAll during an emit runs once it returns, before what is connected after it.
+    std::optional<Connection<int>> keep;
+    Connection clearing = t.connect([&t, &keep, &nested](int depth){
+        if(depth == 2)
+        {
+            t.disconnectAll();
+            keep.emplace(t.connect([&nested](int){ nested += 100; }));
+        }
+    });
+    t.emit(2);
+    t.emit(3);
+    assert(nested == 102);
+
+    //Other policies, same behavior.
+    Signal<SignalPolicy::SharedMutex, int&> shared;
+    int sharedCalls = 0;
+    Connection d = shared.connect([](int& calls){ ++calls; });
+    shared.emit(sharedCalls);
+    d.block();
+    shared.emit(sharedCalls);
+    assert(sharedCalls == 1);
+    return EXIT_SUCCESS;
+}
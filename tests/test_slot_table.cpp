@@ -0,0 +1,44 @@
+#include <signals.h>
+#include <cassert>
+#include <vector>
+
+int main()
+{
+    Signal<std::vector<int>&> s;
+    std::vector<Connection<std::vector<int>&>> connections;
+
+    //More than one word of blocked flags.
+    for(int i = 0; i < 130; ++i)
+    {
+        connections.push_back(s.connect([i](std::vector<int>& calls){ calls.push_back(i); }));
+    }
+    for(int i = 0; i < 130; i += 2)
+    {
+        connections[i].block();
+    }
+    connections[65].disconnect();
+    connections[127].disconnect();
+
+    std::vector<int> calls;
+    s.emit(calls);
+
+    std::vector<int> expected;
+    for(int i = 1; i < 130; i += 2)
+    {
+        if(i != 65 && i != 127)
+        {
+            expected.push_back(i);
+        }
+    }
+    assert(calls == expected);
+
+    //Ids are generation checked: a stale one won't disconnect the method reusing its slot.
+    s.disconnectAll();
+    Connection reused = s.connect([](std::vector<int>& calls){ calls.push_back(-1); });
+    connections.clear();
+
+    calls.clear();
+    s.emit(calls);
+    assert(calls == std::vector<int>{-1});
+    return EXIT_SUCCESS;
+}
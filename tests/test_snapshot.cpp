@@ -0,0 +1,56 @@
+#include <signals.h>
+#include <cassert>
+#include <memory>
+#include <optional>
+
+int main()
+{
+    Signal<int&> s;
+    int calls = 0;
+
+    //A method disconnecting itself during an emit must be safe.
+    std::optional<Connection<int&>> self;
+    self.emplace(s.connect([&self](int& calls){
+        ++calls;
+        self->disconnect();
+    }));
+
+    //A method connected during an emit won't be called before the next emit.
+    std::optional<Connection<int&>> late;
+    Connection c = s.connect([&s, &late](int& calls){
+        ++calls;
+        if(!late)
+        {
+            late.emplace(s.connect([](int& calls){ calls += 10; }));
+        }
+    });
+
+    s.emit(calls);
+    assert(calls == 2);
+
+    s.emit(calls);
+    assert(calls == 13);
+
+    c.block();
+    s.emit(calls);
+    assert(calls == 23);
+
+    c.unblock();
+    s.disconnectAll();
+    s.emit(calls);
+    assert(calls == 23);
+
+    //A method whose destruction disconnects from the signal, once the list it was in is replaced.
+    struct Owner
+    {
+        std::optional<Connection<int&>> connection;
+    };
+    std::shared_ptr<Owner> owner = std::make_shared<Owner>();
+    owner->connection.emplace(s.connect([](int&){}));
+    Connection holder = s.connect([owner](int&){});
+    owner.reset();
+    holder.disconnect();
+    s.emit(calls);
+    assert(calls == 23 && !s.hasActiveListeners());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+#include <signals.h>
+#include <cassert>
+#include <string>
+
+static int total = 0;
+static std::string order;
+
+void addOne(int v)
+{
+    total += v;
+    order += "a";
+}
+
+void addTwice(int v)
+{
+    total += 2 * v;
+    order += "b";
+}
+
+struct Counter
+{
+    int count = 0;
+
+    void bump(int v)
+    {
+        this->count += v;
+    }
+};
+
+constexpr int square(int v)
+{
+    return v * v;
+}
+
+class Foo
+{
+    static_signal(sChanged, void(int), &addOne, [](int v){ order += std::to_string(v); })
+
+public:
+    void change(int v)
+    {
+        sChanged.emit(v);
+    }
+};
+
+int main()
+{
+    //Methods run in order, with the same arguments.
+    using Sig = StaticSignal<void(int), &addOne, &addTwice, [](int v){ total += 10 * v; }>;
+    static_assert(Sig::size == 3);
+    static_assert(std::is_empty_v<Sig>);
+    Sig::emit(1);
+    assert(total == 13 && order == "ab");
+
+    //Class methods take the object as first parameter.
+    Counter counter;
+    StaticSignal<void(Counter &, int), &Counter::bump>::emit(counter, 4);
+    assert(counter.count == 4);
+
+    //Built from callables, captures included, usable at compile time.
+    int seen = 0;
+    auto s = make_static_signal([&seen](int v){ seen += v; }, &addOne);
+    s.emit(2);
+    assert(seen == 2 && total == 15);
+    constexpr auto pure = make_static_signal(&square, [](int v){ return v; });
+    static_assert(pure.size == 2);
+    pure.emit(3);
+
+    //Macro, and connected to a dynamic signal.
+    Foo foo;
+    order.clear();
+    foo.change(5);
+    assert(order == "a5");
+    Signal<int> dynamic;
+    Connection c = dynamic.connect(Sig{});
+    total = 0;
+    dynamic.emit(1);
+    assert(total == 13);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#include <signals.h>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Foo
+{
+public:
+    static inline int lastCalls = -1;
+    int calls = 0;
+
+    ~Foo()
+    {
+        lastCalls = this->calls;
+    }
+
+    void member(int v)
+    {
+        this->calls += v;
+    }
+
+    void scaled(int k, int v)
+    {
+        this->calls += k * v;
+    }
+};
+
+/**
+ * @brief Signal destroyed with its owner by one of its methods, after the emit found an expired object.
+ */
+struct Owner
+{
+    Signal<int> s;
+    Connection<int> a;
+    Connection<int> b;
+};
+
+template<typename Emit>
+static void destroyedByMethod(Emit && emit)
+{
+    std::unique_ptr<Owner> owner = std::make_unique<Owner>();
+    std::shared_ptr<Foo> gone = std::make_shared<Foo>();
+    owner->a = owner->s.connect(gone, &Foo::member);
+    owner->b = owner->s.connect([&owner](int) { owner.reset(); });
+    gone.reset();
+    emit(owner->s);
+    assert(!owner);
+}
+
+int main()
+{
+    //Expired objects are skipped and their methods removed after the emit.
+    SignalDetail::SlotTable<std::function<void()>> table;
+    std::shared_ptr<Foo> a = std::make_shared<Foo>();
+    std::shared_ptr<Foo> b = std::make_shared<Foo>();
+    table.insert([&a](){ ++a->calls; }, a);
+    table.insert([&b](){ ++b->calls; }, b);
+    table.insert([](){});
+    std::vector<SignalDetail::idType> expired;
+    b.reset();
+    int called = 0;
+    table.forEachLive([&called](const std::function<void()> &){ ++called; }, expired);
+    assert(called == 2 && expired.size() == 1);
+    assert(table.erase(expired) == 1 && table.size() == 2);
+    expired.clear();
+    table.setTracking(SignalTracking::PerEmit);
+    table.forEachLive([](const std::function<void()> & f){ f(); }, expired);
+    assert(expired.empty() && a->calls == 1);
+
+    //Per call: an object released by an earlier method of the same emit is not called.
+    Signal<int> s;
+    std::shared_ptr<Foo> first = std::make_shared<Foo>();
+    std::shared_ptr<Foo> second = std::make_shared<Foo>();
+    std::weak_ptr<Foo> watch = second;
+    Connection c1 = s.connect(first, &Foo::member);
+    Connection c2 = s.connect([&second](int){ second.reset(); });
+    Connection c3 = s.connect(second, &Foo::member);
+    s.emit(1);
+    assert(first->calls == 1 && watch.expired() && Foo::lastCalls == 0);
+
+    //Per emit: objects stay alive until the emit is done.
+    s.setTracking(SignalTracking::PerEmit);
+    second = std::make_shared<Foo>();
+    watch = second;
+    Connection c4 = s.connect(second, &Foo::member);
+    Connection c5 = s.connect(second, &Foo::scaled, 2);
+    s.emit(1);
+    assert(first->calls == 2 && watch.expired() && Foo::lastCalls == 3);
+    s.emit(1);
+    assert(first->calls == 3);
+
+    //The emit doesn't remove the expired method from a signal a method destroyed.
+    destroyedByMethod([](Signal<int> & signal) { signal.emit(1); });
+    destroyedByMethod([](Signal<int> & signal) { signal.emitMove(1); });
+
+    //Queued methods check their object when they run.
+    Executor executor;
+    std::shared_ptr<Foo> queued = std::make_shared<Foo>();
+    Connection c6 = s.connect(executor, queued, &Foo::member);
+    s.emit(1);
+    std::shared_ptr<Foo> keep = queued;
+    queued.reset();
+    executor.poll();
+    assert(keep->calls == 1);
+    s.emit(1);
+    keep.reset();
+    [[maybe_unused]] const std::size_t polled = executor.poll();
+    assert(polled == 1);
+    return EXIT_SUCCESS;
+}